@@ -60,6 +60,12 @@ macro(configure_project)
         add_definitions(-DFISCO_GM)
     endif()
 
+    # rocksdb storage backend
+    eth_default_option(ROCKSDB OFF)
+    if (ROCKSDB)
+        add_definitions(-DFISCO_ROCKSDB)
+    endif()
+
     #debug
     eth_default_option(DEBUG OFF)
     if (DEBUG)
@@ -101,6 +107,7 @@ macro(print_config NAME)
     message("-- TARGET_PLATFORM  Target platform                          ${CMAKE_SYSTEM_NAME}")
     message("-- STATIC_BUILD     Build static                             ${STATIC_BUILD}")
     message("-- ARCH_TYPE                                                 ${ARCH_TYPE}")
+    message("-- ROCKSDB          Build rocksdb storage                    ${ROCKSDB}")
 if (BUILD_GM)
     message("------------------------------------------------------------------------")
     message("-- GM                Build GM                                ${BUILD_GM}")
@@ -0,0 +1,53 @@
+#------------------------------------------------------------------------------
+# Find the rocksdb includes and library
+# 
+# if you need to add a custom library search path, do it via via CMAKE_PREFIX_PATH 
+# 
+# This module defines
+#  ROCKSDB_INCLUDE_DIRS, where to find header, etc.
+#  ROCKSDB_LIBRARIES, the libraries needed to use rocksdb.
+#  ROCKSDB_FOUND, If false, do not try to use rocksdb.
+# ------------------------------------------------------------------------------
+# This file is part of FISCO-BCOS.
+#
+# FISCO-BCOS is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# FISCO-BCOS is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+#
+# (c) 2016-2018 fisco-dev contributors.
+#------------------------------------------------------------------------------
+find_path(
+    ROCKSDB_INCLUDE_DIR 
+    NAMES rocksdb/db.h
+    DOC "rocksdb include dir"
+)
+
+find_library(
+    ROCKSDB_LIBRARY
+    NAMES rocksdb
+    DOC "rocksdb library"
+)
+
+set(ROCKSDB_INCLUDE_DIRS ${ROCKSDB_INCLUDE_DIR})
+set(ROCKSDB_LIBRARIES ${ROCKSDB_LIBRARY})
+if (STATIC_BUILD)
+	find_library(SNAPPY_LIBRARY snappy)
+	find_library(LZ4_LIBRARY lz4)
+	find_library(ZSTD_LIBRARY zstd)
+	set(ROCKSDB_LIBRARIES ${ROCKSDB_LIBRARY} ${SNAPPY_LIBRARY} ${LZ4_LIBRARY} ${ZSTD_LIBRARY})
+endif()
+# handle the QUIETLY and REQUIRED arguments and set ROCKSDB_FOUND to TRUE
+# if all listed variables are TRUE, hide their existence from configuration view
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(rocksdb DEFAULT_MSG
+    ROCKSDB_LIBRARY ROCKSDB_INCLUDE_DIR)
+mark_as_advanced (ROCKSDB_INCLUDE_DIR ROCKSDB_LIBRARY)
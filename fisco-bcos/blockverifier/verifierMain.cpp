@@ -28,6 +28,8 @@
 #include <libdevcore/BasicLevelDB.h>
 #include <libdevcore/easylog.h>
 #include <libdevcrypto/Common.h>
+#include <libdevcrypto/Hash.h>
+#include <libethcore/ABI.h>
 #include <libethcore/Block.h>
 #include <libethcore/TransactionReceipt.h>
 #include <libmptstate/MPTStateFactory.h>
@@ -35,6 +37,8 @@
 #include <libstorage/MemoryTableFactory.h>
 #include <libstorage/Storage.h>
 #include <libstoragestate/StorageStateFactory.h>
+#include <chrono>
+#include <iostream>
 
 using namespace dev;
 INITIALIZE_EASYLOGGINGPP
@@ -333,6 +337,153 @@ int main(int argc, char* argv[])
             LOG(INFO) << "receipt2 " << receipt;
         }
     }
+    else if (argc > 1 && std::string("crud") == argv[1])
+    {
+        // CRUD workload through the table precompiled contracts:
+        // test_verifier crud [txCount] [rowsPerTx]
+        int txCount = argc > 2 ? std::stoi(argv[2]) : 10000;
+        int rowsPerTx = argc > 3 ? std::stoi(argv[3]) : 5;
+        auto parentBlock = blockChain->getBlockByNumber(blockChain->number());
+        dev::blockverifier::BlockInfo blockInfo = {parentBlock->header().hash(),
+            parentBlock->header().number(), parentBlock->header().stateRoot()};
+        auto context = std::make_shared<dev::blockverifier::ExecutiveContext>();
+        executiveContextFactory->initExecutiveContext(
+            blockInfo, parentBlock->header().stateRoot(), context);
+
+        dev::eth::ContractABI abi;
+        dev::Address tableFactory(0x1001);
+        dev::Address origin;
+        dev::bytes in = abi.abiIn(
+            "createTable(string,string,string)", std::string("t_bench"), std::string("name"),
+            std::string("item_id,item_name"));
+        context->call(origin, tableFactory, dev::bytesConstRef(&in));
+
+        auto start = std::chrono::steady_clock::now();
+        for (int tx = 0; tx < txCount; ++tx)
+        {
+            dev::Address table;
+            in = abi.abiIn("openTable(string)", std::string("t_bench"));
+            dev::bytes out = context->call(origin, tableFactory, dev::bytesConstRef(&in));
+            abi.abiOut(dev::bytesConstRef(&out), table);
+            for (int row = 0; row < rowsPerTx; ++row)
+            {
+                std::string key = "name_" + std::to_string(row);
+                dev::Address entry;
+                in = abi.abiIn("newEntry()");
+                out = context->call(origin, table, dev::bytesConstRef(&in));
+                abi.abiOut(dev::bytesConstRef(&out), entry);
+                in = abi.abiIn("set(string,string)", std::string("item_id"), std::to_string(tx));
+                context->call(origin, entry, dev::bytesConstRef(&in));
+                in = abi.abiIn("insert(string,address)", key, entry);
+                context->call(origin, table, dev::bytesConstRef(&in));
+
+                dev::Address condition;
+                in = abi.abiIn("newCondition()");
+                out = context->call(origin, table, dev::bytesConstRef(&in));
+                abi.abiOut(dev::bytesConstRef(&out), condition);
+                in = abi.abiIn("select(string,address)", key, condition);
+                context->call(origin, table, dev::bytesConstRef(&in));
+            }
+            context->releaseTemporaryPrecompiled();
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start)
+                           .count();
+        std::cout << "crud txs: " << txCount << ", rows per tx: " << rowsPerTx
+                  << ", elapsed(us): " << elapsed
+                  << ", tx/s: " << (elapsed ? txCount * 1000000.0 / elapsed : 0)
+                  << ", live temporaries: " << context->temporaryPrecompiledSavepoint()
+                  << std::endl;
+    }
+    else if (argc > 1 && std::string("transfer") == argv[1])
+    {
+        // balance transfers through the account state:
+        // test_verifier transfer [blockCount] [txPerBlock] [accountCount]
+        int blockCount = argc > 2 ? std::stoi(argv[2]) : 100;
+        int txPerBlock = argc > 3 ? std::stoi(argv[3]) : 1000;
+        int accountCount = argc > 4 ? std::stoi(argv[4]) : 1000;
+        auto parentBlock = blockChain->getBlockByNumber(blockChain->number());
+        dev::blockverifier::BlockInfo blockInfo = {parentBlock->header().hash(),
+            parentBlock->header().number(), parentBlock->header().stateRoot()};
+
+        auto start = std::chrono::steady_clock::now();
+        for (int block = 0; block < blockCount; ++block)
+        {
+            auto context = std::make_shared<dev::blockverifier::ExecutiveContext>();
+            executiveContextFactory->initExecutiveContext(
+                blockInfo, parentBlock->header().stateRoot(), context);
+            auto state = context->getState();
+            for (int tx = 0; tx < txPerBlock; ++tx)
+            {
+                dev::Address from(0x10000 + tx % accountCount);
+                dev::Address to(0x10000 + (tx + 1) % accountCount);
+                if (!state->accountNonemptyAndExisting(from))
+                    state->addBalance(from, dev::u256(1000000000));
+                state->incNonce(from);
+                state->transferBalance(from, to, dev::u256(1));
+            }
+            state->rootHash();
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start)
+                           .count();
+        auto txCount = blockCount * txPerBlock;
+        std::cout << "transfer blocks: " << blockCount << ", txs per block: " << txPerBlock
+                  << ", accounts: " << accountCount << ", elapsed(us): " << elapsed
+                  << ", tx/s: " << (elapsed ? txCount * 1000000.0 / elapsed : 0) << std::endl;
+    }
+    else if (argc > 1 && std::string("sstore") == argv[1])
+    {
+        // SSTORE/SLOAD cost of the account state:
+        // test_verifier sstore [slotCount] [rounds]
+        int slotCount = argc > 2 ? std::stoi(argv[2]) : 1000;
+        int rounds = argc > 3 ? std::stoi(argv[3]) : 100;
+        auto parentBlock = blockChain->getBlockByNumber(blockChain->number());
+        dev::blockverifier::BlockInfo blockInfo = {parentBlock->header().hash(),
+            parentBlock->header().number(), parentBlock->header().stateRoot()};
+        auto context = std::make_shared<dev::blockverifier::ExecutiveContext>();
+        executiveContextFactory->initExecutiveContext(
+            blockInfo, parentBlock->header().stateRoot(), context);
+        auto state = context->getState();
+        dev::Address contract(0x20000);
+        state->createContract(contract);
+
+        // large slots as used by solidity mappings
+        std::vector<dev::u256> slots;
+        for (int i = 0; i < slotCount; ++i)
+        {
+            slots.push_back(
+                dev::fromBigEndian<dev::u256>(dev::sha3(dev::toBigEndian(dev::u256(i))).asBytes()));
+        }
+        auto start = std::chrono::steady_clock::now();
+        for (int round = 0; round < rounds; ++round)
+        {
+            for (auto const& slot : slots)
+            {
+                state->setStorage(contract, slot, slot + round);
+            }
+        }
+        auto storeElapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start)
+                                .count();
+        start = std::chrono::steady_clock::now();
+        dev::u256 sum;
+        for (int round = 0; round < rounds; ++round)
+        {
+            for (auto const& slot : slots)
+            {
+                sum += state->storage(contract, slot);
+            }
+        }
+        auto loadElapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start)
+                               .count();
+        double ops = double(slotCount) * rounds;
+        std::cout << "slots: " << slotCount << ", rounds: " << rounds
+                  << ", sstore(ns/op): " << storeElapsed * 1000.0 / ops
+                  << ", sload(ns/op): " << loadElapsed * 1000.0 / ops << ", checksum: " << sum
+                  << std::endl;
+    }
     else if (argc > 1 && std::string("verify") == argv[1])
     {
     }
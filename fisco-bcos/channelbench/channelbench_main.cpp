@@ -0,0 +1,318 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @file channelbench_main.cpp
+ * @brief receive throughput of ChannelSession: every connection stands in for an SDK
+ * pipelining sendRawTransaction requests (type 0x12) over loopback without SSL, the handler
+ * copies each body into a string as ChannelRPCServer does before OnRequest;
+ * --amop routes AMOP topics to the sessions of a ChannelRPCServer, a topic followed by every
+ * session (1:N) and a topic of one session, against the scan of the sessions it replaced
+ */
+#include <libchannelserver/ChannelMessage.h>
+#include <libchannelserver/ChannelRPCServer.h>
+#include <libchannelserver/ChannelSession.h>
+#include <libp2p/Service.h>
+#include <boost/program_options.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+using namespace std;
+using namespace dev;
+using namespace dev::channel;
+namespace po = boost::program_options;
+using tcp = boost::asio::ip::tcp;
+
+po::options_description main_options("Main for mini-channelbench");
+
+po::variables_map initCommandLine(int argc, const char* argv[])
+{
+    main_options.add_options()("help,h", "help of mini-channelbench")(
+        "connections,c", po::value<int>()->default_value(4), "[concurrent connections]")(
+        "requests,n", po::value<int>()->default_value(100000), "[requests per connection]")(
+        "size,s", po::value<int>()->default_value(512), "[bytes of a request body]")(
+        "pipeline,p", po::value<int>()->default_value(64), "[requests per socket write]")(
+        "amop", "[route -n topics per thread to -c sessions instead]")(
+        "topics,t", po::value<int>()->default_value(50), "[topics of a session with --amop]")(
+        "threads", po::value<int>()->default_value(4), "[routing threads with --amop]");
+    po::variables_map vm;
+    try
+    {
+        po::store(po::parse_command_line(argc, argv, main_options), vm);
+        po::notify(vm);
+    }
+    catch (...)
+    {
+        std::cout << "invalid input" << std::endl;
+        exit(0);
+    }
+    /// help information
+    if (vm.count("help") || vm.count("h"))
+    {
+        std::cout << main_options << std::endl;
+        exit(0);
+    }
+    return vm;
+}
+
+/// the frames of _requests sendRawTransaction calls with _size bytes of body
+vector<bytes> encodeRequests(int _connection, int _requests, int _size, int _pipeline)
+{
+    string prefix = "{\"jsonrpc\":\"2.0\",\"method\":\"sendRawTransaction\",\"params\":[1,\"0x";
+    string suffix = "\"],\"id\":1}";
+    int fill = max(0, _size - int(prefix.size() + suffix.size()));
+    string body = prefix + string(fill, 'f') + suffix;
+    vector<bytes> writes;
+    for (int i = 0; i < _requests; ++i)
+    {
+        if (i % _pipeline == 0)
+        {
+            writes.emplace_back();
+        }
+        ChannelMessage message;
+        message.setType(0x12);
+        string seq = to_string(_connection) + "-" + to_string(i);
+        message.setSeq(seq + string(32 - seq.size(), '0'));
+        message.setData((const byte*)body.data(), body.size());
+        message.encode(writes.back());
+    }
+    return writes;
+}
+
+/// routes _lookups topics in every thread, @returns lookups per second
+double routeTopics(int _threads, int _lookups, function<size_t(int)> const& _route)
+{
+    atomic<size_t> routed{0};
+    auto start = chrono::steady_clock::now();
+    vector<thread> threads;
+    for (int i = 0; i < _threads; ++i)
+    {
+        threads.emplace_back([&]() {
+            for (int j = 0; j < _lookups; ++j)
+            {
+                routed += _route(j);
+            }
+        });
+    }
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return _threads * _lookups / seconds;
+}
+
+void benchAmop(int _sessions, int _topics, int _lookups, int _threads)
+{
+    auto ioService = make_shared<boost::asio::io_service>();
+    boost::asio::io_service::work work(*ioService);
+    thread ioThread([ioService]() { ioService->run(); });
+    auto threadPool = make_shared<ThreadPool>("ChannelBench", 2);
+    boost::asio::ssl::context sslContext(boost::asio::ssl::context::tlsv12);
+
+    auto server = make_shared<ChannelRPCServer>();
+    server->setService(make_shared<dev::p2p::Service>());
+    tcp::acceptor acceptor(*ioService, tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0));
+    vector<shared_ptr<tcp::socket>> clients;
+    vector<ChannelSession::Ptr> sessions;
+    for (int i = 0; i < _sessions; ++i)
+    {
+        auto client = make_shared<tcp::socket>(*ioService);
+        client->connect(acceptor.local_endpoint());
+        clients.push_back(client);
+
+        auto session = make_shared<ChannelSession>();
+        session->setThreadPool(threadPool);
+        session->setIOService(ioService);
+        session->setEnableSSL(false);
+        session->setMessageFactory(make_shared<ChannelMessageFactory>());
+        session->setSSLSocket(
+            make_shared<boost::asio::ssl::stream<tcp::socket>>(*ioService, sslContext));
+        acceptor.accept(session->sslSocket()->lowest_layer());
+        server->onConnect(ChannelException(), session);
+
+        /// every session follows "all", "session-<i>" and _topics - 2 topics of its own
+        string topics = "[\"all\",\"session-" + to_string(i) + "\"";
+        for (int j = 2; j < _topics; ++j)
+        {
+            topics += ",\"topic-" + to_string(i) + "-" + to_string(j) + "\"";
+        }
+        topics += "]";
+        auto message = make_shared<ChannelMessage>();
+        message->setType(0x32);
+        message->setData((const byte*)topics.data(), topics.size());
+        server->onClientTopicRequest(session, message);
+        sessions.push_back(session);
+    }
+
+    /// the session scan getSessionByTopic did under the session lock
+    mutex sessionLock;
+    auto scan = [&](string const& _topic) {
+        lock_guard<mutex> l(sessionLock);
+        size_t found = 0;
+        for (auto const& session : sessions)
+        {
+            if (session->actived() && session->topics()->count(_topic))
+            {
+                ++found;
+            }
+        }
+        return found;
+    };
+
+    vector<string> oneTopics;
+    for (int i = 0; i < _sessions; ++i)
+    {
+        oneTopics.push_back("session-" + to_string(i));
+    }
+    auto byIndex = [&](string const& _topic) { return server->getSessionByTopic(_topic).size(); };
+    double indexAll =
+        routeTopics(_threads, _lookups, [&](int) { return byIndex(string("all")); });
+    double scanAll = routeTopics(_threads, _lookups, [&](int) { return scan(string("all")); });
+    double indexOne = routeTopics(
+        _threads, _lookups, [&](int _i) { return byIndex(oneTopics[_i % _sessions]); });
+    double scanOne = routeTopics(
+        _threads, _lookups, [&](int _i) { return scan(oneTopics[_i % _sessions]); });
+
+    cout << "sessions: " << _sessions << ", topics per session: " << _topics
+         << ", routing threads: " << _threads << endl;
+    cout << fixed << setprecision(1) << "1:N topic, lookups/s index: " << indexAll
+         << ", scan: " << scanAll << ", speedup: " << setprecision(2) << indexAll / scanAll
+         << endl;
+    cout << setprecision(1) << "1:1 topic, lookups/s index: " << indexOne << ", scan: " << scanOne
+         << ", speedup: " << setprecision(2) << indexOne / scanOne << endl;
+
+    for (auto& session : sessions)
+    {
+        session->disconnectByQuit();
+    }
+    threadPool->stop();
+    ioService->stop();
+    ioThread.join();
+}
+
+int main(int argc, const char* argv[])
+{
+    auto params = initCommandLine(argc, argv);
+    if (params.count("amop"))
+    {
+        benchAmop(params["connections"].defaulted() ? 200 : max(1, params["connections"].as<int>()),
+            max(2, params["topics"].as<int>()),
+            params["requests"].defaulted() ? 20000 : max(1, params["requests"].as<int>()),
+            max(1, params["threads"].as<int>()));
+        return 0;
+    }
+    int connections = max(1, params["connections"].as<int>());
+    int requests = max(1, params["requests"].as<int>());
+    int size = max(64, params["size"].as<int>());
+    int pipeline = max(1, params["pipeline"].as<int>());
+
+    auto ioService = make_shared<boost::asio::io_service>();
+    boost::asio::io_service::work work(*ioService);
+    thread ioThread([ioService]() { ioService->run(); });
+    auto threadPool = make_shared<ThreadPool>("ChannelBench", 8);
+    boost::asio::ssl::context sslContext(boost::asio::ssl::context::tlsv12);
+
+    mutex doneLock;
+    condition_variable doneSignal;
+    atomic<size_t> received{0};
+    atomic<size_t> bodyBytes{0};
+    size_t total = size_t(connections) * requests;
+
+    tcp::acceptor acceptor(*ioService, tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0));
+    vector<ChannelSession::Ptr> sessions;
+    vector<shared_ptr<tcp::socket>> clients;
+    for (int i = 0; i < connections; ++i)
+    {
+        auto client = make_shared<tcp::socket>(*ioService);
+        client->connect(acceptor.local_endpoint());
+        clients.push_back(client);
+
+        auto session = make_shared<ChannelSession>();
+        session->setThreadPool(threadPool);
+        session->setIOService(ioService);
+        session->setEnableSSL(false);
+        session->setMessageFactory(make_shared<ChannelMessageFactory>());
+        session->setSSLSocket(
+            make_shared<boost::asio::ssl::stream<tcp::socket>>(*ioService, sslContext));
+        acceptor.accept(session->sslSocket()->lowest_layer());
+        session->setMessageHandler(
+            [&](ChannelSession::Ptr, ChannelException _e, Message::Ptr _message) {
+                if (_e.errorCode() != 0)
+                {
+                    return;
+                }
+                string body(_message->data(), _message->data() + _message->dataSize());
+                bodyBytes += body.size();
+                if (++received == total)
+                {
+                    lock_guard<mutex> l(doneLock);
+                    doneSignal.notify_all();
+                }
+            });
+        sessions.push_back(session);
+    }
+
+    vector<vector<bytes>> writes;
+    for (int i = 0; i < connections; ++i)
+    {
+        writes.push_back(encodeRequests(i, requests, size, pipeline));
+    }
+
+    auto start = chrono::steady_clock::now();
+    for (auto& session : sessions)
+    {
+        session->run();
+    }
+    vector<thread> threads;
+    for (int i = 0; i < connections; ++i)
+    {
+        threads.emplace_back([&, i]() {
+            for (auto const& buffer : writes[i])
+            {
+                boost::asio::write(*clients[i], boost::asio::buffer(buffer));
+            }
+        });
+    }
+    {
+        unique_lock<mutex> l(doneLock);
+        doneSignal.wait(l, [&]() { return received == total; });
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+
+    cout << "connections: " << connections << ", requests: " << total
+         << ", body bytes: " << size << ", requests per write: " << pipeline << endl;
+    cout << fixed << setprecision(1) << "requests/s: " << total / seconds
+         << ", MB/s: " << bodyBytes / seconds / (1 << 20) << ", seconds: " << setprecision(3)
+         << seconds << endl;
+
+    for (auto& session : sessions)
+    {
+        session->disconnectByQuit();
+    }
+    threadPool->stop();
+    ioService->stop();
+    ioThread.join();
+    return 0;
+}
@@ -39,6 +39,8 @@ using namespace dev::txpool;
 #define CONSENSUS_MAIN_LOG(LEVEL) LOG(LEVEL) << "[#CONSENSUS_MAIN] "
 static void rpcCallbackTest(dev::eth::LocalisedTransactionReceipt::Ptr receiptPtr)
 {
+    if (!receiptPtr)
+        return;
     CONSENSUS_MAIN_LOG(TRACE) << "[#rpcCallbackTest] [blockNumber/txHash/blockHash]:  "
                               << receiptPtr->blockNumber() << "/" << receiptPtr->hash() << "/"
                               << receiptPtr->blockHash() << std::endl;
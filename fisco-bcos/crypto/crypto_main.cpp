@@ -0,0 +1,148 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @file crypto_main.cpp
+ * @brief throughput of the sign/verify/hash of this build (SM2/SM3 in the GM build) against
+ * secp256k1/Keccak-256
+ */
+#include "libinitializer/LogInitializer.h"
+#include <libdevcore/Common.h>
+#include <libdevcore/easylog.h>
+#include <libdevcrypto/Common.h>
+#include <libdevcrypto/Hash.h>
+#include <secp256k1.h>
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <functional>
+#include <future>
+INITIALIZE_EASYLOGGINGPP
+
+using namespace std;
+using namespace dev;
+using namespace dev::initializer;
+namespace po = boost::program_options;
+
+po::options_description main_options("Main for mini-crypto");
+
+po::variables_map initCommandLine(int argc, const char* argv[])
+{
+    main_options.add_options()("help,h", "help of mini-crypto")(
+        "loops,l", po::value<int>()->default_value(10000), "[operations per benchmark]")(
+        "threads,t", po::value<int>()->default_value(1), "[threads of the verify benchmarks]")(
+        "size,s", po::value<int>()->default_value(256), "[bytes hashed per hash operation]");
+    po::variables_map vm;
+    try
+    {
+        po::store(po::parse_command_line(argc, argv, main_options), vm);
+        po::notify(vm);
+    }
+    catch (...)
+    {
+        std::cout << "invalid input" << std::endl;
+        exit(0);
+    }
+    /// help information
+    if (vm.count("help") || vm.count("h"))
+    {
+        std::cout << main_options << std::endl;
+        exit(0);
+    }
+    return vm;
+}
+
+/// run _op(i) for i in [0, _loops) split across _threads threads and print the ops/s
+void bench(string const& _name, int _loops, int _threads, function<void(int)> const& _op)
+{
+    auto start = chrono::steady_clock::now();
+    vector<future<void>> futures;
+    for (int t = 0; t < _threads; ++t)
+    {
+        futures.push_back(async(launch::async, [&, t]() {
+            for (int i = t; i < _loops; i += _threads)
+            {
+                _op(i);
+            }
+        }));
+    }
+    for (auto& f : futures)
+    {
+        f.get();
+    }
+    auto us =
+        chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+    cout << "[" << _name << "] threads: " << _threads
+         << ", ops/s: " << (us ? _loops * 1e6 / us : 0) << endl;
+}
+
+int main(int argc, const char* argv[])
+{
+    // init log
+    boost::property_tree::ptree pt;
+    auto logInitializer = std::make_shared<LogInitializer>();
+    logInitializer->initEasylogging(pt);
+    /// init params
+    auto params = initCommandLine(argc, argv);
+    int loops = max(1, params["loops"].as<int>());
+    int threads = max(1, params["threads"].as<int>());
+    int size = max(0, params["size"].as<int>());
+#ifdef FISCO_GM
+    string const signName = "SM2";
+    string const hashName = "SM3";
+#else
+    string const signName = "secp256k1";
+    string const hashName = "Keccak-256";
+#endif
+
+    KeyPair keyPair = KeyPair::create();
+    vector<h256> hashes(loops);
+    for (int i = 0; i < loops; ++i)
+    {
+        hashes[i] = sha3(to_string(i));
+    }
+    vector<Signature> signatures(loops);
+
+    /// the path used by the node
+    bench(signName + " sign", loops, 1,
+        [&](int i) { signatures[i] = dev::sign(keyPair.secret(), hashes[i]); });
+    bench(signName + " verify", loops, threads,
+        [&](int i) { dev::verify(keyPair.pub(), signatures[i], hashes[i]); });
+    bytes data(size, 0xab);
+    bench(hashName + " " + to_string(size) + " bytes", loops, 1,
+        [&](int) { sha3(bytesConstRef(&data)); });
+
+    /// the reference, libsecp256k1 and Keccak-256 are linked in every build
+    unique_ptr<secp256k1_context, decltype(&secp256k1_context_destroy)> ctx{
+        secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY),
+        &secp256k1_context_destroy};
+    h256 secret = sha3(keyPair.secret().ref());
+    secp256k1_pubkey pubkey;
+    if (!secp256k1_ec_pubkey_create(ctx.get(), &pubkey, secret.data()))
+    {
+        cerr << "invalid secp256k1 secret" << endl;
+        return -1;
+    }
+    vector<secp256k1_ecdsa_signature> ecdsaSignatures(loops);
+    bench("libsecp256k1 sign", loops, 1, [&](int i) {
+        secp256k1_ecdsa_sign(
+            ctx.get(), &ecdsaSignatures[i], hashes[i].data(), secret.data(), nullptr, nullptr);
+    });
+    bench("libsecp256k1 verify", loops, threads, [&](int i) {
+        secp256k1_ecdsa_verify(ctx.get(), &ecdsaSignatures[i], hashes[i].data(), &pubkey);
+    });
+    bench("Keccak-256 " + to_string(size) + " bytes", loops, 1,
+        [&](int) { keccak256(bytesConstRef(&data)); });
+    return 0;
+}
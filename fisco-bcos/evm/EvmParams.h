@@ -54,10 +54,23 @@ public:
         m_gasPrice = pt.get<u256>("evm.gasPrice", u256(0));
         m_gasLimit = pt.get<u256>("evm.gasLimit", u256(100000000000));
         m_blockNumber = pt.get<int64_t>("evm.blockNumber", 0);
+        /// repeat every call transaction to benchmark the interpreter
+        m_callRepeat = pt.get<size_t>("evm.callRepeat", 0);
+        /// vms to benchmark: builtin names or EVMC module paths separated by ','
+        std::string vms = pt.get<std::string>("evm.benchVMs", "");
+        if (!vms.empty())
+            boost::split(m_benchVMs, vms, boost::is_any_of(","), boost::token_compress_on);
+        /// recorded transactions to replay, one hex encoded rlp per line
+        m_corpus = pt.get<std::string>("evm.corpus", "");
+        m_benchLoops =
+            std::max<size_t>(1, std::min<size_t>(pt.get<size_t>("evm.benchLoops", 10000), 0xffff));
         EVMC_LOG(DEBUG) << " [EvmParams.transValue]: " << m_transValue << std::endl;
         EVMC_LOG(DEBUG) << " [EvmParams.gas]: " << m_gas << std::endl;
         EVMC_LOG(DEBUG) << " [EvmParams.gasLimit]: " << m_gasLimit << std::endl;
         EVMC_LOG(DEBUG) << " [EvmParams.blockNumber]: " << m_blockNumber << std::endl;
+        EVMC_LOG(DEBUG) << " [EvmParams.callRepeat]: " << m_callRepeat << std::endl;
+        EVMC_LOG(DEBUG) << " [EvmParams.benchVMs]: " << vms << std::endl;
+        EVMC_LOG(DEBUG) << " [EvmParams.corpus]: " << m_corpus << std::endl;
         ParseCodes(pt);
         ParseInput(pt);
     }
@@ -156,6 +169,10 @@ public:
     u256 const& gasPrice() const { return m_gasPrice; }
     std::vector<bytes> const& code() { return m_code; }
     int64_t const& blockNumber() const { return m_blockNumber; }
+    size_t callRepeat() const { return m_callRepeat; }
+    std::vector<std::string> const& benchVMs() const { return m_benchVMs; }
+    std::string const& corpus() const { return m_corpus; }
+    size_t benchLoops() const { return m_benchLoops; }
     std::vector<bytes> const& code() const { return m_code; }
     std::vector<Input>& input() { return m_input; }
 
@@ -168,4 +185,8 @@ private:
     std::vector<bytes> m_code;
     std::vector<Input> m_input;
     int64_t m_blockNumber;
+    size_t m_callRepeat;
+    std::vector<std::string> m_benchVMs;
+    std::string m_corpus;
+    size_t m_benchLoops;
 };
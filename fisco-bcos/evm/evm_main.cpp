@@ -27,9 +27,13 @@
 #include <libethcore/BlockHeader.h>
 #include <libethcore/Transaction.h>
 #include <libevm/ExtVMFace.h>
+#include <libevm/VMFactory.h>
 #include <libexecutive/Executive.h>
 #include <libexecutive/StateFace.h>
+#include <libinterpreter/AnalysedCode.h>
 #include <libmptstate/MPTState.h>
+#include <boost/algorithm/string.hpp>
+#include <chrono>
 INITIALIZE_EASYLOGGINGPP
 using namespace dev;
 using namespace dev::eth;
@@ -116,6 +120,206 @@ static void callTransaction(
     EVMC_LOG(INFO) << "[evm_main/callTransaction/result string]: " << result << std::endl;
 }
 
+/// call the contract repeatedly, each call analyses the code unless it is cached
+static void benchCall(
+    std::shared_ptr<MPTState> mptState, EnvInfo& info, Input& input, EvmParams const& param)
+{
+    ContractABI abi;
+    bytes inputData = abi.abiIn(input.inputCall);
+    auto& cache = AnalysedCodeCache::instance();
+    auto hits = cache.hits();
+    auto misses = cache.misses();
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < param.callRepeat(); i++)
+    {
+        Transaction tx = Transaction(
+            param.transValue(), param.gasPrice(), param.gas(), input.addr, inputData, u256(0));
+        updateSender(mptState, tx, param);
+        ExecutionResult res;
+        ExecuteTransaction(res, mptState, info, tx);
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start)
+                       .count();
+    EVMC_LOG(INFO) << "[evm_main/benchCall] calls: " << param.callRepeat()
+                   << ", elapsed(us): " << elapsed
+                   << ", tps: " << param.callRepeat() * 1000000.0 / std::max<int64_t>(elapsed, 1)
+                   << ", code cache hits: " << cache.hits() - hits
+                   << ", misses: " << cache.misses() - misses << std::endl;
+}
+
+/// a stack neutral sequence of opcodes of one class, timed in a loop by benchOpcodes
+struct OpcodeClass
+{
+    std::string name;
+    bytes unit;
+    /// opcodes of the class in the unit, the DUP/POP around them are counted as overhead
+    size_t opsPerUnit;
+    /// offset of a PUSH2 jump target in the unit, patched to the JUMPDEST ending the unit
+    size_t jumpTargetAt;
+};
+
+static std::vector<OpcodeClass> opcodeClasses()
+{
+    return {
+        // DUP1 POP
+        {"stack", fromHex("8050"), 2, 0},
+        // DUP1 DUP1 ADD POP, DUP1 DUP1 MUL POP, DUP1 DUP1 DIV POP
+        {"arithmetic", fromHex("808001508080025080800450"), 3, 0},
+        // DUP1 DUP1 DUP1 ADDMOD POP, DUP1 DUP1 DUP1 MULMOD POP
+        {"modular", fromHex("80808008508080800950"), 2, 0},
+        // DUP1 DUP1 EXP POP
+        {"exp", fromHex("80800a50"), 1, 0},
+        // DUP1 DUP1 LT POP, DUP1 DUP1 AND POP, DUP1 DUP1 EQ POP
+        {"compare", fromHex("808010508080165080801450"), 3, 0},
+        // DUP1 PUSH1 0 MSTORE PUSH1 0 MLOAD POP
+        {"memory", fromHex("8060005260005150"), 2, 0},
+        // DUP1 PUSH1 0 SSTORE PUSH1 0 SLOAD POP
+        {"storage", fromHex("8060005560005450"), 2, 0},
+        // PUSH1 32 PUSH1 0 SHA3 POP
+        {"sha3", fromHex("602060002050"), 1, 0},
+        // CALLER POP ADDRESS POP GAS POP
+        {"environment", fromHex("335030505a50"), 3, 0},
+        // PUSH1 1 PUSH2 <next> JUMPI JUMPDEST
+        {"jump", fromHex("6001610000575b"), 2, 3},
+    };
+}
+
+/// PUSH2 _loops JUMPDEST <_units x _unit> PUSH1 1 SWAP1 SUB DUP1 PUSH1 3 JUMPI STOP
+static bytes loopCode(OpcodeClass const& _unit, size_t _units, size_t _loops)
+{
+    bytes code{0x61, static_cast<byte>(_loops >> 8), static_cast<byte>(_loops), 0x5b};
+    for (size_t i = 0; i < _units; ++i)
+    {
+        size_t start = code.size();
+        code += _unit.unit;
+        if (_unit.jumpTargetAt)
+        {
+            size_t target = code.size() - 1;
+            code[start + _unit.jumpTargetAt] = static_cast<byte>(target >> 8);
+            code[start + _unit.jumpTargetAt + 1] = static_cast<byte>(target);
+        }
+    }
+    code += fromHex("600190038060035700");
+    return code;
+}
+
+/// run _code at a new address once, @return elapsed nanoseconds
+static int64_t timeCode(std::shared_ptr<MPTState> mptState, EnvInfo& info, bytes const& _code,
+    EvmParams const& param, u256& o_gasUsed)
+{
+    Input input;
+    input.codeData = _code;
+    input.addr = toAddress(KeyPair::create().pub());
+    updateMptState(mptState, input);
+    Transaction tx = Transaction(
+        param.transValue(), param.gasPrice(), param.gas(), input.addr, bytes(), u256(0));
+    updateSender(mptState, tx, param);
+    ExecutionResult res;
+    auto start = std::chrono::steady_clock::now();
+    ExecuteTransaction(res, mptState, info, tx);
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start)
+                       .count();
+    if (res.excepted != TransactionException::None)
+        EVMC_LOG(WARNING) << "[evm_main/timeCode] execution failed: " << res.excepted;
+    o_gasUsed = res.gasUsed;
+    return elapsed;
+}
+
+/// ns/op of every opcode class, the cost of an empty loop is subtracted
+static void benchOpcodes(
+    std::shared_ptr<MPTState> mptState, EnvInfo& info, EvmParams const& param)
+{
+    const size_t units = 16;
+    size_t loops = param.benchLoops();
+    u256 gasUsed;
+    OpcodeClass empty{"", bytes(), 0, 0};
+    auto baseline = timeCode(mptState, info, loopCode(empty, 0, loops), param, gasUsed);
+    for (auto const& opcodeClass : opcodeClasses())
+    {
+        auto elapsed =
+            timeCode(mptState, info, loopCode(opcodeClass, units, loops), param, gasUsed);
+        double ops = double(loops) * units * opcodeClass.opsPerUnit;
+        EVMC_LOG(INFO) << "[evm_main/benchOpcodes] vm: " << VMFactory::defaultVM()
+                       << ", class: " << opcodeClass.name
+                       << ", ns/op: " << std::max<int64_t>(elapsed - baseline, 0) / ops
+                       << ", gas/s: " << double(gasUsed) * 1e9 / std::max<int64_t>(elapsed, 1)
+                       << std::endl;
+    }
+}
+
+/// replay the recorded transactions in order, senders are funded to pay for them
+static void benchCorpus(std::shared_ptr<MPTState> mptState, EnvInfo& info,
+    std::vector<Transaction> const& corpus)
+{
+    u256 totalGas = 0;
+    size_t failed = 0;
+    int64_t elapsed = 0;
+    for (auto const& recorded : corpus)
+    {
+        Transaction tx = recorded;
+        mptState->addBalance(tx.sender(), tx.value() + tx.gas() * tx.gasPrice());
+        ExecutionResult res;
+        auto start = std::chrono::steady_clock::now();
+        ExecuteTransaction(res, mptState, info, tx);
+        elapsed += std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start)
+                       .count();
+        totalGas += res.gasUsed;
+        if (res.excepted != TransactionException::None)
+            ++failed;
+    }
+    elapsed = std::max<int64_t>(elapsed, 1);
+    EVMC_LOG(INFO) << "[evm_main/benchCorpus] vm: " << VMFactory::defaultVM()
+                   << ", txs: " << corpus.size() << ", failed: " << failed
+                   << ", gas: " << totalGas << ", elapsed(ns): " << elapsed
+                   << ", gas/s: " << double(totalGas) * 1e9 / elapsed
+                   << ", ns/tx: " << elapsed / std::max<size_t>(corpus.size(), 1) << std::endl;
+}
+
+static std::vector<Transaction> loadCorpus(std::string const& _path)
+{
+    std::vector<Transaction> corpus;
+    std::vector<std::string> lines;
+    std::string content = contentsString(_path);
+    boost::split(lines, content, boost::is_any_of("\n"), boost::token_compress_on);
+    for (auto& line : lines)
+    {
+        boost::trim(line);
+        if (line.empty())
+            continue;
+        corpus.emplace_back(fromHex(line), CheckTransaction::None);
+    }
+    EVMC_LOG(INFO) << "[evm_main/loadCorpus] path: " << _path << ", txs: " << corpus.size()
+                   << std::endl;
+    return corpus;
+}
+
+/// compare the configured vms, each one runs on its own state
+static void benchVMs(BlockHeader const& header, EvmParams const& param)
+{
+    std::vector<Transaction> corpus;
+    if (!param.corpus().empty())
+        corpus = loadCorpus(param.corpus());
+    std::shared_ptr<FakeBlockChain> blockChain = std::make_shared<FakeBlockChain>();
+    for (auto const& vm : param.benchVMs())
+    {
+        if (!VMFactory::setDefaultVM(vm))
+        {
+            EVMC_LOG(WARNING) << "[evm_main/benchVMs] skip vm: " << vm << std::endl;
+            continue;
+        }
+        EnvInfo envInfo(header, boost::bind(&FakeBlockChain::numberHash, blockChain, _1), u256(0));
+        std::shared_ptr<MPTState> mptState = std::make_shared<MPTState>(
+            u256(0), MPTState::openDB("./", sha3(vm)), BaseState::Empty);
+        if (!corpus.empty())
+            benchCorpus(mptState, envInfo, corpus);
+        benchOpcodes(mptState, envInfo, param);
+    }
+    VMFactory::setDefaultVM("interpreter");
+}
+
 int main(int argc, const char* argv[])
 {
     /// init configuration
@@ -144,6 +348,10 @@ int main(int argc, const char* argv[])
         EVMC_LOG(INFO) << "=======[evm_main/BEGIN call transaction/index]:" << i
                        << "=======" << std::endl;
         callTransaction(mptState, envInfo, param.input()[i], param);
+        if (param.callRepeat() > 0)
+            benchCall(mptState, envInfo, param.input()[i], param);
     }
+    if (!param.benchVMs().empty())
+        benchVMs(header, param);
     return 0;
 }
@@ -0,0 +1,404 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @file rpcbench_main.cpp
+ * @brief load test of the jsonrpc http port: every connection sends the calls round robin
+ * over keep-alive, the QPS and the latency percentiles are reported per method;
+ * --websocket sends them to the websocket port instead, --pipeline requests in flight per
+ * connection;
+ * --block-txs serializes a large block offline with the Json::Value and the streaming paths
+ */
+#include <libdevcrypto/Common.h>
+#include <libethcore/Block.h>
+#include <libethcore/CommonJS.h>
+#include <libethcore/Transaction.h>
+#include <librpc/JsonHelper.h>
+#include <boost/asio.hpp>
+#include <boost/beast.hpp>
+#include <boost/beast/websocket.hpp>
+#include <boost/program_options.hpp>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <thread>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+namespace po = boost::program_options;
+namespace http = boost::beast::http;
+namespace websocket = boost::beast::websocket;
+using tcp = boost::asio::ip::tcp;
+
+po::options_description main_options("Main for mini-rpcbench");
+
+po::variables_map initCommandLine(int argc, const char* argv[])
+{
+    main_options.add_options()("help,h", "help of mini-rpcbench")(
+        "host", po::value<string>()->default_value("127.0.0.1"), "[jsonrpc listen ip]")(
+        "port,p", po::value<string>()->default_value("30302"), "[jsonrpc listen port]")(
+        "connections,c", po::value<int>()->default_value(8), "[concurrent connections]")(
+        "requests,n", po::value<int>()->default_value(1000), "[requests per connection]")(
+        "call,m", po::value<vector<string>>()->multitoken(),
+        "[method:params] ..., params is a JSON array, default getBlockNumber:[1]")(
+        "batch,b", po::value<int>()->default_value(1), "[calls per request, >1 sends arrays]")(
+        "websocket", "[the port is the websocket port, permessage-deflate is offered]")(
+        "pipeline", po::value<int>()->default_value(1),
+        "[requests in flight per connection with --websocket]")(
+        "block-txs", po::value<int>(),
+        "[transactions of a block serialized -n times offline, no node is needed]");
+    po::variables_map vm;
+    try
+    {
+        po::store(po::parse_command_line(argc, argv, main_options), vm);
+        po::notify(vm);
+    }
+    catch (...)
+    {
+        std::cout << "invalid input" << std::endl;
+        exit(0);
+    }
+    /// help information
+    if (vm.count("help") || vm.count("h"))
+    {
+        std::cout << main_options << std::endl;
+        exit(0);
+    }
+    return vm;
+}
+
+struct Call
+{
+    string method;
+    string params;
+};
+
+struct MethodStats
+{
+    vector<double> latenciesMs;
+    size_t errors = 0;
+};
+
+/// the request _batch calls starting at call number _next
+string buildRequest(vector<Call> const& _calls, size_t _next, int _batch)
+{
+    string body;
+    for (int j = 0; j < _batch; ++j, ++_next)
+    {
+        auto const& call = _calls[_next % _calls.size()];
+        body += (j ? "," : "") + string("{\"jsonrpc\":\"2.0\",\"method\":\"") + call.method +
+                "\",\"params\":" + call.params + ",\"id\":" + to_string(_next) + "}";
+    }
+    return _batch > 1 ? "[" + body + "]" : body;
+}
+
+void mergeStats(map<string, MethodStats> const& _stats, mutex& _statsLock,
+    map<string, MethodStats>& _total)
+{
+    lock_guard<mutex> l(_statsLock);
+    for (auto& it : _stats)
+    {
+        auto& total = _total[it.first];
+        total.latenciesMs.insert(
+            total.latenciesMs.end(), it.second.latenciesMs.begin(), it.second.latenciesMs.end());
+        total.errors += it.second.errors;
+    }
+}
+
+/// one websocket connection keeping _pipeline requests in flight, the responses come back in
+/// completion order and are matched by the id of their first call
+void runWebSocketConnection(string const& _host, string const& _port, vector<Call> const& _calls,
+    int _requests, int _batch, int _pipeline, mutex& _statsLock, map<string, MethodStats>& _stats)
+{
+    typedef chrono::steady_clock::time_point TimePoint;
+    map<string, MethodStats> stats;
+    try
+    {
+        boost::asio::io_context ioc;
+        tcp::resolver resolver(ioc);
+        websocket::stream<tcp::socket> ws(ioc);
+        boost::asio::connect(ws.next_layer(), resolver.resolve(_host, _port));
+        websocket::permessage_deflate deflate;
+        deflate.client_enable = true;
+        ws.set_option(deflate);
+        ws.handshake(_host, "/");
+        ws.text(true);
+
+        boost::beast::multi_buffer buffer;
+        map<int64_t, pair<string, TimePoint>> inFlight;
+        size_t next = 0;
+        int sent = 0;
+        while (sent < _requests || !inFlight.empty())
+        {
+            while (sent < _requests && int(inFlight.size()) < _pipeline)
+            {
+                inFlight[next] = make_pair(_calls[next % _calls.size()].method,
+                    chrono::steady_clock::now());
+                ws.write(boost::asio::buffer(buildRequest(_calls, next, _batch)));
+                next += _batch;
+                ++sent;
+            }
+            ws.read(buffer);
+            string response = boost::beast::buffers_to_string(buffer.data());
+            buffer.consume(buffer.size());
+            auto end = chrono::steady_clock::now();
+
+            Json::Value value;
+            Json::Reader().parse(response, value, false);
+            Json::Value const& first = value.isArray() && value.size() ? value[0u] : value;
+            auto it = first.isObject() ? inFlight.find(first["id"].asInt64()) : inFlight.end();
+            if (it == inFlight.end())
+            {
+                /// a notification, or a response without id
+                continue;
+            }
+            auto& methodStats = stats[it->second.first];
+            methodStats.latenciesMs.push_back(
+                chrono::duration<double, milli>(end - it->second.second).count());
+            if (response.find("\"error\"") != string::npos)
+            {
+                ++methodStats.errors;
+            }
+            inFlight.erase(it);
+        }
+        ws.close(websocket::close_code::normal);
+    }
+    catch (std::exception& e)
+    {
+        cerr << "connection failed: " << e.what() << endl;
+    }
+    mergeStats(stats, _statsLock, _stats);
+}
+
+/// one keep-alive connection sending _requests requests, the calls are taken round robin
+void runConnection(string const& _host, string const& _port, vector<Call> const& _calls,
+    int _requests, int _batch, mutex& _statsLock, map<string, MethodStats>& _stats)
+{
+    map<string, MethodStats> stats;
+    try
+    {
+        boost::asio::io_context ioc;
+        tcp::resolver resolver(ioc);
+        tcp::socket socket(ioc);
+        boost::asio::connect(socket, resolver.resolve(_host, _port));
+        boost::beast::flat_buffer buffer;
+        size_t next = 0;
+        for (int i = 0; i < _requests; ++i)
+        {
+            // a batch is accounted to the method of its first call
+            string method = _calls[next % _calls.size()].method;
+            string body = buildRequest(_calls, next, _batch);
+            next += _batch;
+            http::request<http::string_body> request{http::verb::post, "/", 11};
+            request.set(http::field::host, _host);
+            request.set(http::field::content_type, "application/json");
+            request.keep_alive(true);
+            request.body() = body;
+            request.prepare_payload();
+
+            auto start = chrono::steady_clock::now();
+            http::write(socket, request);
+            http::response<http::string_body> response;
+            http::read(socket, buffer, response);
+            auto latency = chrono::duration<double, milli>(chrono::steady_clock::now() - start);
+
+            auto& methodStats = stats[method];
+            methodStats.latenciesMs.push_back(latency.count());
+            if (response.result() != http::status::ok ||
+                response.body().find("\"error\"") != string::npos)
+            {
+                ++methodStats.errors;
+            }
+        }
+        boost::system::error_code ignored;
+        socket.shutdown(tcp::socket::shutdown_both, ignored);
+    }
+    catch (std::exception& e)
+    {
+        cerr << "connection failed: " << e.what() << endl;
+    }
+    mergeStats(stats, _statsLock, _stats);
+}
+
+double percentile(vector<double> const& _sorted, double _p)
+{
+    if (_sorted.empty())
+    {
+        return 0;
+    }
+    size_t index = min(_sorted.size() - 1, size_t(_p * _sorted.size()));
+    return _sorted[index];
+}
+
+/// the getBlockByNumber response built as Rpc does it
+Json::Value blockToJson(Block const& _block)
+{
+    auto const& header = _block.blockHeader();
+    Json::Value response;
+    response["number"] = toJS(header.number());
+    response["hash"] = toJS(header.hash());
+    response["parentHash"] = toJS(header.parentHash());
+    response["logsBloom"] = toJS(header.logBloom());
+    response["transactionsRoot"] = toJS(header.transactionsRoot());
+    response["stateRoot"] = toJS(header.stateRoot());
+    response["sealer"] = toJS(header.sealer());
+    response["extraData"] = Json::Value(Json::arrayValue);
+    for (auto const& data : header.extraData())
+        response["extraData"].append(toJS(data));
+    response["gasLimit"] = toJS(header.gasLimit());
+    response["gasUsed"] = toJS(header.gasUsed());
+    response["timestamp"] = toJS(header.timestamp());
+    response["transactions"] = Json::Value(Json::arrayValue);
+    auto const& transactions = _block.transactions();
+    for (unsigned i = 0; i < transactions.size(); i++)
+        response["transactions"].append(dev::rpc::toJson(
+            transactions[i], std::make_pair(header.hash(), i), header.number()));
+    return response;
+}
+
+void benchSerialize(int _txs, int _loops)
+{
+    KeyPair keyPair = KeyPair::create();
+    Transactions transactions;
+    for (int i = 0; i < _txs; ++i)
+    {
+        bytes input(256, byte(i));
+        Transaction tx(u256(i), u256(1), u256(300000000), Address(i + 1), input, u256(i));
+        SignatureStruct sig = sign(keyPair.secret(), tx.sha3(WithoutSignature));
+        tx.updateSignature(sig);
+        transactions.push_back(tx);
+    }
+    BlockHeader header;
+    header.setNumber(1);
+    header.setGasLimit(u256(300000000));
+    header.setTimestamp(utcTime());
+    Block block;
+    block.setBlockHeader(header);
+    block.setTransactions(transactions);
+    // the senders are recovered once, as in the blocks read from the storage
+    for (auto const& tx : block.transactions())
+        tx.safeSender();
+
+    size_t size = 0;
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < _loops; ++i)
+        size = Json::FastWriter().write(blockToJson(block)).size();
+    double jsonValueMs =
+        chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() / _loops;
+
+    dev::rpc::JsonWriter writer;
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < _loops; ++i)
+    {
+        writer.clear();
+        dev::rpc::writeJson(writer, block, true);
+    }
+    double jsonWriterMs =
+        chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() / _loops;
+
+    cout << "block of " << _txs << " transactions, " << size << " bytes of JSON" << endl;
+    cout << fixed << setprecision(3) << "Json::Value + FastWriter: " << jsonValueMs
+         << " ms, JsonWriter: " << jsonWriterMs << " ms, speedup: " << setprecision(2)
+         << jsonValueMs / jsonWriterMs << endl;
+}
+
+int main(int argc, const char* argv[])
+{
+    auto params = initCommandLine(argc, argv);
+    if (params.count("block-txs"))
+    {
+        benchSerialize(max(1, params["block-txs"].as<int>()),
+            params["requests"].defaulted() ? 100 : max(1, params["requests"].as<int>()));
+        return 0;
+    }
+    string host = params["host"].as<string>();
+    string port = params["port"].as<string>();
+    int connections = max(1, params["connections"].as<int>());
+    int requests = max(1, params["requests"].as<int>());
+    int batch = max(1, params["batch"].as<int>());
+    bool webSocket = params.count("websocket");
+    int pipeline = max(1, params["pipeline"].as<int>());
+
+    vector<Call> calls;
+    if (params.count("call"))
+    {
+        for (auto const& call : params["call"].as<vector<string>>())
+        {
+            auto separatorPos = call.find(':');
+            if (separatorPos == string::npos)
+            {
+                calls.push_back(Call{call, "[]"});
+            }
+            else
+            {
+                calls.push_back(Call{call.substr(0, separatorPos), call.substr(separatorPos + 1)});
+            }
+        }
+    }
+    if (calls.empty())
+    {
+        calls.push_back(Call{"getBlockNumber", "[1]"});
+    }
+
+    mutex statsLock;
+    map<string, MethodStats> stats;
+    auto start = chrono::steady_clock::now();
+    vector<thread> threads;
+    for (int i = 0; i < connections; ++i)
+    {
+        threads.emplace_back([&]() {
+            if (webSocket)
+            {
+                runWebSocketConnection(
+                    host, port, calls, requests, batch, pipeline, statsLock, stats);
+            }
+            else
+            {
+                runConnection(host, port, calls, requests, batch, statsLock, stats);
+            }
+        });
+    }
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    size_t total = 0;
+    cout << setw(28) << left << "method" << right << setw(10) << "requests" << setw(8)
+         << "errors" << setw(10) << "QPS" << setw(10) << "p50(ms)" << setw(10) << "p90(ms)"
+         << setw(10) << "p99(ms)" << setw(10) << "max(ms)" << endl;
+    for (auto& it : stats)
+    {
+        auto& latencies = it.second.latenciesMs;
+        sort(latencies.begin(), latencies.end());
+        total += latencies.size();
+        cout << setw(28) << left << it.first << right << setw(10) << latencies.size() << setw(8)
+             << it.second.errors << setw(10) << fixed << setprecision(1)
+             << latencies.size() / seconds << setw(10) << setprecision(2)
+             << percentile(latencies, 0.5) << setw(10) << percentile(latencies, 0.9) << setw(10)
+             << percentile(latencies, 0.99) << setw(10)
+             << (latencies.empty() ? 0 : latencies.back()) << endl;
+    }
+    cout << (webSocket ? "websocket, requests in flight: " + to_string(pipeline) + ", " : "")
+         << "total requests: " << total << ", calls per request: " << batch
+         << ", QPS: " << fixed << setprecision(1) << total / seconds
+         << ", calls/s: " << total * batch / seconds << endl;
+    return 0;
+}
@@ -21,14 +21,23 @@
 #include "libinitializer/LogInitializer.h"
 #include "libstorage/MemoryTableFactory.h"
 #include <leveldb/db.h>
+#include <libblockchain/BlockChainImp.h>
+#include <libblockverifier/ExecutiveContext.h>
 #include <libdevcore/BasicLevelDB.h>
 #include <libdevcore/Common.h>
 #include <libdevcore/easylog.h>
+#include <libdevcrypto/Common.h>
 #include <libstorage/LevelDBStorage.h>
+#include <libstoragestate/StorageStateFactory.h>
+#ifdef FISCO_ROCKSDB
+#include <libstorage/RocksDBStorage.h>
+#endif
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/split.hpp>
 #include <boost/program_options.hpp>
+#include <chrono>
+#include <random>
 INITIALIZE_EASYLOGGINGPP
 
 using namespace std;
@@ -36,6 +45,9 @@ using namespace dev;
 using namespace boost;
 using namespace dev::storage;
 using namespace dev::initializer;
+using namespace dev::eth;
+using namespace dev::blockchain;
+using namespace dev::blockverifier;
 namespace po = boost::program_options;
 
 po::options_description main_options("Main for mini-storage");
@@ -49,7 +61,9 @@ po::variables_map initCommandLine(int argc, const char* argv[])
         po::value<vector<string>>()->multitoken(), "[TableName] [priKey] [Key] [NewValue]")(
         "insert,i", po::value<vector<string>>()->multitoken(),
         "[TableName] [priKey] [Key]:[Value],...,[Key]:[Value]")(
-        "remove,r", po::value<vector<string>>()->multitoken(), "[TableName] [priKey]");
+        "remove,r", po::value<vector<string>>()->multitoken(), "[TableName] [priKey]")(
+        "bench,b", po::value<vector<int>>()->multitoken(), "[BlockNum] [RowsPerBlock]")(
+        "receipts,R", po::value<vector<int>>()->multitoken(), "[BlockNum] [TxsPerBlock]");
     po::variables_map vm;
     try
     {
@@ -96,6 +110,133 @@ void printEntries(Entries::Ptr entries)
     cout << "============================" << endl;
 }
 
+/// commit _blocks blocks of _rows contract rows (plus a block row) and then select them randomly
+void benchStorage(string const& _name, Storage::Ptr _storage, int _blocks, int _rows)
+{
+    string contractTable = "_contract_data_" + string(40, 'a') + "_";
+    string blockValue(1024, 'b');
+    auto start = chrono::steady_clock::now();
+    for (int num = 1; num <= _blocks; ++num)
+    {
+        auto blockData = make_shared<TableData>();
+        blockData->tableName = SYS_HASH_2_BLOCK;
+        auto blockEntries = make_shared<Entries>();
+        auto blockEntry = make_shared<Entry>();
+        blockEntry->setField("value", blockValue);
+        blockEntries->addEntry(blockEntry);
+        blockData->data[h256(num).hex()] = blockEntries;
+
+        auto contractData = make_shared<TableData>();
+        contractData->tableName = contractTable;
+        for (int row = 0; row < _rows; ++row)
+        {
+            auto entries = make_shared<Entries>();
+            auto entry = make_shared<Entry>();
+            entry->setField("key", to_string(num * _rows + row));
+            entry->setField("value", to_string(num));
+            entries->addEntry(entry);
+            contractData->data[to_string(num * _rows + row)] = entries;
+        }
+        vector<TableData::Ptr> datas{blockData, contractData};
+        _storage->commit(h256(num), num, datas, h256(num));
+    }
+    auto commitUs =
+        chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+
+    mt19937 rng(0);
+    uniform_int_distribution<int> dist(_rows, (_blocks + 1) * _rows - 1);
+    int selects = _blocks * _rows;
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < selects; ++i)
+    {
+        _storage->select(h256(0), 0, contractTable, to_string(dist(rng)));
+    }
+    auto selectUs =
+        chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+
+    cout << "[" << _name << "] commit blocks/s: " << (commitUs ? _blocks * 1e6 / commitUs : 0)
+         << ", rows/s: " << (commitUs ? _blocks * _rows * 1e6 / commitUs : 0)
+         << ", random select/s: " << (selectUs ? selects * 1e6 / selectUs : 0) << endl;
+}
+
+/// commit _blocks blocks of _txs transactions through BlockChainImp, then look the receipts up
+/// randomly with and without the decoded blocks in memory
+void benchReceipts(Storage::Ptr _storage, int _blocks, int _txs)
+{
+    auto blockChain = make_shared<BlockChainImp>();
+    blockChain->setStateStorage(_storage);
+    auto stateFactory = make_shared<dev::storagestate::StorageStateFactory>(u256(0));
+    blockChain->setStateFactory(stateFactory);
+    GenesisBlockParam initParam{
+        "", h512s(), h512s(), "pbft", "LevelDB", "storage", 1000, 300000000};
+    blockChain->checkAndBuildGenesisBlock(initParam);
+
+    KeyPair keyPair = KeyPair::create();
+    vector<h256> txHashes;
+    for (int num = 1; num <= _blocks; ++num)
+    {
+        Transactions transactions;
+        TransactionReceipts receipts;
+        for (int i = 0; i < _txs; ++i)
+        {
+            Transaction tx(u256(0), u256(1), u256(300000000), Address(i + 1), bytes(128, byte(i)),
+                u256(num) * _txs + i);
+            SignatureStruct sig = dev::sign(keyPair.secret(), tx.sha3(WithoutSignature));
+            tx.updateSignature(sig);
+            transactions.push_back(tx);
+            txHashes.push_back(tx.sha3());
+            LogEntries logs{LogEntry(Address(i + 1), h256s{h256(i)}, bytes(64, byte(i)))};
+            receipts.push_back(TransactionReceipt(h256(i), u256(21000), logs, u256(0), bytes(32),
+                Address()));
+        }
+        BlockHeader header;
+        header.setNumber(num);
+        header.setParentHash(blockChain->numberHash(num - 1));
+        header.setGasLimit(u256(300000000));
+        header.setTimestamp(utcTime());
+        Block block;
+        block.setBlockHeader(header);
+        block.setTransactions(transactions);
+        block.setTransactionReceipts(receipts);
+
+        auto context = make_shared<ExecutiveContext>();
+        auto memoryTableFactory = blockChain->getMemoryTableFactory();
+        context->setMemoryTableFactory(memoryTableFactory);
+        context->setState(stateFactory->getState(h256(), memoryTableFactory));
+        blockChain->commitBlock(block, context);
+    }
+
+    mt19937 rng(0);
+    uniform_int_distribution<size_t> dist(0, txHashes.size() - 1);
+    int lookups = max(1000, _txs);
+    for (size_t cacheMB : {size_t(0), size_t(256)})
+    {
+        blockChain->setBlockCacheCapacity(cacheMB << 20);
+        auto start = chrono::steady_clock::now();
+        for (int i = 0; i < lookups; ++i)
+        {
+            blockChain->getLocalisedTxReceiptByHash(txHashes[dist(rng)]);
+        }
+        auto receiptUs = chrono::duration_cast<chrono::microseconds>(
+            chrono::steady_clock::now() - start)
+                             .count();
+        cout << "[" << _blocks << " blocks of " << _txs << " txs, decoded block cache " << cacheMB
+             << "MB] receipt lookups/s: " << (receiptUs ? lookups * 1e6 / receiptUs : 0) << endl;
+    }
+
+    // what every lookup used to cost: decoding the whole block
+    blockChain->setBlockCacheCapacity(0);
+    int decodes = max(1, 10000 / _txs);
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < decodes; ++i)
+    {
+        blockChain->getBlockByNumber(1 + i % _blocks);
+    }
+    auto decodeUs =
+        chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+    cout << "full block decodes/s: " << (decodeUs ? decodes * 1e6 / decodeUs : 0) << endl;
+}
+
 int main(int argc, const char* argv[])
 {
     // init log
@@ -105,11 +246,53 @@ int main(int argc, const char* argv[])
     /// init params
     auto params = initCommandLine(argc, argv);
     auto storagePath = params["path"].as<string>();
+    if (params.count("receipts"))
+    {
+        auto& p = params["receipts"].as<vector<int>>();
+        int blocks = p.size() > 0 ? p[0] : 10;
+        int txs = p.size() > 1 ? max(1, p[1]) : 1000;
+        filesystem::create_directories(storagePath + "/receipts");
+        leveldb::Options option = dev::db::sharedLevelDBOptions(dev::db::LevelDBConfig());
+        dev::db::BasicLevelDB* dbPtr = NULL;
+        leveldb::Status s = dev::db::BasicLevelDB::Open(option, storagePath + "/receipts", &dbPtr);
+        if (!s.ok())
+        {
+            cerr << "Open storage leveldb error: " << s.ToString() << endl;
+            return -1;
+        }
+        auto levelDBStorage = std::make_shared<dev::storage::LevelDBStorage>();
+        levelDBStorage->setDB(std::shared_ptr<dev::db::BasicLevelDB>(dbPtr));
+        benchReceipts(levelDBStorage, blocks, txs);
+        return 0;
+    }
+    if (params.count("bench"))
+    {
+        auto& p = params["bench"].as<vector<int>>();
+        int blocks = p.size() > 0 ? p[0] : 1000;
+        int rows = p.size() > 1 ? p[1] : 1000;
+        filesystem::create_directories(storagePath + "/leveldb");
+        leveldb::Options option = dev::db::sharedLevelDBOptions(dev::db::LevelDBConfig());
+        dev::db::BasicLevelDB* dbPtr = NULL;
+        leveldb::Status s = dev::db::BasicLevelDB::Open(option, storagePath + "/leveldb", &dbPtr);
+        if (!s.ok())
+        {
+            cerr << "Open storage leveldb error: " << s.ToString() << endl;
+            return -1;
+        }
+        auto levelDBStorage = std::make_shared<dev::storage::LevelDBStorage>();
+        levelDBStorage->setDB(std::shared_ptr<dev::db::BasicLevelDB>(dbPtr));
+        benchStorage("LevelDB", levelDBStorage, blocks, rows);
+#ifdef FISCO_ROCKSDB
+        filesystem::create_directories(storagePath + "/rocksdb");
+        auto rocksDBStorage = std::make_shared<dev::storage::RocksDBStorage>();
+        rocksDBStorage->open(storagePath + "/rocksdb", RocksDBOptions());
+        benchStorage("RocksDB", rocksDBStorage, blocks, rows);
+#endif
+        return 0;
+    }
     cout << "LevelDB path : " << storagePath << endl;
     filesystem::create_directories(storagePath);
-    leveldb::Options option;
-    option.create_if_missing = true;
-    option.max_open_files = 100;
+    leveldb::Options option = dev::db::sharedLevelDBOptions(dev::db::LevelDBConfig());
     dev::db::BasicLevelDB* dbPtr = NULL;
     leveldb::Status s = dev::db::BasicLevelDB::Open(option, storagePath, &dbPtr);
     if (!s.ok())
@@ -47,55 +47,44 @@ using namespace dev::blockverifier;
 using namespace dev::executive;
 using boost::lexical_cast;
 
+/// the block cache statistics are logged every c_blockCacheStatsInterval misses
+static const uint64_t c_blockCacheStatsInterval = 1000;
+
+/// memory held by a decoded block: the objects and the variable length fields of its
+/// transactions, receipts and logs
+static size_t decodedSize(Block const& _block)
+{
+    size_t size = sizeof(Block) + _block.sigList().size() * sizeof(_block.sigList()[0]);
+    for (auto const& tx : _block.transactions())
+        size += sizeof(Transaction) + tx.data().size();
+    for (auto const& receipt : _block.transactionReceipts())
+    {
+        size += sizeof(TransactionReceipt) + receipt.outputBytes().size();
+        for (auto const& log : receipt.log())
+            size += sizeof(LogEntry) + log.topics.size() * sizeof(h256) + log.data.size();
+    }
+    return size;
+}
+
 std::shared_ptr<Block> BlockCache::add(Block& _block)
 {
     BLOCKCHAIN_LOG(TRACE) << "[#add] Add block to block cache, [blockHash]: "
                           << _block.header().hash();
 
-    {
-        WriteGuard guard(m_sharedMutex);
-        if (m_blockCache.size() > c_blockCacheSize)
-        {
-            BLOCKCACHE_LOG(TRACE) << "[#add] Block cache full, start to remove old item...";
-
-            auto firstHash = m_blockCacheFIFO.front();
-            m_blockCacheFIFO.pop_front();
-            m_blockCache.erase(firstHash);
-            // in case something unexcept error
-            if (m_blockCache.size() > c_blockCacheSize)
-            {
-                // meet error, cache and cacheFIFO not sync, clear the cache
-                m_blockCache.clear();
-                m_blockCacheFIFO.clear();
-            }
-        }
-
-        auto blockHash = _block.header().hash();
-        auto block = std::make_shared<Block>(_block);
-        m_blockCache.insert(std::make_pair(blockHash, std::make_pair(block, blockHash)));
-        // add hashindex to the blockCache queue, use to remove first element when the cache is full
-        m_blockCacheFIFO.push_back(blockHash);
-
-        return block;
-    }
+    auto block = std::make_shared<Block>(_block);
+    m_blockCache.put(_block.header().hash(), CachedBlock{block, decodedSize(*block)});
+    return block;
 }
 
 std::pair<std::shared_ptr<Block>, h256> BlockCache::get(h256 const& _hash)
 {
     BLOCKCHAIN_LOG(TRACE) << "[#add] Read block from block cache, [blockHash]: " << _hash;
+    CachedBlock cached;
+    if (!m_blockCache.get(_hash, cached))
     {
-        ReadGuard guard(m_sharedMutex);
-
-        auto it = m_blockCache.find(_hash);
-        if (it == m_blockCache.end())
-        {
-            return std::make_pair(nullptr, h256(0));
-        }
-
-        return it->second;
+        return std::make_pair(nullptr, h256(0));
     }
-
-    return std::make_pair(nullptr, h256(0));  // just make compiler happy
+    return std::make_pair(cached.block, _hash);
 }
 
 void BlockChainImp::setStateStorage(Storage::Ptr stateStorage)
@@ -156,10 +145,18 @@ std::shared_ptr<Block> BlockChainImp::getBlock(dev::h256 const& _blockHash)
             {
                 auto entry = entries->get(0);
                 strBlock = entry->getField(SYS_VALUE);
-                auto block = Block(fromHex(strBlock.c_str()));
+                bytes blockData = fromHex(strBlock.c_str());
+                auto block = Block(blockData);
 
                 BLOCKCHAIN_LOG(TRACE) << "[#getBlock] Write to cache";
                 auto blockPtr = m_blockCache.add(block);
+                uint64_t misses = m_blockCache.misses();
+                if (misses % c_blockCacheStatsInterval == 0)
+                {
+                    BLOCKCHAIN_LOG(DEBUG)
+                        << "[#getBlock] block cache [hits/misses/bytes]: " << m_blockCache.hits()
+                        << "/" << misses << "/" << m_blockCache.size();
+                }
                 return blockPtr;
             }
         }
@@ -539,27 +536,112 @@ std::shared_ptr<Block> BlockChainImp::getBlockByNumber(int64_t _i)
     }
 }
 
-Transaction BlockChainImp::getTxByHash(dev::h256 const& _txHash)
+static std::pair<size_t, size_t> parseRange(std::string const& _range)
+{
+    auto separatorPos = _range.find(':');
+    return std::make_pair(lexical_cast<size_t>(_range.substr(0, separatorPos)),
+        lexical_cast<size_t>(_range.substr(separatorPos + 1)));
+}
+
+static std::string rangeOf(bytesConstRef _item, bytes const& _blockData)
+{
+    return lexical_cast<std::string>(_item.data() - _blockData.data()) + ":" +
+           lexical_cast<std::string>(_item.size());
+}
+
+bool BlockChainImp::getTxLocation(dev::h256 const& _txHash, TxLocation& o_location)
 {
-    string strblock = "";
-    string txIndex = "";
     Table::Ptr tb = getMemoryTableFactory()->openTable(SYS_TX_HASH_2_BLOCK, false);
-    if (tb)
+    if (!tb)
     {
-        auto entries = tb->select(_txHash.hex(), tb->newCondition());
-        if (entries->size() > 0)
+        return false;
+    }
+    auto entries = tb->select(_txHash.hex(), tb->newCondition());
+    if (entries->size() == 0)
+    {
+        return false;
+    }
+    auto fields = entries->get(0)->fields();
+    o_location.number = lexical_cast<int64_t>(fields->at(SYS_VALUE));
+    o_location.index = lexical_cast<unsigned>(fields->at(SYS_TX_INDEX));
+    auto blockHash = fields->find(SYS_TX_BLOCK_HASH);
+    if (blockHash == fields->end())
+    {
+        // written by an older node, only the block number is known
+        o_location.hasRanges = false;
+        o_location.blockHash = numberHash(o_location.number);
+        return true;
+    }
+    o_location.hasRanges = true;
+    o_location.blockHash = h256(blockHash->second);
+    o_location.txRange = parseRange(fields->at(SYS_TX_RANGE));
+    o_location.receiptRange = parseRange(fields->at(SYS_TX_RECEIPT_RANGE));
+    o_location.from = Address(fields->at(SYS_TX_FROM));
+    return true;
+}
+
+bool BlockChainImp::readTx(
+    TxLocation const& _location, Transaction* o_tx, TransactionReceipt* o_receipt)
+{
+    auto block = m_blockCache.get(_location.blockHash).first;
+    if (!block && _location.hasRanges)
+    {
+        // decode the two items only, the block is neither decoded nor cached
+        Table::Ptr tb = getMemoryTableFactory()->openTable(SYS_HASH_2_BLOCK);
+        if (!tb)
         {
-            auto entry = entries->get(0);
-            strblock = entry->getField(SYS_VALUE);
-            txIndex = entry->getField("index");
-            std::shared_ptr<Block> pblock = getBlockByNumber(lexical_cast<int64_t>(strblock));
-            assert(pblock != nullptr);
-            std::vector<Transaction> txs = pblock->transactions();
-            if (txs.size() > lexical_cast<uint>(txIndex))
-            {
-                return txs[lexical_cast<uint>(txIndex)];
-            }
+            return false;
+        }
+        auto entries = tb->select(_location.blockHash.hex(), tb->newCondition());
+        if (entries->size() == 0)
+        {
+            return false;
         }
+        std::string const& blockHex = entries->get(0)->fields()->at(SYS_VALUE);
+        size_t prefix = blockHex.compare(0, 2, "0x") == 0 ? 2 : 0;
+        if (o_tx)
+        {
+            bytes txData = fromHex(blockHex.substr(
+                prefix + 2 * _location.txRange.first, 2 * _location.txRange.second));
+            *o_tx = Transaction(ref(txData), CheckTransaction::None);
+            o_tx->forceSender(_location.from);
+        }
+        if (o_receipt)
+        {
+            bytes receiptData = fromHex(blockHex.substr(
+                prefix + 2 * _location.receiptRange.first, 2 * _location.receiptRange.second));
+            *o_receipt = TransactionReceipt(ref(receiptData));
+        }
+        return true;
+    }
+
+    if (!block)
+    {
+        block = getBlockByHash(_location.blockHash);
+    }
+    if (!block || _location.index >= block->transactions().size() ||
+        (o_receipt && _location.index >= block->transactionReceipts().size()))
+    {
+        return false;
+    }
+    if (o_tx)
+    {
+        *o_tx = block->transactions()[_location.index];
+    }
+    if (o_receipt)
+    {
+        *o_receipt = block->transactionReceipts()[_location.index];
+    }
+    return true;
+}
+
+Transaction BlockChainImp::getTxByHash(dev::h256 const& _txHash)
+{
+    TxLocation location;
+    Transaction tx;
+    if (getTxLocation(_txHash, location) && readTx(location, &tx, nullptr))
+    {
+        return tx;
     }
     BLOCKCHAIN_LOG(TRACE) << "[#getTxByHash] Can't find tx, return empty tx";
     return Transaction();
@@ -567,25 +649,11 @@ Transaction BlockChainImp::getTxByHash(dev::h256 const& _txHash)
 
 LocalisedTransaction BlockChainImp::getLocalisedTxByHash(dev::h256 const& _txHash)
 {
-    string strblockhash = "";
-    string txIndex = "";
-    Table::Ptr tb = getMemoryTableFactory()->openTable(SYS_TX_HASH_2_BLOCK, false);
-    if (tb)
+    TxLocation location;
+    Transaction tx;
+    if (getTxLocation(_txHash, location) && readTx(location, &tx, nullptr))
     {
-        auto entries = tb->select(_txHash.hex(), tb->newCondition());
-        if (entries->size() > 0)
-        {
-            auto entry = entries->get(0);
-            strblockhash = entry->getField(SYS_VALUE);
-            txIndex = entry->getField("index");
-            std::shared_ptr<Block> pblock = getBlockByNumber(lexical_cast<int64_t>(strblockhash));
-            std::vector<Transaction> txs = pblock->transactions();
-            if (txs.size() > lexical_cast<uint>(txIndex))
-            {
-                return LocalisedTransaction(txs[lexical_cast<uint>(txIndex)], pblock->headerHash(),
-                    lexical_cast<unsigned>(txIndex), pblock->blockHeader().number());
-            }
-        }
+        return LocalisedTransaction(tx, location.blockHash, location.index, location.number);
     }
     BLOCKCHAIN_LOG(TRACE) << "[#getLocalisedTxByHash] Can't find tx, return empty localised tx";
     return LocalisedTransaction(Transaction(), h256(0), -1, -1);
@@ -593,24 +661,11 @@ LocalisedTransaction BlockChainImp::getLocalisedTxByHash(dev::h256 const& _txHas
 
 TransactionReceipt BlockChainImp::getTransactionReceiptByHash(dev::h256 const& _txHash)
 {
-    string strblock = "";
-    string txIndex = "";
-    Table::Ptr tb = getMemoryTableFactory()->openTable(SYS_TX_HASH_2_BLOCK, false);
-    if (tb)
+    TxLocation location;
+    TransactionReceipt receipt;
+    if (getTxLocation(_txHash, location) && readTx(location, nullptr, &receipt))
     {
-        auto entries = tb->select(_txHash.hex(), tb->newCondition());
-        if (entries->size() > 0)
-        {
-            auto entry = entries->get(0);
-            strblock = entry->getField(SYS_VALUE);
-            txIndex = entry->getField("index");
-            std::shared_ptr<Block> pblock = getBlockByNumber(lexical_cast<int64_t>(strblock));
-            std::vector<TransactionReceipt> receipts = pblock->transactionReceipts();
-            if (receipts.size() > lexical_cast<uint>(txIndex))
-            {
-                return receipts[lexical_cast<uint>(txIndex)];
-            }
-        }
+        return receipt;
     }
     BLOCKCHAIN_LOG(TRACE)
         << "[#getTransactionReceiptByHash] Can't find tx, return empty localised tx receipt";
@@ -619,29 +674,13 @@ TransactionReceipt BlockChainImp::getTransactionReceiptByHash(dev::h256 const& _
 
 LocalisedTransactionReceipt BlockChainImp::getLocalisedTxReceiptByHash(dev::h256 const& _txHash)
 {
-    Table::Ptr tb = getMemoryTableFactory()->openTable(SYS_TX_HASH_2_BLOCK, false);
-    if (tb)
+    TxLocation location;
+    Transaction tx;
+    TransactionReceipt receipt;
+    if (getTxLocation(_txHash, location) && readTx(location, &tx, &receipt))
     {
-        auto entries = tb->select(_txHash.hex(), tb->newCondition());
-        if (entries->size() > 0)
-        {
-            auto entry = entries->get(0);
-            auto blockNum = lexical_cast<int64_t>(entry->getField(SYS_VALUE));
-            auto txIndex = lexical_cast<uint>(entry->getField("index"));
-
-            std::shared_ptr<Block> pblock = getBlockByNumber(lexical_cast<int64_t>(blockNum));
-            const Transactions& txs = pblock->transactions();
-            const TransactionReceipts& receipts = pblock->transactionReceipts();
-            if (receipts.size() > txIndex && txs.size() > txIndex)
-            {
-                auto& tx = txs[txIndex];
-                auto& receipt = receipts[txIndex];
-
-                return LocalisedTransactionReceipt(receipt, _txHash, pblock->headerHash(),
-                    pblock->header().number(), tx.from(), tx.to(), txIndex, receipt.gasUsed(),
-                    receipt.contractAddress());
-            }
-        }
+        return LocalisedTransactionReceipt(receipt, _txHash, location.blockHash, location.number,
+            tx.from(), tx.to(), location.index, receipt.gasUsed(), receipt.contractAddress());
     }
     BLOCKCHAIN_LOG(TRACE)
         << "[#getLocalisedTxReceiptByHash] Can't find tx, return empty localised tx receipt";
@@ -701,17 +740,36 @@ void BlockChainImp::writeTotalTransactionCount(
     }
 }
 
-void BlockChainImp::writeTxToBlock(const Block& block, std::shared_ptr<ExecutiveContext> context)
+void BlockChainImp::writeTxToBlock(
+    const Block& block, bytes const& _blockData, std::shared_ptr<ExecutiveContext> context)
 {
     Table::Ptr tb = context->getMemoryTableFactory()->openTable(SYS_TX_HASH_2_BLOCK, false);
     if (tb)
     {
-        std::vector<Transaction> txs = block.transactions();
+        auto const& txs = block.transactions();
+        RLP blockRLP(ref(_blockData));
+        RLP txsRLP = blockRLP[1];
+        RLP receiptsRLP = blockRLP[2];
+        // the items are located in the encoded block, a lookup decodes only them
+        bool withRanges =
+            txsRLP.itemCount() == txs.size() && receiptsRLP.itemCount() == txs.size();
+        auto txIt = txsRLP.begin();
+        auto receiptIt = receiptsRLP.begin();
+        std::string blockHash = block.blockHeader().hash().hex();
         for (uint i = 0; i < txs.size(); i++)
         {
             Entry::Ptr entry = std::make_shared<Entry>();
             entry->setField(SYS_VALUE, lexical_cast<std::string>(block.blockHeader().number()));
-            entry->setField("index", lexical_cast<std::string>(i));
+            entry->setField(SYS_TX_INDEX, lexical_cast<std::string>(i));
+            if (withRanges)
+            {
+                entry->setField(SYS_TX_BLOCK_HASH, blockHash);
+                entry->setField(SYS_TX_RANGE, rangeOf((*txIt).data(), _blockData));
+                entry->setField(SYS_TX_RECEIPT_RANGE, rangeOf((*receiptIt).data(), _blockData));
+                entry->setField(SYS_TX_FROM, txs[i].safeSender().hex());
+                ++txIt;
+                ++receiptIt;
+            }
             tb->insert(txs[i].sha3().hex(), entry);
         }
     }
@@ -736,15 +794,14 @@ void BlockChainImp::writeNumber2Hash(const Block& block, std::shared_ptr<Executi
     }
 }
 
-void BlockChainImp::writeHash2Block(Block& block, std::shared_ptr<ExecutiveContext> context)
+void BlockChainImp::writeHash2Block(
+    Block& block, bytes const& _blockData, std::shared_ptr<ExecutiveContext> context)
 {
     Table::Ptr tb = context->getMemoryTableFactory()->openTable(SYS_HASH_2_BLOCK, false);
     if (tb)
     {
         Entry::Ptr entry = std::make_shared<Entry>();
-        bytes out;
-        block.encode(out);
-        entry->setField(SYS_VALUE, toHexPrefixed(out));
+        entry->setField(SYS_VALUE, toHexPrefixed(_blockData));
         tb->insert(block.blockHeader().hash().hex(), entry);
     }
     else
@@ -753,10 +810,11 @@ void BlockChainImp::writeHash2Block(Block& block, std::shared_ptr<ExecutiveConte
     }
 }
 
-void BlockChainImp::writeBlockInfo(Block& block, std::shared_ptr<ExecutiveContext> context)
+void BlockChainImp::writeBlockInfo(
+    Block& block, bytes const& _blockData, std::shared_ptr<ExecutiveContext> context)
 {
     writeNumber2Hash(block, context);
-    writeHash2Block(block, context);
+    writeHash2Block(block, _blockData, context);
 }
 
 CommitResult BlockChainImp::commitBlock(Block& block, std::shared_ptr<ExecutiveContext> context)
@@ -783,8 +841,10 @@ CommitResult BlockChainImp::commitBlock(Block& block, std::shared_ptr<ExecutiveC
         {
             writeNumber(block, context);
             writeTotalTransactionCount(block, context);
-            writeTxToBlock(block, context);
-            writeBlockInfo(block, context);
+            bytes blockData;
+            block.encode(blockData);
+            writeTxToBlock(block, blockData, context);
+            writeBlockInfo(block, blockData, context);
             context->dbCommit(block);
             commitMutex.unlock();
             m_onReady();
@@ -24,6 +24,7 @@
 
 #include "BlockChainInterface.h"
 #include <libdevcore/Exceptions.h>
+#include <libdevcore/LRUCache.h>
 #include <libethcore/Block.h>
 #include <libethcore/Common.h>
 #include <libethcore/Transaction.h>
@@ -57,19 +58,31 @@ namespace blockchain
 {
 class BlockChainImp;
 
+/// decoded blocks by hash, bounded by an estimate of their decoded size rather than a block count
 class BlockCache
 {
 public:
-    BlockCache(){};
+    BlockCache() : m_blockCache(c_defaultCapacity, [](CachedBlock const& _block) {
+        return _block.size;
+    })
+    {}
     std::shared_ptr<dev::eth::Block> add(dev::eth::Block& _block);
     std::pair<std::shared_ptr<dev::eth::Block>, dev::h256> get(h256 const& _hash);
+    void setCapacity(size_t _capacity) { m_blockCache.setCapacity(_capacity); }
+
+    uint64_t hits() const { return m_blockCache.hits(); }
+    uint64_t misses() const { return m_blockCache.misses(); }
+    /// estimated bytes of the cached blocks
+    size_t size() const { return m_blockCache.cost(); }
 
 private:
-    mutable boost::shared_mutex m_sharedMutex;
-    mutable std::map<dev::h256, std::pair<std::shared_ptr<dev::eth::Block>, dev::h256> >
-        m_blockCache;
-    mutable std::deque<dev::h256> m_blockCacheFIFO;  // insert queue log for m_blockCache
-    const unsigned c_blockCacheSize = 10;            // m_blockCache size, default set 10
+    struct CachedBlock
+    {
+        std::shared_ptr<dev::eth::Block> block;
+        size_t size;
+    };
+    static const size_t c_defaultCapacity = 32 * 1024 * 1024;
+    LRUCache<dev::h256, CachedBlock> m_blockCache;
 };
 DEV_SIMPLE_EXCEPTION(OpenSysTableFailed);
 
@@ -95,26 +108,47 @@ public:
     bool checkAndBuildGenesisBlock(GenesisBlockParam& initParam) override;
     virtual std::pair<int64_t, int64_t> totalTransactionCount() override;
     dev::bytes getCode(dev::Address _address) override;
+    /// bytes of decoded blocks kept in memory
+    void setBlockCacheCapacity(size_t _capacity) { m_blockCache.setCapacity(_capacity); }
 
     dev::h512s minerList() override;
     dev::h512s observerList() override;
     std::string getSystemConfigByKey(std::string const& key, int64_t num = -1) override;
 
 private:
+    /// where a committed transaction is, read from _sys_tx_hash_2_block_
+    struct TxLocation
+    {
+        int64_t number = -1;
+        unsigned index = 0;
+        dev::h256 blockHash;
+        /// the ranges are missing from the entries written by older nodes
+        bool hasRanges = false;
+        /// offset and size of the transaction and its receipt in the encoded block
+        std::pair<size_t, size_t> txRange;
+        std::pair<size_t, size_t> receiptRange;
+        dev::Address from;
+    };
+    bool getTxLocation(dev::h256 const& _txHash, TxLocation& o_location);
+    /// reads the transaction and the receipt at _location, without decoding the whole block
+    /// when it is not cached
+    bool readTx(TxLocation const& _location, dev::eth::Transaction* o_tx,
+        dev::eth::TransactionReceipt* o_receipt);
+
     std::shared_ptr<dev::eth::Block> getBlock(int64_t _i);
     std::shared_ptr<dev::eth::Block> getBlock(dev::h256 const& _blockHash);
     void writeNumber(const dev::eth::Block& block,
         std::shared_ptr<dev::blockverifier::ExecutiveContext> context);
     void writeTotalTransactionCount(const dev::eth::Block& block,
         std::shared_ptr<dev::blockverifier::ExecutiveContext> context);
-    void writeTxToBlock(const dev::eth::Block& block,
+    void writeTxToBlock(const dev::eth::Block& block, dev::bytes const& _blockData,
+        std::shared_ptr<dev::blockverifier::ExecutiveContext> context);
+    void writeBlockInfo(dev::eth::Block& block, dev::bytes const& _blockData,
         std::shared_ptr<dev::blockverifier::ExecutiveContext> context);
-    void writeBlockInfo(
-        dev::eth::Block& block, std::shared_ptr<dev::blockverifier::ExecutiveContext> context);
     void writeNumber2Hash(const dev::eth::Block& block,
         std::shared_ptr<dev::blockverifier::ExecutiveContext> context);
-    void writeHash2Block(
-        dev::eth::Block& block, std::shared_ptr<dev::blockverifier::ExecutiveContext> context);
+    void writeHash2Block(dev::eth::Block& block, dev::bytes const& _blockData,
+        std::shared_ptr<dev::blockverifier::ExecutiveContext> context);
     dev::storage::Storage::Ptr m_stateStorage;
     std::mutex commitMutex;
     const std::string c_genesisHash =
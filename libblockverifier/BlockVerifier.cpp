@@ -118,6 +118,9 @@ std::pair<ExecutionResult, TransactionReceipt> BlockVerifier::execute(EnvInfo co
     Executive e(executiveContext->getState(), _envInfo);
     ExecutionResult res;
     e.setResultRecipient(res);
+    // tables/entries/conditions handed out during this transaction are unreachable once it ends,
+    // also when initialize or go throws
+    ScopeGuard releaseTemporary([&]() { executiveContext->releaseTemporaryPrecompiled(); });
     e.initialize(_t);
 
     // OK - transaction looks valid - execute.
@@ -66,11 +66,29 @@ bytes ExecutiveContext::call(Address const& origin, Address address, bytesConstR
 
 Address ExecutiveContext::registerPrecompiled(Precompiled::Ptr p)
 {
-    Address address(++m_addressCount);
+    // addresses keep increasing for the whole block, so an address from a finished
+    // transaction never resolves to a temporary of a later one
+    m_temporaryPrecompiled.push_back(p);
+    return Address(++m_addressCount);
+}
 
-    m_address2Precompiled.insert(std::make_pair(address, p));
+void ExecutiveContext::rollbackTemporaryPrecompiled(size_t _savepoint)
+{
+    if (!m_releaseTemporaryPrecompiled)
+        return;
+    // keep the slots so later addresses still map to their index
+    for (size_t i = _savepoint; i < m_temporaryPrecompiled.size(); ++i)
+    {
+        m_temporaryPrecompiled[i].reset();
+    }
+}
 
-    return address;
+void ExecutiveContext::releaseTemporaryPrecompiled()
+{
+    if (!m_releaseTemporaryPrecompiled)
+        return;
+    m_temporaryPrecompiled.clear();
+    m_temporaryBase = m_addressCount + 1;
 }
 
 
@@ -100,6 +118,21 @@ Precompiled::Ptr ExecutiveContext::getPrecompiled(Address address) const
         return itPrecompiled->second;
     }
 
+    u160 value = address;
+    if (value >= m_temporaryBase && value <= m_addressCount)
+    {
+        return m_temporaryPrecompiled[static_cast<size_t>(value - m_temporaryBase)];
+    }
+
+    if (m_systemPrecompiled)
+    {
+        auto itSystem = m_systemPrecompiled->find(address);
+        if (itSystem != m_systemPrecompiled->end())
+        {
+            return itSystem->second;
+        }
+    }
+
     return Precompiled::Ptr();
 }
 
@@ -122,19 +155,19 @@ void ExecutiveContext::setState(std::shared_ptr<dev::executive::StateFace> state
 
 bool ExecutiveContext::isOrginPrecompiled(Address const& _a) const
 {
-    return m_precompiledContract.count(_a);
+    return m_precompiledContract && m_precompiledContract->count(_a);
 }
 
 std::pair<bool, bytes> ExecutiveContext::executeOrginPrecompiled(
     Address const& _a, bytesConstRef _in) const
 {
-    return m_precompiledContract.at(_a).execute(_in);
+    return m_precompiledContract->at(_a).execute(_in);
 }
 
 void ExecutiveContext::setPrecompiledContract(
     std::unordered_map<Address, PrecompiledContract> const& precompiledContract)
 {
-    m_precompiledContract = precompiledContract;
+    m_precompiledContract = std::make_shared<const PrecompiledContractMap>(precompiledContract);
 }
 
 void ExecutiveContext::dbCommit(Block& block)
@@ -50,6 +50,9 @@ class ExecutiveContext : public std::enable_shared_from_this<ExecutiveContext>
 {
 public:
     typedef std::shared_ptr<ExecutiveContext> Ptr;
+    /// immutable address => precompiled registry shared by all contexts of a factory
+    typedef std::unordered_map<Address, Precompiled::Ptr> PrecompiledRegistry;
+    typedef std::unordered_map<Address, dev::eth::PrecompiledContract> PrecompiledContractMap;
 
     ExecutiveContext(){};
 
@@ -57,8 +60,20 @@ public:
 
     virtual bytes call(Address const& origin, Address address, bytesConstRef param);
 
+    /// register a transaction-scoped precompiled (table, entry, condition ...) and return the
+    /// address handed to the contract; it lives until releaseTemporaryPrecompiled
     virtual Address registerPrecompiled(Precompiled::Ptr p);
 
+    size_t temporaryPrecompiledSavepoint() const { return m_temporaryPrecompiled.size(); }
+    /// drop the temporaries registered after _savepoint (the call frame reverted)
+    void rollbackTemporaryPrecompiled(size_t _savepoint);
+    /// drop all temporaries at the end of a transaction, keeping the slot capacity
+    void releaseTemporaryPrecompiled();
+    /// an address released by rollback/release no longer resolves, which changes the result of
+    /// a later transaction using it, so it is off (temporaries live for the block) unless the
+    /// group enables tx.releaseTemporaryPrecompiled in its genesis
+    void setReleaseTemporaryPrecompiled(bool _release) { m_releaseTemporaryPrecompiled = _release; }
+
     virtual bool isPrecompiled(Address address) const;
 
     Precompiled::Ptr getPrecompiled(Address address) const;
@@ -68,6 +83,12 @@ public:
         m_address2Precompiled.insert(std::make_pair(address, precompiled));
     }
 
+    /// set the shared system precompiled registry, consulted after the per-context ones
+    void setSystemPrecompiled(std::shared_ptr<const PrecompiledRegistry> _systemPrecompiled)
+    {
+        m_systemPrecompiled = _systemPrecompiled;
+    }
+
     BlockInfo blockInfo() { return m_blockInfo; }
     void setBlockInfo(BlockInfo blockInfo) { m_blockInfo = blockInfo; }
 
@@ -85,6 +106,12 @@ public:
     void setPrecompiledContract(
         std::unordered_map<Address, dev::eth::PrecompiledContract> const& precompiledContract);
 
+    /// share the ethereum precompiled contracts with the factory instead of copying them
+    void setPrecompiledContract(std::shared_ptr<const PrecompiledContractMap> precompiledContract)
+    {
+        m_precompiledContract = precompiledContract;
+    }
+
     void dbCommit(dev::eth::Block& block);
 
     void setMemoryTableFactory(std::shared_ptr<dev::storage::MemoryTableFactory> memoryTableFactory)
@@ -102,10 +129,15 @@ public:
 
 private:
     std::unordered_map<Address, Precompiled::Ptr> m_address2Precompiled;
+    std::shared_ptr<const PrecompiledRegistry> m_systemPrecompiled;
+    /// handle table of temporaries, m_temporaryPrecompiled[i] lives at m_temporaryBase + i
+    std::vector<Precompiled::Ptr> m_temporaryPrecompiled;
     int m_addressCount = 0x10000;
+    int m_temporaryBase = 0x10001;
+    bool m_releaseTemporaryPrecompiled = false;
     BlockInfo m_blockInfo;
     std::shared_ptr<dev::executive::StateFace> m_stateFace;
-    std::unordered_map<Address, dev::eth::PrecompiledContract> m_precompiledContract;
+    std::shared_ptr<const PrecompiledContractMap> m_precompiledContract;
     std::shared_ptr<dev::storage::MemoryTableFactory> m_memoryTableFactory;
     uint64_t m_txGasLimit = 300000000;
 };
@@ -32,6 +32,39 @@ using namespace dev;
 using namespace dev::blockverifier;
 using namespace dev::executive;
 
+ExecutiveContextFactory::ExecutiveContextFactory()
+{
+    auto precompiledContract = std::make_shared<ExecutiveContext::PrecompiledContractMap>();
+    precompiledContract->insert(std::make_pair(
+        dev::Address(1), dev::eth::PrecompiledContract(
+                             3000, 0, dev::eth::PrecompiledRegistrar::executor("ecrecover"))));
+    precompiledContract->insert(std::make_pair(
+        dev::Address(2), dev::eth::PrecompiledContract(
+                             60, 12, dev::eth::PrecompiledRegistrar::executor("sha256"))));
+    precompiledContract->insert(std::make_pair(
+        dev::Address(3), dev::eth::PrecompiledContract(
+                             600, 120, dev::eth::PrecompiledRegistrar::executor("ripemd160"))));
+    precompiledContract->insert(std::make_pair(
+        dev::Address(4), dev::eth::PrecompiledContract(
+                             15, 3, dev::eth::PrecompiledRegistrar::executor("identity"))));
+    m_precompiledContract = precompiledContract;
+
+    // these precompiled contracts keep no per-block state (tables are opened through the
+    // context), so one instance of each serves every context
+    auto systemPrecompiled = std::make_shared<ExecutiveContext::PrecompiledRegistry>();
+    systemPrecompiled->insert(std::make_pair(
+        Address(0x1000), std::make_shared<dev::blockverifier::SystemConfigPrecompiled>()));
+    systemPrecompiled->insert(
+        std::make_pair(Address(0x1002), std::make_shared<dev::blockverifier::CRUDPrecompiled>()));
+    systemPrecompiled->insert(std::make_pair(
+        Address(0x1003), std::make_shared<dev::blockverifier::ConsensusPrecompiled>()));
+    systemPrecompiled->insert(
+        std::make_pair(Address(0x1004), std::make_shared<dev::blockverifier::CNSPrecompiled>()));
+    systemPrecompiled->insert(std::make_pair(
+        Address(0x1005), std::make_shared<dev::blockverifier::AuthorityPrecompiled>()));
+    m_systemPrecompiled = systemPrecompiled;
+}
+
 void ExecutiveContextFactory::initExecutiveContext(
     BlockInfo blockInfo, h256 stateRoot, ExecutiveContext::Ptr context)
 {
@@ -42,21 +75,14 @@ void ExecutiveContextFactory::initExecutiveContext(
     memoryTableFactory->setBlockHash(blockInfo.hash);
     memoryTableFactory->setBlockNum(blockInfo.number);
 
+    // TableFactoryPrecompiled holds the per-block MemoryTableFactory, so it stays per context
     auto tableFactoryPrecompiled = std::make_shared<dev::blockverifier::TableFactoryPrecompiled>();
     tableFactoryPrecompiled->setMemoryTableFactory(memoryTableFactory);
 
-    context->setAddress2Precompiled(
-        Address(0x1000), std::make_shared<dev::blockverifier::SystemConfigPrecompiled>());
     context->setAddress2Precompiled(Address(0x1001), tableFactoryPrecompiled);
-    context->setAddress2Precompiled(
-        Address(0x1002), std::make_shared<dev::blockverifier::CRUDPrecompiled>());
-    context->setAddress2Precompiled(
-        Address(0x1003), std::make_shared<dev::blockverifier::ConsensusPrecompiled>());
-    context->setAddress2Precompiled(
-        Address(0x1004), std::make_shared<dev::blockverifier::CNSPrecompiled>());
-    context->setAddress2Precompiled(
-        Address(0x1005), std::make_shared<dev::blockverifier::AuthorityPrecompiled>());
+    context->setSystemPrecompiled(m_systemPrecompiled);
     context->setMemoryTableFactory(memoryTableFactory);
+    context->setReleaseTemporaryPrecompiled(m_releaseTemporaryPrecompiled);
 
     context->setBlockInfo(blockInfo);
     context->setPrecompiledContract(m_precompiledContract);
@@ -77,11 +103,17 @@ void ExecutiveContextFactory::setStateFactory(
 
 void ExecutiveContextFactory::setTxGasLimitToContext(ExecutiveContext::Ptr context)
 {
+    BlockInfo blockInfo = context->blockInfo();
+    uint64_t txGasLimit = 0;
+    if (getCachedTxGasLimit(blockInfo.hash, txGasLimit))
+    {
+        context->setTxGasLimit(txGasLimit);
+        return;
+    }
     // get value from db
     try
     {
         std::string key = "tx_gas_limit";
-        BlockInfo blockInfo = context->blockInfo();
         std::string ret;
 
         auto values =
@@ -107,6 +139,7 @@ void ExecutiveContextFactory::setTxGasLimitToContext(ExecutiveContext::Ptr conte
         if (ret != "")
         {
             context->setTxGasLimit(boost::lexical_cast<uint64_t>(ret));
+            cacheTxGasLimit(blockInfo.hash, context->txGasLimit());
             EXECUTIVECONTEXT_LOG(TRACE)
                 << "[#setTxGasLimitToContext] tx_gas_limit:" << context->txGasLimit();
         }
@@ -121,3 +154,27 @@ void ExecutiveContextFactory::setTxGasLimitToContext(ExecutiveContext::Ptr conte
             << "[#setTxGasLimitToContext] failed [EINFO]: " << boost::diagnostic_information(e);
     }
 }
+
+bool ExecutiveContextFactory::getCachedTxGasLimit(
+    h256 const& _blockHash, uint64_t& _txGasLimit) const
+{
+    Guard l(x_txGasLimitCache);
+    auto it = m_txGasLimitCache.find(_blockHash);
+    if (it == m_txGasLimitCache.end())
+    {
+        return false;
+    }
+    _txGasLimit = it->second;
+    return true;
+}
+
+void ExecutiveContextFactory::cacheTxGasLimit(h256 const& _blockHash, uint64_t _txGasLimit)
+{
+    Guard l(x_txGasLimitCache);
+    // only the latest few blocks are queried in practice, so a full reset is enough
+    if (m_txGasLimitCache.size() >= c_txGasLimitCacheSize)
+    {
+        m_txGasLimitCache.clear();
+    }
+    m_txGasLimitCache[_blockHash] = _txGasLimit;
+}
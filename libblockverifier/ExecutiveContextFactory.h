@@ -21,6 +21,7 @@
 #pragma once
 
 #include "ExecutiveContext.h"
+#include <libdevcore/Guards.h>
 #include <libdevcore/OverlayDB.h>
 #include <libexecutive/StateFactoryInterface.h>
 #include <libstorage/Storage.h>
@@ -32,21 +33,7 @@ class ExecutiveContextFactory : public std::enable_shared_from_this<ExecutiveCon
 {
 public:
     typedef std::shared_ptr<ExecutiveContextFactory> Ptr;
-    ExecutiveContextFactory()
-    {
-        m_precompiledContract.insert(std::make_pair(
-            dev::Address(1), dev::eth::PrecompiledContract(
-                                 3000, 0, dev::eth::PrecompiledRegistrar::executor("ecrecover"))));
-        m_precompiledContract.insert(std::make_pair(
-            dev::Address(2), dev::eth::PrecompiledContract(
-                                 60, 12, dev::eth::PrecompiledRegistrar::executor("sha256"))));
-        m_precompiledContract.insert(std::make_pair(
-            dev::Address(3), dev::eth::PrecompiledContract(
-                                 600, 120, dev::eth::PrecompiledRegistrar::executor("ripemd160"))));
-        m_precompiledContract.insert(std::make_pair(
-            dev::Address(4), dev::eth::PrecompiledContract(
-                                 15, 3, dev::eth::PrecompiledRegistrar::executor("identity"))));
-    };
+    ExecutiveContextFactory();
     virtual ~ExecutiveContextFactory(){};
 
     virtual void initExecutiveContext(
@@ -57,12 +44,26 @@ public:
     virtual void setStateFactory(
         std::shared_ptr<dev::executive::StateFactoryInterface> stateFactoryInterface);
 
+    /// see ExecutiveContext::setReleaseTemporaryPrecompiled
+    void setReleaseTemporaryPrecompiled(bool _release) { m_releaseTemporaryPrecompiled = _release; }
+
 private:
     dev::storage::Storage::Ptr m_stateStorage;
     std::shared_ptr<dev::executive::StateFactoryInterface> m_stateFactoryInterface;
-    std::unordered_map<Address, dev::eth::PrecompiledContract> m_precompiledContract;
+    /// ethereum precompiled contracts, shared (read-only) by all contexts
+    std::shared_ptr<const ExecutiveContext::PrecompiledContractMap> m_precompiledContract;
+    /// stateless system precompiled contracts, built once and shared by all contexts
+    std::shared_ptr<const ExecutiveContext::PrecompiledRegistry> m_systemPrecompiled;
+    bool m_releaseTemporaryPrecompiled = false;
+
+    /// tx_gas_limit of committed blocks, keyed by block hash (committed state never changes)
+    std::unordered_map<h256, uint64_t> m_txGasLimitCache;
+    mutable Mutex x_txGasLimitCache;
+    static const size_t c_txGasLimitCacheSize = 64;
 
     void setTxGasLimitToContext(ExecutiveContext::Ptr context);
+    bool getCachedTxGasLimit(h256 const& _blockHash, uint64_t& _txGasLimit) const;
+    void cacheTxGasLimit(h256 const& _blockHash, uint64_t _txGasLimit);
 };
 
 }  // namespace blockverifier
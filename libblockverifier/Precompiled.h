@@ -66,6 +66,8 @@ public:
     virtual bytesConstRef getParamData(bytesConstRef param) { return param.cropped(4); }
 
 protected:
+    /// filled by the constructor, call() looks it up with at(): the system precompiled
+    /// contracts are shared by the contexts executing in parallel and operator[] may insert
     std::unordered_map<std::string, uint32_t> name2Selector;
     virtual dev::storage::AccessOptions::Ptr getOptions(Address const& origin)
     {
@@ -48,7 +48,11 @@ public:
 
     virtual void encode(bytes& buffer)
     {
-        uint32_t lengthN = htonl(HEADER_LENGTH + _data->size());
+        // the whole payload, data() of a TopicChannelMessage skips the topic
+        const byte* payload = _chunk ? _view : _data->data();
+        size_t payloadSize = _chunk ? _viewSize : _data->size();
+
+        uint32_t lengthN = htonl(HEADER_LENGTH + payloadSize);
         uint16_t typeN = htons(_type);
         int32_t resultN = htonl(_result);
 
@@ -57,12 +61,40 @@ public:
         buffer.insert(buffer.end(), _seq.data(), _seq.data() + _seq.size());
         buffer.insert(buffer.end(), (byte*)&resultN, (byte*)&resultN + sizeof(resultN));
 
-        buffer.insert(buffer.end(), _data->begin(), _data->end());
+        buffer.insert(buffer.end(), payload, payload + payloadSize);
     }
 
     virtual ssize_t decode(const byte* buffer, size_t size) { return decodeAMOP(buffer, size); }
 
+    virtual ssize_t decodeInPlace(
+        std::shared_ptr<bytes> const& chunk, size_t offset, size_t size) override
+    {
+        ssize_t result = decodeHeader(chunk->data() + offset, size);
+        if (result > 0)
+        {
+            _data->clear();
+            _chunk = chunk;
+            _view = chunk->data() + offset + HEADER_LENGTH;
+            _viewSize = _length - HEADER_LENGTH;
+        }
+        return result;
+    }
+
     virtual ssize_t decodeAMOP(const byte* buffer, size_t size)
+    {
+        ssize_t result = decodeHeader(buffer, size);
+        if (result > 0)
+        {
+            clearView();
+            _data->assign(
+                &buffer[HEADER_LENGTH], &buffer[HEADER_LENGTH] + _length - HEADER_LENGTH);
+        }
+        return result;
+    }
+
+protected:
+    /// the length of the frame, 0 if it is incomplete and -1 if it is too long
+    ssize_t decodeHeader(const byte* buffer, size_t size)
     {
         if (size < HEADER_LENGTH)
         {
@@ -71,7 +103,7 @@ public:
 
         _length = ntohl(*((uint32_t*)&buffer[0]));
 
-        if (_length > MAX_LENGTH)
+        if (_length > MAX_LENGTH || _length < HEADER_LENGTH)
         {
             return -1;
         }
@@ -85,12 +117,9 @@ public:
         _seq.assign(&buffer[6], &buffer[6] + 32);
         _result = ntohl(*((uint32_t*)&buffer[38]));
 
-        _data->assign(&buffer[HEADER_LENGTH], &buffer[HEADER_LENGTH] + _length - HEADER_LENGTH);
-
         return _length;
     }
 
-protected:
     const static size_t MIN_HEADER_LENGTH = 4;
 
     const static size_t HEADER_LENGTH = 4 + 2 + 32 + 4;
@@ -123,6 +152,13 @@ public:
 
     virtual ~TopicChannelMessage() {}
 
+    /// the topic accessors work on _data
+    virtual ssize_t decodeInPlace(
+        std::shared_ptr<bytes> const& chunk, size_t offset, size_t size) override
+    {
+        return decode(chunk->data() + offset, size);
+    }
+
     virtual std::string topic()
     {
         if (!(_type == 0x30 || _type == 0x31))
@@ -167,13 +167,17 @@ bool ChannelRPCServer::SendResponse(const std::string& _response, void* _addInfo
 
 void dev::ChannelRPCServer::removeSession(int sessionID)
 {
-    std::lock_guard<std::mutex> lock(_sessionMutex);
-    auto it = _sessions.find(sessionID);
-
-    if (it != _sessions.end())
     {
-        _sessions.erase(it);
+        std::lock_guard<std::mutex> lock(_sessionMutex);
+        auto it = _sessions.find(sessionID);
+
+        if (it != _sessions.end())
+        {
+            _sessions.erase(it);
+        }
     }
+
+    updateHostTopics();
 }
 
 void ChannelRPCServer::onConnect(
@@ -235,6 +239,11 @@ void ChannelRPCServer::onDisconnect(
         }
     }
 
+    if (m_subscriptions)
+    {
+        m_subscriptions->removeSession(session);
+    }
+
     updateHostTopics();
 }
 
@@ -243,8 +252,8 @@ void dev::ChannelRPCServer::onClientRequest(dev::channel::ChannelSession::Ptr se
 {
     if (e.errorCode() == 0)
     {
-        CHANNEL_LOG(INFO) << "receive sdk message length:" << message->length()
-                          << " type:" << message->type() << " sessionID:" << message->seq();
+        CHANNEL_LOG(TRACE) << "receive sdk message length:" << message->length()
+                           << " type:" << message->type() << " sessionID:" << message->seq();
 
         switch (message->type())
         {
@@ -270,6 +279,10 @@ void dev::ChannelRPCServer::onClientRequest(dev::channel::ChannelSession::Ptr se
         case 0x32:
             onClientTopicRequest(session, message);
             break;
+        case 0x40:
+        case 0x41:
+            onClientSubscribeRequest(session, message);
+            break;
         default:
             CHANNEL_LOG(ERROR) << "unknown client message: " << message->type();
             break;
@@ -288,10 +301,11 @@ void dev::ChannelRPCServer::onClientEthereumRequest(
 {
     // CHANNEL_LOG(DEBUG) << "receive client ethereum request";
 
+    // the only copy of the payload, OnRequest takes a string
     std::string body(message->data(), message->data() + message->dataSize());
 
-    CHANNEL_LOG(DEBUG) << "client ethereum request seq:" << message->seq() << "  ethereum request:"
-                       << std::string((char*)message->data(), message->dataSize());
+    CHANNEL_LOG(TRACE) << "client ethereum request seq:" << message->seq()
+                       << " length:" << body.size();
 
     {
         std::lock_guard<std::mutex> lock(_seqMutex);
@@ -452,6 +466,58 @@ void dev::ChannelRPCServer::onClientTopicRequest(
     }
 }
 
+void dev::ChannelRPCServer::onClientSubscribeRequest(
+    dev::channel::ChannelSession::Ptr session, dev::channel::Message::Ptr message)
+{
+    std::string body(message->data(), message->data() + message->dataSize());
+
+    CHANNEL_LOG(DEBUG) << "SDK subscribe request seq:" << message->seq()
+                       << " type:" << message->type() << " request:" << body;
+
+    Json::Value response;
+    try
+    {
+        if (!m_subscriptions)
+        {
+            BOOST_THROW_EXCEPTION(
+                dev::channel::ChannelException(-1, "subscriptions are not enabled"));
+        }
+
+        Json::Value request;
+        if (!Json::Reader().parse(body, request) || !request.isObject())
+        {
+            BOOST_THROW_EXCEPTION(dev::channel::ChannelException(-1, "invalid request"));
+        }
+
+        if (message->type() == 0x40)
+        {
+            response["filterID"] = m_subscriptions->subscribe(session, request);
+        }
+        else
+        {
+            std::string filterID = request["filterID"].asString();
+            if (!m_subscriptions->unsubscribe(session, filterID))
+            {
+                BOOST_THROW_EXCEPTION(
+                    dev::channel::ChannelException(-1, "unknown filter: " + filterID));
+            }
+            response["filterID"] = filterID;
+        }
+        message->setResult(0);
+    }
+    catch (dev::channel::ChannelException& e)
+    {
+        CHANNEL_LOG(WARNING) << "subscribe request failed: " << e.what();
+
+        response["error"] = e.what();
+        message->setResult(e.errorCode());
+    }
+
+    std::string data = Json::FastWriter().write(response);
+    message->setData((const byte*)data.data(), data.size());
+    session->asyncSendMessage(message, dev::channel::ChannelSession::CallbackType(), 0);
+}
+
 void dev::ChannelRPCServer::onClientChannelRequest(
     dev::channel::ChannelSession::Ptr session, dev::channel::Message::Ptr message)
 {
@@ -742,15 +808,25 @@ std::string ChannelRPCServer::newSeq()
 
 void ChannelRPCServer::updateHostTopics()
 {
+    auto topicSessions = std::make_shared<TopicSessions>();
     auto allTopics = std::make_shared<std::vector<std::string> >();
 
     std::lock_guard<std::mutex> lock(_sessionMutex);
     for (auto it : _sessions)
     {
         auto topics = it.second->topics();
-        allTopics->insert(allTopics->end(), topics->begin(), topics->end());
+        for (auto const& topic : *topics)
+        {
+            (*topicSessions)[topic].push_back(it.second);
+        }
+    }
+    allTopics->reserve(topicSessions->size());
+    for (auto const& it : *topicSessions)
+    {
+        allTopics->push_back(it.first);
     }
 
+    std::atomic_store(&m_topicSessions, std::shared_ptr<const TopicSessions>(topicSessions));
     m_service->setTopics(allTopics);
 }
 
@@ -759,18 +835,19 @@ std::vector<dev::channel::ChannelSession::Ptr> ChannelRPCServer::getSessionByTop
 {
     std::vector<dev::channel::ChannelSession::Ptr> activedSessions;
 
-    std::lock_guard<std::mutex> lock(_sessionMutex);
-    for (auto it : _sessions)
+    auto topicSessions = std::atomic_load(&m_topicSessions);
+    auto it = topicSessions->find(topic);
+    if (it == topicSessions->end())
     {
-        if (it.second->topics()->empty() || !it.second->actived())
-        {
-            continue;
-        }
+        return activedSessions;
+    }
 
-        auto topicIt = it.second->topics()->find(topic);
-        if (topicIt != it.second->topics()->end())
+    activedSessions.reserve(it->second.size());
+    for (auto const& session : it->second)
+    {
+        if (session->actived())
         {
-            activedSessions.push_back(it.second);
+            activedSessions.push_back(session);
         }
     }
 
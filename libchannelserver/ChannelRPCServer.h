@@ -30,6 +30,7 @@
 #include "ChannelMessage.h"
 #include "ChannelServer.h"
 #include "ChannelSession.h"
+#include "ChannelSubscriptions.h"
 #include "libdevcore/ThreadPool.h"
 #include <jsonrpccpp/server/abstractserverconnector.h>
 #include <libdevcore/FixedHash.h>
@@ -42,6 +43,7 @@
 #include <queue>
 #include <string>
 #include <thread>
+#include <unordered_map>
 
 namespace dev
 {
@@ -91,6 +93,10 @@ public:
     virtual void onClientChannelRequest(
         dev::channel::ChannelSession::Ptr session, dev::channel::Message::Ptr message);
 
+    /// 0x40 subscribe and 0x41 unsubscribe, answered on the seq of the request
+    virtual void onClientSubscribeRequest(
+        dev::channel::ChannelSession::Ptr session, dev::channel::Message::Ptr message);
+
     void setListenAddr(const std::string& listenAddr);
 
     void setListenPort(int listenPort);
@@ -108,6 +114,11 @@ public:
 
     void setChannelServer(std::shared_ptr<dev::channel::ChannelServer> server);
 
+    void setSubscriptions(dev::channel::ChannelSubscriptions::Ptr subscriptions)
+    {
+        m_subscriptions = subscriptions;
+    }
+
     void asyncPushChannelMessage(std::string topic, dev::channel::Message::Ptr message,
         std::function<void(dev::channel::ChannelException, dev::channel::Message::Ptr)> callback);
 
@@ -116,17 +127,23 @@ public:
 
     virtual std::string newSeq();
 
+    /// the active sessions following topic, read from the index without locking the sessions
+    std::vector<dev::channel::ChannelSession::Ptr> getSessionByTopic(const std::string& topic);
+
 private:
+    typedef std::unordered_map<std::string, std::vector<dev::channel::ChannelSession::Ptr> >
+        TopicSessions;
+
     void initSSLContext();
 
     dev::channel::ChannelSession::Ptr sendChannelMessageToSession(std::string topic,
         dev::channel::Message::Ptr message,
         const std::set<dev::channel::ChannelSession::Ptr>& exclude);
 
+    /// rebuilds the topic index and the topics announced to the nodes, called when the topics
+    /// of a session change and when a session is removed
     void updateHostTopics();
 
-    std::vector<dev::channel::ChannelSession::Ptr> getSessionByTopic(const std::string& topic);
-
     bool _running = false;
 
     std::string _listenAddr;
@@ -139,12 +156,17 @@ private:
     std::map<int, dev::channel::ChannelSession::Ptr> _sessions;
     std::mutex _sessionMutex;
 
+    /// the sessions of every topic, replaced as a whole by updateHostTopics and read with
+    /// std::atomic_load, so routing an AMOP message does not scan the sessions
+    std::shared_ptr<const TopicSessions> m_topicSessions = std::make_shared<TopicSessions>();
+
     std::map<std::string, dev::channel::ChannelSession::Ptr> _seq2session;
     std::mutex _seqMutex;
 
     int _sessionCount = 1;
 
     std::shared_ptr<dev::p2p::P2PInterface> m_service;
+    dev::channel::ChannelSubscriptions::Ptr m_subscriptions;
 };
 
 }  // namespace dev
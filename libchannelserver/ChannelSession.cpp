@@ -169,10 +169,17 @@ void ChannelSession::startRead()
         {
             std::lock_guard<std::recursive_mutex> lock(_mutex);
 
+            if (!_recvChunk)
+            {
+                _recvChunk = std::make_shared<bytes>(bufferLength);
+            }
+            auto buffer = boost::asio::buffer(
+                _recvChunk->data() + _recvSize, _recvChunk->size() - _recvSize);
+
             auto session = shared_from_this();
             if (_enableSSL)
             {
-                _sslSocket->async_read_some(boost::asio::buffer(_recvBuffer, bufferLength),
+                _sslSocket->async_read_some(buffer,
                     [session](const boost::system::error_code& error, size_t bytesTransferred) {
                         auto s = session;
                         if (s)
@@ -183,8 +190,7 @@ void ChannelSession::startRead()
             }
             else
             {
-                _sslSocket->next_layer().async_read_some(
-                    boost::asio::buffer(_recvBuffer, bufferLength),
+                _sslSocket->next_layer().async_read_some(buffer,
                     [session](const boost::system::error_code& error, size_t bytesTransferred) {
                         auto s = session;
                         if (s)
@@ -223,40 +229,64 @@ void ChannelSession::onRead(const boost::system::error_code& error, size_t bytes
         {
             CHANNEL_LOG(TRACE) << "Read: " << bytesTransferred;
 
-            _recvProtocolBuffer.insert(
-                _recvProtocolBuffer.end(), _recvBuffer, _recvBuffer + bytesTransferred);
+            _recvSize += bytesTransferred;
 
+            // every complete frame of the chunk is decoded in place and dispatched at once
+            std::vector<Message::Ptr> messages;
+            size_t offset = 0;
             while (true)
             {
                 auto message = _messageFactory->buildMessage();
 
-                ssize_t result =
-                    message->decode(_recvProtocolBuffer.data(), _recvProtocolBuffer.size());
+                ssize_t result = message->decodeInPlace(_recvChunk, offset, _recvSize - offset);
 
                 if (result > 0)
                 {
-                    // CHANNEL_LOG(TRACE) << "Decode success: " << result;
-
-                    onMessage(ChannelException(0, ""), message);
-
-                    _recvProtocolBuffer.erase(
-                        _recvProtocolBuffer.begin(), _recvProtocolBuffer.begin() + result);
+                    messages.push_back(message);
+                    offset += result;
                 }
                 else if (result == 0)
                 {
-                    startRead();
-
                     break;
                 }
-                else if (result < 0)
+                else
                 {
                     CHANNEL_LOG(ERROR) << "Protocol parser error: " << result;
 
                     disconnect(ChannelException(-1, "Protocol parser error, disconnect"));
 
-                    break;
+                    return;
                 }
             }
+
+            if (!messages.empty())
+            {
+                onMessages(messages);
+                messages.clear();
+            }
+
+            size_t left = _recvSize - offset;
+            if (offset > 0 && (_recvChunk.use_count() > 1 || _recvChunk->size() > bufferLength))
+            {
+                // the chunk is viewed by the dispatched messages or was grown for a large frame
+                auto chunk = std::make_shared<bytes>(std::max(bufferLength, left * 2));
+                std::copy(_recvChunk->begin() + offset, _recvChunk->begin() + _recvSize,
+                    chunk->begin());
+                _recvChunk = chunk;
+            }
+            else if (offset > 0)
+            {
+                std::copy(_recvChunk->begin() + offset, _recvChunk->begin() + _recvSize,
+                    _recvChunk->begin());
+            }
+            else if (_recvSize == _recvChunk->size())
+            {
+                // a frame larger than the chunk
+                _recvChunk->resize(_recvChunk->size() * 2);
+            }
+            _recvSize = left;
+
+            startRead();
         }
         else
         {
@@ -341,6 +371,7 @@ void ChannelSession::writeBuffer(std::shared_ptr<bytes> buffer)
         std::lock_guard<std::recursive_mutex> lock(_mutex);
 
         _sendBufferList.push(buffer);
+        _pendingWriteBytes += buffer->size();
 
         startWrite();
     }
@@ -350,6 +381,12 @@ void ChannelSession::writeBuffer(std::shared_ptr<bytes> buffer)
     }
 }
 
+size_t ChannelSession::pendingWriteBytes()
+{
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    return _pendingWriteBytes;
+}
+
 void ChannelSession::onWrite(
     const boost::system::error_code& error, std::shared_ptr<bytes> buffer, size_t bytesTransferred)
 {
@@ -364,6 +401,7 @@ void ChannelSession::onWrite(
 
         std::lock_guard<std::recursive_mutex> lock(_mutex);
 
+        _pendingWriteBytes -= buffer->size();
         updateIdleTimer();
 
         if (!error)
@@ -386,7 +424,7 @@ void ChannelSession::onWrite(
     }
 }
 
-void ChannelSession::onMessage(ChannelException e, Message::Ptr message)
+void ChannelSession::onMessages(std::vector<Message::Ptr> const& messages)
 {
     try
     {
@@ -397,45 +435,61 @@ void ChannelSession::onMessage(ChannelException e, Message::Ptr message)
             return;
         }
 
-        auto it = _responseCallbacks.find(message->seq());
-        if (it != _responseCallbacks.end())
+        // the requests of a read are handled in order by one task of the thread pool
+        auto requests = std::make_shared<std::vector<Message::Ptr> >();
+        ChannelException e(0, "");
+        for (auto const& message : messages)
         {
-            if (it->second->timeoutHandler)
+            auto it = _responseCallbacks.find(message->seq());
+            if (it != _responseCallbacks.end())
             {
-                it->second->timeoutHandler->cancel();
-            }
+                if (it->second->timeoutHandler)
+                {
+                    it->second->timeoutHandler->cancel();
+                }
+
+                if (it->second->callback)
+                {
+                    _threadPool->enqueue([=]() {
+                        it->second->callback(e, message);
+                        _responseCallbacks.erase(it);
+                    });
+                }
+                else
+                {
+                    CHANNEL_LOG(ERROR) << "Callback empty";
 
-            if (it->second->callback)
-            {
-                _threadPool->enqueue([=]() {
-                    it->second->callback(e, message);
                     _responseCallbacks.erase(it);
-                });
+                }
             }
             else
             {
-                CHANNEL_LOG(ERROR) << "Callback empty";
-
-                _responseCallbacks.erase(it);
+                requests->push_back(message);
             }
         }
-        else
+
+        if (requests->empty())
         {
-            if (_messageHandler)
-            {
-                auto session = std::weak_ptr<dev::channel::ChannelSession>(shared_from_this());
-                _threadPool->enqueue([session, message]() {
+            return;
+        }
+
+        if (_messageHandler)
+        {
+            auto session = std::weak_ptr<dev::channel::ChannelSession>(shared_from_this());
+            _threadPool->enqueue([session, requests]() {
+                for (auto const& message : *requests)
+                {
                     auto s = session.lock();
                     if (s && s->_messageHandler)
                     {
                         s->_messageHandler(s, ChannelException(0, ""), message);
                     }
-                });
-            }
-            else
-            {
-                CHANNEL_LOG(ERROR) << "MessageHandler empty";
-            }
+                }
+            });
+        }
+        else
+        {
+            CHANNEL_LOG(ERROR) << "MessageHandler empty";
         }
     }
     catch (std::exception& e)
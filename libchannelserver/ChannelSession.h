@@ -53,7 +53,8 @@ public:
     typedef std::function<void(dev::channel::ChannelException, dev::channel::Message::Ptr)>
         CallbackType;
 
-    const size_t bufferLength = 1024;
+    /// the size of a receive chunk, a frame larger than it gets a chunk of its own
+    const size_t bufferLength = 64 * 1024;
 
     virtual Message::Ptr sendMessage(Message::Ptr request, size_t timeout = 0);
     virtual void asyncSendMessage(Message::Ptr request,
@@ -104,6 +105,9 @@ public:
 
     void disconnectByQuit() { disconnect(ChannelException(-1, "quit")); }
 
+    /// the bytes queued or being written to the socket
+    size_t pendingWriteBytes();
+
 private:
     void startRead();
     void onRead(const boost::system::error_code& error, size_t bytesTransferred);
@@ -113,7 +117,7 @@ private:
         size_t bytesTransferred);
     void writeBuffer(std::shared_ptr<bytes> buffer);
 
-    void onMessage(dev::channel::ChannelException e, Message::Ptr message);
+    void onMessages(std::vector<Message::Ptr> const& messages);
     void onTimeout(const boost::system::error_code& error, std::string seq);
 
     void onIdle(const boost::system::error_code& error);
@@ -132,11 +136,14 @@ private:
     std::string _host;
     int _port = 0;
 
-    byte _recvBuffer[1024];
-    bytes _recvProtocolBuffer;
+    /// the socket reads into _recvChunk after its first _recvSize bytes, the messages decoded
+    /// from a chunk view their data in it, so the partial frame left moves to a new chunk
+    std::shared_ptr<bytes> _recvChunk;
+    size_t _recvSize = 0;
 
     std::queue<std::shared_ptr<bytes> > _sendBufferList;
     bool _writing = false;
+    size_t _pendingWriteBytes = 0;
 
     std::shared_ptr<boost::asio::deadline_timer> _idleTimer;
     std::recursive_mutex _mutex;
@@ -0,0 +1,429 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @file: ChannelSubscriptions.cpp
+ */
+
+#include "ChannelSubscriptions.h"
+#include "ChannelException.h"
+#include <libethcore/CommonJS.h>
+
+using namespace dev;
+using namespace dev::eth;
+using namespace dev::channel;
+
+/// unsent bytes of a session socket above which its notifications wait
+static const size_t c_maxSessionBacklog = 4 * 1024 * 1024;
+/// notifications queued for a session before the oldest are dropped
+static const size_t c_maxQueuedBlocks = 128;
+/// filters of a session
+static const size_t c_maxSessionFilters = 64;
+
+/// FastWriter ends the text with a newline
+static std::string toCompactJson(Json::Value const& _value)
+{
+    std::string json = Json::FastWriter().write(_value);
+    if (!json.empty() && json.back() == '\n')
+    {
+        json.pop_back();
+    }
+    return json;
+}
+
+bool EventFilter::matches(LogEntry const& _log) const
+{
+    if (!addresses.empty() && !addresses.count(_log.address))
+    {
+        return false;
+    }
+    for (size_t i = 0; i < topics.size(); ++i)
+    {
+        if (topics[i].empty())
+        {
+            continue;
+        }
+        if (i >= _log.topics.size() || !topics[i].count(_log.topics[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void ChannelSubscriptions::addGroup(
+    GROUP_ID _groupID, std::shared_ptr<dev::blockchain::BlockChainInterface> _blockChain)
+{
+    Guard l(x_blocks);
+    m_blockChains[_groupID] = _blockChain;
+    m_queuedNumbers[_groupID] = _blockChain->number();
+    // called by commitBlock once the block is written, the worker reads it back
+    m_blockHandlers.push_back(_blockChain->onReady([this, _groupID, _blockChain]() {
+        noteBlocks(_groupID, _blockChain->number());
+        m_signalled.notify_all();
+    }));
+}
+
+void ChannelSubscriptions::noteBlocks(GROUP_ID _groupID, int64_t _number)
+{
+    Guard l(x_blocks);
+    auto& queued = m_queuedNumbers[_groupID];
+    while (queued < _number)
+    {
+        m_blocks.push_back(std::make_pair(_groupID, ++queued));
+    }
+}
+
+std::string ChannelSubscriptions::subscribe(
+    ChannelSession::Ptr _session, Json::Value const& _request)
+{
+    auto filter = std::make_shared<EventFilter>();
+    try
+    {
+        filter->groupID = _request["groupID"].asInt();
+        std::string type = _request.get("type", "logs").asString();
+        if (type != "logs" && type != "blocks")
+        {
+            BOOST_THROW_EXCEPTION(ChannelException(-1, "unknown subscription type: " + type));
+        }
+        filter->logs = type == "logs";
+        for (auto const& address : _request["addresses"])
+        {
+            filter->addresses.insert(jsToAddress(address.asString()));
+        }
+        for (auto const& position : _request["topics"])
+        {
+            // a topic, null for any, or an array of alternatives
+            std::set<h256> alternatives;
+            if (position.isString())
+            {
+                alternatives.insert(jsToFixed<32>(position.asString()));
+            }
+            else if (position.isArray())
+            {
+                for (auto const& topic : position)
+                {
+                    alternatives.insert(jsToFixed<32>(topic.asString()));
+                }
+            }
+            filter->topics.push_back(alternatives);
+        }
+    }
+    catch (ChannelException const&)
+    {
+        throw;
+    }
+    catch (std::exception const& e)
+    {
+        BOOST_THROW_EXCEPTION(ChannelException(-1, std::string("invalid filter: ") + e.what()));
+    }
+    filter->session = _session;
+
+    Guard l(x_filters);
+    size_t sessionFilters = 0;
+    for (auto const& it : m_filters)
+    {
+        if (it.second->session.lock() == _session)
+        {
+            ++sessionFilters;
+        }
+    }
+    if (sessionFilters >= c_maxSessionFilters)
+    {
+        BOOST_THROW_EXCEPTION(ChannelException(-1, "too many filters"));
+    }
+    filter->id = h128::random().hex();
+    m_filters[filter->id] = filter;
+    rebuildGroup(filter->groupID);
+    CHANNEL_LOG(DEBUG) << "[#ChannelSubscriptions] subscribe [filterID/groupID/type]: "
+                       << filter->id << "/" << std::to_string(filter->groupID) << "/"
+                       << (filter->logs ? "logs" : "blocks");
+    return filter->id;
+}
+
+bool ChannelSubscriptions::unsubscribe(ChannelSession::Ptr _session, std::string const& _filterID)
+{
+    Guard l(x_filters);
+    auto it = m_filters.find(_filterID);
+    if (it == m_filters.end() || it->second->session.lock() != _session)
+    {
+        return false;
+    }
+    GROUP_ID groupID = it->second->groupID;
+    m_filters.erase(it);
+    rebuildGroup(groupID);
+    return true;
+}
+
+void ChannelSubscriptions::removeSession(ChannelSession::Ptr _session)
+{
+    {
+        Guard l(x_filters);
+        std::set<GROUP_ID> groups;
+        for (auto it = m_filters.begin(); it != m_filters.end();)
+        {
+            auto session = it->second->session.lock();
+            if (!session || session == _session)
+            {
+                groups.insert(it->second->groupID);
+                it = m_filters.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+        for (auto groupID : groups)
+        {
+            rebuildGroup(groupID);
+        }
+    }
+    Guard l(x_queues);
+    m_queues.erase(_session.get());
+}
+
+/// called with x_filters held, the worker keeps matching the previous index meanwhile
+void ChannelSubscriptions::rebuildGroup(GROUP_ID _groupID)
+{
+    auto groupFilters = std::make_shared<GroupFilters>();
+    for (auto const& it : m_filters)
+    {
+        auto const& filter = it.second;
+        if (filter->groupID != _groupID)
+        {
+            continue;
+        }
+        if (!filter->logs)
+        {
+            groupFilters->blocks.push_back(filter);
+        }
+        else if (filter->addresses.empty())
+        {
+            groupFilters->anyAddress.push_back(filter);
+        }
+        else
+        {
+            for (auto const& address : filter->addresses)
+            {
+                groupFilters->byAddress[address].push_back(filter);
+            }
+        }
+    }
+    m_groupFilters[_groupID] = groupFilters;
+}
+
+std::map<ChannelSession::Ptr, Json::Value> ChannelSubscriptions::match(
+    GROUP_ID _groupID, Block const& _block)
+{
+    std::shared_ptr<GroupFilters const> groupFilters;
+    {
+        Guard l(x_filters);
+        auto it = m_groupFilters.find(_groupID);
+        if (it != m_groupFilters.end())
+        {
+            groupFilters = it->second;
+        }
+    }
+    std::map<ChannelSession::Ptr, Json::Value> notifications;
+    if (!groupFilters)
+    {
+        return notifications;
+    }
+
+    // the matches of every filter, in the order of the logs of the block
+    std::map<EventFilter::Ptr, Json::Value> matches;
+    for (auto const& filter : groupFilters->blocks)
+    {
+        matches[filter] = Json::Value(Json::objectValue);
+    }
+    auto const& receipts = _block.transactionReceipts();
+    auto const& transactions = _block.transactions();
+    std::vector<EventFilter::Ptr> const noFilters;
+    for (size_t i = 0; i < receipts.size(); ++i)
+    {
+        auto const& logs = receipts[i].log();
+        for (size_t j = 0; j < logs.size(); ++j)
+        {
+            auto addressIt = groupFilters->byAddress.find(logs[j].address);
+            auto const& byAddress =
+                addressIt == groupFilters->byAddress.end() ? noFilters : addressIt->second;
+            for (auto const* candidates : {&byAddress, &groupFilters->anyAddress})
+            {
+                for (auto const& filter : *candidates)
+                {
+                    if (!filter->matches(logs[j]))
+                    {
+                        continue;
+                    }
+                    Json::Value log;
+                    log["address"] = toJS(logs[j].address);
+                    log["topics"] = Json::Value(Json::arrayValue);
+                    for (auto const& topic : logs[j].topics)
+                        log["topics"].append(toJS(topic));
+                    log["data"] = toJS(logs[j].data);
+                    log["transactionIndex"] = toJS(i);
+                    log["logIndex"] = toJS(j);
+                    if (i < transactions.size())
+                        log["transactionHash"] = toJS(transactions[i].sha3());
+                    matches[filter]["logs"].append(log);
+                }
+            }
+        }
+    }
+
+    auto const& header = _block.blockHeader();
+    for (auto& it : matches)
+    {
+        auto session = it.first->session.lock();
+        if (!session)
+        {
+            continue;
+        }
+        auto& notification = notifications[session];
+        if (notification.isNull())
+        {
+            notification["groupID"] = int(_groupID);
+            notification["blockNumber"] = toJS(header.number());
+            notification["blockHash"] = toJS(header.hash());
+            notification["filters"] = Json::Value(Json::arrayValue);
+        }
+        it.second["filterID"] = it.first->id;
+        notification["filters"].append(it.second);
+    }
+    return notifications;
+}
+
+void ChannelSubscriptions::workLoop()
+{
+    while (workerState() == WorkerState::Started)
+    {
+        doWork();
+        std::unique_lock<std::mutex> l(x_signalled);
+        m_signalled.wait_for(l, std::chrono::milliseconds(idleWaitMs()));
+    }
+}
+
+void ChannelSubscriptions::doWork()
+{
+    while (true)
+    {
+        std::pair<GROUP_ID, int64_t> next;
+        std::shared_ptr<dev::blockchain::BlockChainInterface> blockChain;
+        {
+            Guard l(x_blocks);
+            if (m_blocks.empty())
+            {
+                break;
+            }
+            next = m_blocks.front();
+            m_blocks.pop_front();
+            blockChain = m_blockChains[next.first];
+        }
+        try
+        {
+            auto block = blockChain->getBlockByNumber(next.second);
+            if (!block)
+            {
+                continue;
+            }
+            for (auto& it : match(next.first, *block))
+            {
+                push(it.first,
+                    QueuedNotification{next.first, next.second, toCompactJson(it.second)});
+            }
+        }
+        catch (std::exception& e)
+        {
+            CHANNEL_LOG(ERROR) << "[#ChannelSubscriptions] match block failed [groupID/number]: "
+                               << std::to_string(next.first) << "/" << next.second << ", "
+                               << e.what();
+        }
+    }
+    // also retries the sessions that were too far behind
+    flush();
+}
+
+void ChannelSubscriptions::push(ChannelSession::Ptr _session, QueuedNotification&& _notification)
+{
+    Guard l(x_queues);
+    auto& queue = m_queues[_session.get()];
+    queue.session = _session;
+    if (queue.notifications.size() >= c_maxQueuedBlocks)
+    {
+        auto const& dropped = queue.notifications.front();
+        auto missed = queue.missed.find(dropped.groupID);
+        if (missed == queue.missed.end())
+        {
+            queue.missed[dropped.groupID] = std::make_pair(dropped.number, dropped.number);
+        }
+        else
+        {
+            missed->second.second = dropped.number;
+        }
+        queue.notifications.pop_front();
+    }
+    queue.notifications.push_back(std::move(_notification));
+}
+
+void ChannelSubscriptions::flush()
+{
+    Guard l(x_queues);
+    for (auto it = m_queues.begin(); it != m_queues.end();)
+    {
+        auto session = it->second.session.lock();
+        if (!session || !session->actived())
+        {
+            it = m_queues.erase(it);
+            continue;
+        }
+        auto& queue = it->second;
+        if (queue.notifications.empty() || session->pendingWriteBytes() > c_maxSessionBacklog)
+        {
+            ++it;
+            continue;
+        }
+
+        // every notification queued for the session goes in one message
+        std::string data = "[";
+        for (auto const& missed : queue.missed)
+        {
+            CHANNEL_LOG(WARNING) << "[#ChannelSubscriptions] session too slow, notifications "
+                                    "dropped [groupID/from/to]: "
+                                 << std::to_string(missed.first) << "/"
+                                 << missed.second.first << "/" << missed.second.second;
+            Json::Value notification;
+            notification["groupID"] = int(missed.first);
+            notification["missedFromBlock"] = toJS(missed.second.first);
+            notification["missedToBlock"] = toJS(missed.second.second);
+            data += (data.size() > 1 ? "," : "") + toCompactJson(notification);
+        }
+        for (auto const& notification : queue.notifications)
+        {
+            data += (data.size() > 1 ? "," : "") + notification.json;
+        }
+        data += "]";
+        queue.missed.clear();
+        queue.notifications.clear();
+
+        auto message = session->messageFactory()->buildMessage();
+        message->setType(0x42);
+        message->setSeq(h128(u128(++m_pushSeq)).hex());
+        message->setResult(0);
+        message->setData((const byte*)data.data(), data.size());
+        session->asyncSendMessage(message, ChannelSession::CallbackType(), 0);
+        ++it;
+    }
+}
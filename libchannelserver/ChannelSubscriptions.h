@@ -0,0 +1,151 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @file: ChannelSubscriptions.h
+ *
+ * the block and log filters of the channel clients, the new blocks are pushed to them
+ */
+
+#pragma once
+
+#include "ChannelSession.h"
+#include <json/json.h>
+#include <libblockchain/BlockChainInterface.h>
+#include <libdevcore/Worker.h>
+#include <libethcore/Block.h>
+#include <libethcore/LogEntry.h>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <set>
+#include <unordered_map>
+
+namespace dev
+{
+namespace channel
+{
+/// a filter of a client: every new block of a group, or the logs of the new blocks emitted by one
+/// of addresses (any if empty) with, at each position, one of topics (any if empty)
+struct EventFilter
+{
+    typedef std::shared_ptr<EventFilter> Ptr;
+
+    std::string id;
+    dev::GROUP_ID groupID = 0;
+    bool logs = true;
+    std::set<dev::Address> addresses;
+    std::vector<std::set<dev::h256>> topics;
+    std::weak_ptr<ChannelSession> session;
+
+    bool matches(dev::eth::LogEntry const& _log) const;
+};
+
+/// Clients subscribe with the channel message 0x40 {"groupID", "type": "blocks"|"logs",
+/// "addresses", "topics"} and unsubscribe with 0x41 {"filterID"}. A worker matches the filters
+/// against every committed block in one pass over its logs, and pushes one 0x42 message per
+/// session with the JSON array of the notifications queued for it. A session whose socket has
+/// c_maxSessionBacklog bytes unsent keeps its notifications queued, past c_maxQueuedBlocks the
+/// oldest are dropped and reported as a missed range of blocks.
+class ChannelSubscriptions : public Worker
+{
+public:
+    typedef std::shared_ptr<ChannelSubscriptions> Ptr;
+
+    ChannelSubscriptions() : Worker("ChannelPush", 100) {}
+    virtual ~ChannelSubscriptions() { stop(); }
+
+    void start() { startWorking(); }
+    void stop()
+    {
+        stopWorking();
+        terminate();
+    }
+
+    /// the blocks committed by _blockChain are matched against the filters of _groupID
+    void addGroup(
+        dev::GROUP_ID _groupID, std::shared_ptr<dev::blockchain::BlockChainInterface> _blockChain);
+
+    /// @returns the id of the new filter, throws ChannelException if _request is invalid
+    std::string subscribe(ChannelSession::Ptr _session, Json::Value const& _request);
+    bool unsubscribe(ChannelSession::Ptr _session, std::string const& _filterID);
+    /// drops the filters and the queued notifications of a closed session
+    void removeSession(ChannelSession::Ptr _session);
+
+    /// the notification of _block for every session with a matching filter
+    std::map<ChannelSession::Ptr, Json::Value> match(
+        dev::GROUP_ID _groupID, dev::eth::Block const& _block);
+
+protected:
+    void doWork() override;
+    void workLoop() override;
+
+    /// queues the blocks of _groupID after the last queued one up to _number, the signals of
+    /// the commits can be coalesced or observe the number of a later commit
+    void noteBlocks(dev::GROUP_ID _groupID, int64_t _number);
+
+    /// the blocks committed since the last doWork, and the last queued number of every group
+    Mutex x_blocks;
+    std::deque<std::pair<dev::GROUP_ID, int64_t>> m_blocks;
+    std::map<dev::GROUP_ID, int64_t> m_queuedNumbers;
+
+private:
+    /// the filters of a group indexed for the matching, rebuilt when they change
+    struct GroupFilters
+    {
+        std::vector<EventFilter::Ptr> blocks;
+        std::unordered_map<dev::Address, std::vector<EventFilter::Ptr>> byAddress;
+        std::vector<EventFilter::Ptr> anyAddress;
+    };
+
+    struct QueuedNotification
+    {
+        dev::GROUP_ID groupID;
+        int64_t number;
+        std::string json;
+    };
+
+    struct SessionQueue
+    {
+        std::weak_ptr<ChannelSession> session;
+        std::deque<QueuedNotification> notifications;
+        /// the first and last numbers of the dropped blocks of every group
+        std::map<dev::GROUP_ID, std::pair<int64_t, int64_t>> missed;
+    };
+
+    void rebuildGroup(dev::GROUP_ID _groupID);
+    void push(ChannelSession::Ptr _session, QueuedNotification&& _notification);
+    void flush();
+
+    /// filters by id and their index by group
+    Mutex x_filters;
+    std::map<std::string, EventFilter::Ptr> m_filters;
+    std::map<dev::GROUP_ID, std::shared_ptr<GroupFilters const>> m_groupFilters;
+
+    std::map<dev::GROUP_ID, std::shared_ptr<dev::blockchain::BlockChainInterface>> m_blockChains;
+    std::vector<dev::eth::Handler<>> m_blockHandlers;
+
+    /// accessed by the worker only, but removeSession
+    Mutex x_queues;
+    std::map<ChannelSession*, SessionQueue> m_queues;
+    uint64_t m_pushSeq = 0;
+
+    std::mutex x_signalled;
+    std::condition_variable m_signalled;
+};
+
+}  // namespace channel
+}  // namespace dev
@@ -49,6 +49,13 @@ public:
 
     virtual ssize_t decode(const byte* buffer, size_t size) = 0;
 
+    /// decodes the frame at offset of chunk, the data may be a view of the chunk instead of a
+    /// copy, the chunk is kept alive by the message and must not be written afterwards
+    virtual ssize_t decodeInPlace(std::shared_ptr<bytes> const& chunk, size_t offset, size_t size)
+    {
+        return decode(chunk->data() + offset, size);
+    }
+
     virtual uint32_t length() { return _length; }
 
     virtual uint16_t type() { return _type; }
@@ -60,12 +67,20 @@ public:
     virtual int result() { return _result; }
     virtual void setResult(int result) { _result = result; }
 
-    virtual byte* data() { return _data->data(); }
-    virtual size_t dataSize() { return _data->size(); }
+    virtual byte* data() { return _chunk ? _view : _data->data(); }
+    virtual size_t dataSize() { return _chunk ? _viewSize : _data->size(); }
 
-    virtual void setData(const byte* p, size_t size) { _data->assign(p, p + size); }
+    virtual void setData(const byte* p, size_t size)
+    {
+        _data->assign(p, p + size);
+        clearView();
+    }
 
-    virtual void clearData() { _data->clear(); }
+    virtual void clearData()
+    {
+        _data->clear();
+        clearView();
+    }
 
 protected:
     uint32_t _length = 0;
@@ -74,6 +89,18 @@ protected:
     int _result = 0;
 
     std::shared_ptr<bytes> _data;
+
+    /// the data decoded in place: _viewSize bytes at _view of the receive chunk _chunk
+    void clearView()
+    {
+        _chunk.reset();
+        _view = nullptr;
+        _viewSize = 0;
+    }
+
+    std::shared_ptr<bytes> _chunk;
+    byte* _view = nullptr;
+    size_t _viewSize = 0;
 };
 
 class MessageFactory : public std::enable_shared_from_this<MessageFactory>
@@ -22,6 +22,7 @@
  * @date: 2018-09-28
  */
 #include "PBFTEngine.h"
+#include "SignatureCache.h"
 #include <json_spirit/JsonSpiritHeaders.h>
 #include <libdevcore/CommonJS.h>
 #include <libdevcore/Worker.h>
@@ -275,8 +276,9 @@ bool PBFTEngine::checkSign(PBFTMsg const& req) const
     if (getNodeIDByIndex(node_id, req.idx))
     {
         Public pub_id = jsToPublic(toJS(node_id.hex()));
-        return dev::verify(pub_id, req.sig, req.block_hash) &&
-               dev::verify(pub_id, req.sig2, req.fieldsWithoutBlock());
+        auto& signatureCache = SignatureCache::instance();
+        return signatureCache.verify(pub_id, req.sig, req.block_hash) &&
+               signatureCache.verify(pub_id, req.sig2, req.fieldsWithoutBlock());
     }
     return false;
 }
@@ -514,8 +516,10 @@ bool PBFTEngine::checkBlock(Block const& block)
                    << sig_list.size() << "/" << minValidNodes();
         return false;
     }
-    /// check sign
-    for (auto sign : sig_list)
+    /// check sign, the signatures of the commit messages are usually cached already
+    std::vector<SignatureCache::Item> items;
+    items.reserve(sig_list.size());
+    for (auto const& sign : sig_list)
     {
         if (sign.first >= m_minerList.size())
         {
@@ -523,14 +527,16 @@ bool PBFTEngine::checkBlock(Block const& block)
                        << m_minerList.size();
             return false;
         }
-        if (!dev::verify(m_minerList[sign.first.convert_to<size_t>()], sign.second,
-                block.blockHeader().hash()))
-        {
-            LOG(ERROR) << "[#checkBlock] invalid sign [idx/pub/hash]: " << sign.first << "/"
-                       << m_minerList[sign.first.convert_to<size_t>()].abridged() << "/"
-                       << block.blockHeader().hash().abridged();
-            return false;
-        }
+        items.push_back(SignatureCache::Item{m_minerList[sign.first.convert_to<size_t>()],
+            sign.second, block.blockHeader().hash()});
+    }
+    size_t invalid = 0;
+    if (!SignatureCache::instance().verifyBatch(items, invalid))
+    {
+        LOG(ERROR) << "[#checkBlock] invalid sign [idx/pub/hash]: " << sig_list[invalid].first
+                   << "/" << items[invalid].pub.abridged() << "/"
+                   << block.blockHeader().hash().abridged();
+        return false;
     }  /// end of check sign
 
     /// Check whether the number of transactions in block exceeds the limit
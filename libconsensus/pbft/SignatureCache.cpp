@@ -0,0 +1,117 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @brief : cache of the signatures verified by PBFT
+ * @file: SignatureCache.cpp
+ */
+
+#include "SignatureCache.h"
+#include <libdevcrypto/Hash.h>
+#include <algorithm>
+#include <future>
+#include <thread>
+
+using namespace dev;
+using namespace dev::consensus;
+
+SignatureCache& SignatureCache::instance()
+{
+    static SignatureCache s_cache;
+    return s_cache;
+}
+
+h256 SignatureCache::key(Public const& _pub, Signature const& _sig, h256 const& _hash)
+{
+    bytes data;
+    data.reserve(Public::size + Signature::size + h256::size);
+    data += _pub.asBytes();
+    data += _sig.asBytes();
+    data += _hash.asBytes();
+    return sha3(data);
+}
+
+bool SignatureCache::verify(Public const& _pub, Signature const& _sig, h256 const& _hash)
+{
+    h256 cacheKey = key(_pub, _sig, _hash);
+    bool verified = false;
+    if (m_verified.get(cacheKey, verified))
+    {
+        return true;
+    }
+    if (!dev::verify(_pub, _sig, _hash))
+    {
+        return false;
+    }
+    m_verified.put(cacheKey, true);
+    return true;
+}
+
+bool SignatureCache::verifyBatch(std::vector<Item> const& _items, size_t& o_invalid)
+{
+    std::vector<h256> keys(_items.size());
+    std::vector<size_t> pending;
+    for (size_t i = 0; i < _items.size(); ++i)
+    {
+        keys[i] = key(_items[i].pub, _items[i].sig, _items[i].hash);
+        bool verified = false;
+        if (!m_verified.get(keys[i], verified))
+        {
+            pending.push_back(i);
+        }
+    }
+
+    // every thread verifies a stride of the pending items, the caller takes the first one
+    std::vector<char> valid(_items.size(), 1);
+    if (!pending.empty())
+    {
+        size_t threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+        size_t batches = (pending.size() + c_minBatchPerThread - 1) / c_minBatchPerThread;
+        threads = std::min(threads, batches);
+        auto verifyStride = [&](size_t _first) {
+            for (size_t j = _first; j < pending.size(); j += threads)
+            {
+                auto const& item = _items[pending[j]];
+                valid[pending[j]] = dev::verify(item.pub, item.sig, item.hash);
+            }
+        };
+        std::vector<std::future<void>> futures;
+        for (size_t t = 1; t < threads; ++t)
+        {
+            futures.push_back(std::async(std::launch::async, verifyStride, t));
+        }
+        verifyStride(0);
+        for (auto& future : futures)
+        {
+            future.get();
+        }
+    }
+
+    bool ret = true;
+    for (auto i : pending)
+    {
+        if (valid[i])
+        {
+            m_verified.put(keys[i], true);
+        }
+        else if (ret)
+        {
+            o_invalid = i;
+            ret = false;
+        }
+    }
+    return ret;
+}
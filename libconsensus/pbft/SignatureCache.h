@@ -0,0 +1,73 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @brief : cache of the signatures verified by PBFT
+ * @file: SignatureCache.h
+ */
+
+#pragma once
+#include <libdevcore/FixedHash.h>
+#include <libdevcore/LRUCache.h>
+#include <libdevcrypto/Common.h>
+#include <vector>
+
+namespace dev
+{
+namespace consensus
+{
+/// Process-wide LRU of the signatures that passed dev::verify, keyed by (public key, hash,
+/// signature). The sign and commit messages are checked when they arrive, their signatures
+/// come back in the sigList of the block (checkBlock, also called by sync), and forwarded
+/// messages are seen several times, only the first check pays for the ECDSA verification.
+class SignatureCache
+{
+public:
+    struct Item
+    {
+        Public pub;
+        Signature sig;
+        h256 hash;
+    };
+
+    static SignatureCache& instance();
+
+    /// dev::verify, only the successful checks are cached
+    bool verify(Public const& _pub, Signature const& _sig, h256 const& _hash);
+
+    /// verify all items, the ones not cached are verified in parallel
+    /// @param o_invalid index of the first invalid item when false is returned
+    bool verifyBatch(std::vector<Item> const& _items, size_t& o_invalid);
+
+    void setCapacity(size_t _capacity) { m_verified.setCapacity(_capacity); }
+    size_t size() const { return m_verified.size(); }
+    uint64_t hits() const { return m_verified.hits(); }
+    uint64_t misses() const { return m_verified.misses(); }
+    void clear() { m_verified.clear(); }
+
+private:
+    SignatureCache() : m_verified(c_defaultCapacity) {}
+
+    static h256 key(Public const& _pub, Signature const& _sig, h256 const& _hash);
+
+    /// a thread verifies at least this many signatures of a batch
+    static const size_t c_minBatchPerThread = 4;
+    /// number of signatures
+    static const size_t c_defaultCapacity = 64 * 1024;
+    LRUCache<h256, bool> m_verified;
+};
+}  // namespace consensus
+}  // namespace dev
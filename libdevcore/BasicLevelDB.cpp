@@ -22,12 +22,49 @@
 
 
 #include "BasicLevelDB.h"
+#include <libdevcore/Guards.h>
 #include <libdevcore/easylog.h>
+#include <map>
 
 using namespace dev;
 using namespace dev::db;
 using namespace std;
 
+leveldb::Options dev::db::sharedLevelDBOptions(LevelDBConfig const& _config)
+{
+    // intentionally never freed, the dbs using them live until the process exits
+    static std::map<size_t, leveldb::Cache*> s_blockCaches;
+    static std::map<int, const leveldb::FilterPolicy*> s_bloomFilters;
+    static Mutex x_shared;
+
+    leveldb::Cache* blockCache = nullptr;
+    const leveldb::FilterPolicy* bloomFilter = nullptr;
+    {
+        Guard l(x_shared);
+        auto& cache = s_blockCaches[_config.blockCacheMB];
+        if (!cache)
+            cache = leveldb::NewLRUCache(_config.blockCacheMB << 20);
+        blockCache = cache;
+        if (_config.bloomBitsPerKey > 0)
+        {
+            auto& filter = s_bloomFilters[_config.bloomBitsPerKey];
+            if (!filter)
+                filter = leveldb::NewBloomFilterPolicy(_config.bloomBitsPerKey);
+            bloomFilter = filter;
+        }
+    }
+
+    leveldb::Options options;
+    options.create_if_missing = true;
+    options.max_open_files = _config.maxOpenFiles;
+    options.write_buffer_size = _config.writeBufferMB << 20;
+    options.block_cache = blockCache;
+    options.filter_policy = bloomFilter;
+    options.compression =
+        _config.compression ? leveldb::kSnappyCompression : leveldb::kNoCompression;
+    return options;
+}
+
 inline leveldb::Slice toLDBSlice(Slice _slice)
 {
     return leveldb::Slice(_slice.data(), _slice.size());
@@ -129,6 +166,34 @@ leveldb::Iterator* BasicLevelDB::NewIterator(const leveldb::ReadOptions& _option
     return m_db->NewIterator(_options);
 }
 
+bool BasicLevelDB::GetProperty(const leveldb::Slice& _property, std::string* _value)
+{
+    if (!m_db)
+        return false;
+    return m_db->GetProperty(_property, _value);
+}
+
+void BasicLevelDB::GetApproximateSizes(const leveldb::Range* _range, int _n, uint64_t* _sizes)
+{
+    if (!m_db)
+        return;
+    m_db->GetApproximateSizes(_range, _n, _sizes);
+}
+
+const leveldb::Snapshot* BasicLevelDB::GetSnapshot()
+{
+    if (!m_db)
+        return NULL;
+    return m_db->GetSnapshot();
+}
+
+void BasicLevelDB::ReleaseSnapshot(const leveldb::Snapshot* _snapshot)
+{
+    if (!m_db || !_snapshot)
+        return;
+    m_db->ReleaseSnapshot(_snapshot);
+}
+
 std::unique_ptr<LevelDBWriteBatch> BasicLevelDB::createWriteBatch() const
 {
     return std::unique_ptr<LevelDBWriteBatch>(new LevelDBWriteBatch());
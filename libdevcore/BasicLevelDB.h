@@ -23,7 +23,9 @@
 #pragma once
 
 #include "db.h"
+#include <leveldb/cache.h>
 #include <leveldb/db.h>
+#include <leveldb/filter_policy.h>
 #include <leveldb/status.h>
 #include <leveldb/write_batch.h>
 #include <libdevcore/easylog.h>
@@ -34,6 +36,23 @@ namespace dev
 {
 namespace db
 {
+/// tunables of a leveldb instance
+struct LevelDBConfig
+{
+    /// size of the block cache in MB, shared by the dbs configured with the same size
+    size_t blockCacheMB = 128;
+    size_t writeBufferMB = 4;
+    int maxOpenFiles = 100;
+    /// bits per key of the bloom filter, 0 disables it
+    int bloomBitsPerKey = 10;
+    bool compression = true;
+};
+
+/// leveldb::Options for _config; the dbs of the process (one per group) configured with the
+/// same blockCacheMB share one LRU block cache, and the same for bloomBitsPerKey and the bloom
+/// filter policy, instead of allocating their own
+leveldb::Options sharedLevelDBOptions(LevelDBConfig const& _config);
+
 class LevelDBWriteBatch : public WriteBatchFace
 {
 public:
@@ -74,6 +93,15 @@ public:
 
     virtual leveldb::Iterator* NewIterator(const leveldb::ReadOptions& _options);
 
+    virtual bool GetProperty(const leveldb::Slice& _property, std::string* _value);
+
+    virtual void GetApproximateSizes(const leveldb::Range* _range, int _n, uint64_t* _sizes);
+
+    /// nullptr if the db is not open, the reads with a null snapshot see the current state
+    virtual const leveldb::Snapshot* GetSnapshot();
+
+    virtual void ReleaseSnapshot(const leveldb::Snapshot* _snapshot);
+
     virtual std::unique_ptr<LevelDBWriteBatch> createWriteBatch() const;
 
     leveldb::Status OpenStatus() { return m_openStatus; }
@@ -91,6 +91,7 @@ DEV_SIMPLE_EXCEPTION(ConnectionToSelfException);
 DEV_SIMPLE_EXCEPTION(InitLedgerConfigFailed);
 DEV_SIMPLE_EXCEPTION(InvalidConsensusType);
 DEV_SIMPLE_EXCEPTION(OpenLevelDBFailed);
+DEV_SIMPLE_EXCEPTION(OpenRocksDBFailed);
 DEV_SIMPLE_EXCEPTION(LevelDBNotOpened);
 /**
  * @brief : error information to be added to exceptions
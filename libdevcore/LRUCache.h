@@ -0,0 +1,142 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/** @file LRUCache.h
+ */
+
+#pragma once
+
+#include "Guards.h"
+#include <functional>
+#include <list>
+#include <unordered_map>
+
+namespace dev
+{
+/// Thread-safe LRU cache bounded by the total cost of its values (1 per value by default).
+template <class Key, class Value, class Hash = std::hash<Key>>
+class LRUCache
+{
+public:
+    typedef std::function<size_t(Value const&)> CostFunction;
+
+    explicit LRUCache(
+        size_t _capacity, CostFunction _cost = [](Value const&) -> size_t { return 1; })
+      : m_capacity(_capacity), m_costFunction(_cost)
+    {}
+
+    /// @return false if _key is not cached, refreshes the entry otherwise
+    bool get(Key const& _key, Value& o_value)
+    {
+        Guard l(x_entries);
+        auto it = m_index.find(_key);
+        if (it == m_index.end())
+        {
+            ++m_misses;
+            return false;
+        }
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        o_value = it->second->second;
+        ++m_hits;
+        return true;
+    }
+
+    void put(Key const& _key, Value _value)
+    {
+        Guard l(x_entries);
+        eraseKey(_key);
+        m_cost += m_costFunction(_value);
+        m_entries.emplace_front(_key, std::move(_value));
+        m_index[_key] = m_entries.begin();
+        evict();
+    }
+
+    void erase(Key const& _key)
+    {
+        Guard l(x_entries);
+        eraseKey(_key);
+    }
+
+    void setCapacity(size_t _capacity)
+    {
+        Guard l(x_entries);
+        m_capacity = _capacity;
+        evict();
+    }
+
+    void clear()
+    {
+        Guard l(x_entries);
+        m_entries.clear();
+        m_index.clear();
+        m_cost = 0;
+    }
+
+    size_t capacity() const
+    {
+        Guard l(x_entries);
+        return m_capacity;
+    }
+    size_t size() const
+    {
+        Guard l(x_entries);
+        return m_entries.size();
+    }
+    /// total cost of the cached values
+    size_t cost() const
+    {
+        Guard l(x_entries);
+        return m_cost;
+    }
+    uint64_t hits() const { return m_hits; }
+    uint64_t misses() const { return m_misses; }
+
+private:
+    void eraseKey(Key const& _key)
+    {
+        auto it = m_index.find(_key);
+        if (it != m_index.end())
+        {
+            m_cost -= m_costFunction(it->second->second);
+            m_entries.erase(it->second);
+            m_index.erase(it);
+        }
+    }
+
+    void evict()
+    {
+        while (m_cost > m_capacity && !m_entries.empty())
+        {
+            auto& last = m_entries.back();
+            m_cost -= m_costFunction(last.second);
+            m_index.erase(last.first);
+            m_entries.pop_back();
+        }
+    }
+
+    typedef std::list<std::pair<Key, Value>> EntryList;
+    /// most recently used first
+    EntryList m_entries;
+    std::unordered_map<Key, typename EntryList::iterator, Hash> m_index;
+    size_t m_capacity;
+    size_t m_cost = 0;
+    CostFunction m_costFunction;
+    std::atomic<uint64_t> m_hits = {0};
+    std::atomic<uint64_t> m_misses = {0};
+    mutable Mutex x_entries;
+};
+
+}  // namespace dev
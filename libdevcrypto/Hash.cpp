@@ -186,6 +186,13 @@ bool sha3(bytesConstRef _input, bytesRef o_output)
     return true;
 }
 
+h256 keccak256(bytesConstRef _input)
+{
+    h256 ret;
+    keccak::sha3_256(ret.data(), 32, _input.data(), _input.size());
+    return ret;
+}
+
 // add sha2 -- sha256 to this file begin
 h256 sha256(bytesConstRef _input) noexcept
 {
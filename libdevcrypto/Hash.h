@@ -41,6 +41,9 @@ h256 sha256(bytesConstRef _input) noexcept;
 
 h160 ripemd160(bytesConstRef _input);
 
+/// Keccak-256 in every build, sha3 is SM3 in the GM build
+h256 keccak256(bytesConstRef _input);
+
 /// Calculate SHA3-256 hash of the given input, returning as a 256-bit hash.
 inline h256 sha3(bytesConstRef _input)
 {
@@ -130,9 +130,12 @@ bool dev::SignatureStruct::isValid() const noexcept
  */
 Public dev::toPublic(Secret const& _secret)
 {
-    string pri = toHex(bytesConstRef{_secret.data(), 32});
-    string pub = SM2::getInstance().priToPub(pri);
-    return Public(fromHex(pub));
+    Public pub;
+    if (!SM2::getInstance().priToPub(_secret.data(), pub.data()))
+    {
+        return Public{};
+    }
+    return pub;
 }
 
 /**
@@ -259,20 +262,32 @@ Public dev::recover(Signature const& _sig, h256 const& _message)
     // return sign.pub;
 }
 
+namespace
+{
+/// a node signs with the same key over and over, remember the public key of the last secret
+Public const& signerPublic(Secret const& _secret)
+{
+    static thread_local std::pair<Secret, Public> s_last;
+    if (!s_last.second || s_last.first != _secret)
+    {
+        s_last = std::make_pair(_secret, toPublic(_secret));
+    }
+    return s_last.second;
+}
+}  // namespace
+
+/// the GM signature is r (32 bytes) || s (32 bytes) || public key (64 bytes)
 Signature dev::sign(Secret const& _k, h256 const& _hash)
 {
-    string pri = toHex(bytesConstRef{_k.data(), 32});
-    string r = "", s = "";
-    if (!SM2::getInstance().sign((const char*)_hash.data(), h256::size, pri, r, s))
+    Public const& pub = signerPublic(_k);
+    Signature sig;
+    if (!pub || !SM2::getInstance().sign(_hash.data(), h256::size, _k.data(), pub.data(),
+                    sig.data()))
     {
         return Signature{};
     }
-    // std::cout << "Gmcommon.cpp line 255 Secret====" << pri << std::endl;
-    string pub = SM2::getInstance().priToPub(pri);
-    // std::cout <<"_hash:"<<toHex(_hash.asBytes())<<"gmSign:"<< r + s + pub;
-    bytes byteSign = fromHex(r + s + pub);
-    // std::cout <<"sign toHex:"<<toHex(byteSign)<<" sign toHexLen:"<<toHex(byteSign).length();
-    return Signature{byteSign};
+    memcpy(sig.data() + 64, pub.data(), Public::size);
+    return sig;
 }
 
 
@@ -302,17 +317,7 @@ Secret Nonce::next()
 
 bool dev::verify(Public const& _p, Signature const& _s, h256 const& _hash)
 {
-    string signData = toHex(_s.asBytes());
-    // LOG(DEBUG)<<"verify signData:"<<signData;
-    // LOG(DEBUG)<<"_hash:"<<toHex(_hash.asBytes());
-    string pub = toHex(_p.asBytes());
-    pub = "04" + pub;
-    // LOG(DEBUG)<<"verify pub:"<<pub;
-    bool lresult = SM2::getInstance().verify(
-        signData, signData.length(), (const char*)_hash.data(), h256::size, pub);
-    // LOG(DEBUG)<<"verify lresult:"<<lresult;
-    // assert(lresult);
-    return lresult;
+    return SM2::getInstance().verify(_s.data(), _hash.data(), h256::size, _p.data());
 }
 
 
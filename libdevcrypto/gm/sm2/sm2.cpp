@@ -22,6 +22,7 @@
  */
 #include "sm2.h"
 #include <libdevcore/easylog.h>
+#include <cstring>
 #define SM3_DIGEST_LENGTH 32
 bool SM2::genKey()
 {
@@ -102,226 +103,206 @@ string SM2::getPrivateKey()
     return privateKey;
 }
 
-bool SM2::sign(
-    const char* originalData, int originalDataLen, const string& privateKey, string& r, string& s)
+namespace
 {
-    // originalDataLen:"<<originalDataLen<<" Sign privateKey:"<<privateKey;
+/// OpenSSL objects reused by all the SM2 operations of a thread, the keys carry their own copy
+/// of the group, which shares the precomputed multiples of the generator
+struct SM2Context
+{
+    explicit SM2Context(const EC_GROUP* _group)
+      : bnCtx(BN_CTX_new()),
+        signKey(EC_KEY_new()),
+        verifyKey(EC_KEY_new()),
+        point(EC_POINT_new(_group)),
+        number(BN_new()),
+        signature(ECDSA_SIG_new())
+    {
+        EC_KEY_set_group(signKey, _group);
+        EC_KEY_set_group(verifyKey, _group);
+    }
+    ~SM2Context()
+    {
+        BN_CTX_free(bnCtx);
+        EC_KEY_free(signKey);
+        EC_KEY_free(verifyKey);
+        EC_POINT_free(point);
+        BN_clear_free(number);
+        ECDSA_SIG_free(signature);
+    }
+    bool valid() const { return bnCtx && signKey && verifyKey && point && number && signature; }
 
-    bool lresult = false;
-    SM3_CTX sm3Ctx;
-    EC_KEY* sm2Key = NULL;
-    unsigned char zValue[SM3_DIGEST_LENGTH];
-    size_t zValueLen;
-    ECDSA_SIG* signData = NULL;
-    char* rData = NULL;
-    char* sData = NULL;
-    string str = "";   // big int data
-    string _str = "";  // big int swap data
-    int _size = 0;     // big int padding size
-    BIGNUM start;
-    BIGNUM* res = NULL;
-    BN_CTX* ctx = NULL;
-    BN_init(&start);
-    ctx = BN_CTX_new();
+    BN_CTX* bnCtx;
+    EC_KEY* signKey;
+    EC_KEY* verifyKey;
+    EC_POINT* point;
+    BIGNUM* number;
+    ECDSA_SIG* signature;
+};
 
-    res = &start;
-    BN_hex2bn(&res, (const char*)privateKey.c_str());
-    sm2Key = EC_KEY_new_by_curve_name(NID_sm2);
-    EC_KEY_set_private_key(sm2Key, res);
+SM2Context& context()
+{
+    static thread_local SM2Context s_context(SM2::getInstance().group());
+    return s_context;
+}
 
-    zValueLen = sizeof(zValue);
-    if (!ECDSA_sm2_get_Z((const EC_KEY*)sm2Key, NULL, NULL, 0, zValue, &zValueLen))
+/// decode the 64 bytes x || y into o_point, fails if it is not on the curve
+bool toPoint(const EC_GROUP* _group, const unsigned char* _pub, EC_POINT* o_point, BN_CTX* _ctx)
+{
+    unsigned char octets[65];
+    octets[0] = POINT_CONVERSION_UNCOMPRESSED;
+    memcpy(octets + 1, _pub, 64);
+    return EC_POINT_oct2point(_group, o_point, octets, sizeof(octets), _ctx) == 1;
+}
+
+/// write _number as 32 big endian bytes
+void toBytes32(const BIGNUM* _number, unsigned char* o_bytes)
+{
+    int size = BN_num_bytes(_number);
+    memset(o_bytes, 0, 32 - size);
+    BN_bn2bin(_number, o_bytes + 32 - size);
+}
+
+/// SM3(Z || _data), Z is computed from the public key of _key
+bool digest(EC_KEY* _key, const unsigned char* _data, size_t _dataLen, unsigned char* o_digest)
+{
+    size_t zValueLen = SM3_DIGEST_LENGTH;
+    if (!ECDSA_sm2_get_Z((const EC_KEY*)_key, NULL, NULL, 0, o_digest, &zValueLen))
     {
         LOG(ERROR) << "Error Of Compute Z";
-        goto err;
+        return false;
     }
-    // SM3 Degist
+    SM3_CTX sm3Ctx;
     SM3_Init(&sm3Ctx);
-    SM3_Update(&sm3Ctx, zValue, zValueLen);
-    SM3_Update(&sm3Ctx, originalData, originalDataLen);
-    SM3_Final(zValue, &sm3Ctx);
-
-    signData = ECDSA_do_sign_ex(zValue, zValueLen, NULL, NULL, sm2Key);
-    if (signData == NULL)
-    {
-        LOG(ERROR) << "Error Of SM2 Signature";
-        goto err;
-    }
-    rData = BN_bn2hex(signData->r);
-    r = rData;
-    sData = BN_bn2hex(signData->s);
-    s = sData;
+    SM3_Update(&sm3Ctx, o_digest, zValueLen);
+    SM3_Update(&sm3Ctx, _data, _dataLen);
+    SM3_Final(o_digest, &sm3Ctx);
+    return true;
+}
+}  // namespace
 
-    str = "0000000000000000000000000000000000000000000000000000000000000000";
-    if (r.length() < 64)
+SM2::SM2()
+{
+    m_group = EC_GROUP_new_by_curve_name(NID_sm2);
+    if (!m_group)
     {
-        _size = 64 - r.length();
-        _str = str.substr(0, _size);
-        r = _str + r;
+        LOG(ERROR) << "Error Of Gain SM2 Group Object";
+        return;
     }
-    if (s.length() < 64)
+    BN_CTX* ctx = BN_CTX_new();
+    if (!EC_GROUP_precompute_mult(m_group, ctx))
     {
-        _size = 64 - s.length();
-        _str = str.substr(0, _size);
-        s = _str + s;
+        LOG(WARNING) << "Error Of Precompute SM2 Generator Multiples";
     }
-    lresult = true;
-    // LOG(DEBUG)<<"r:"<<r<<" rLen:"<<r.length()<<" s:"<<s<<" sLen:"<<s.length();
-err:
-    if (ctx)
-        BN_CTX_free(ctx);
-    if (sm2Key)
-        EC_KEY_free(sm2Key);
-    if (signData)
-        ECDSA_SIG_free(signData);
-    if (rData)
-        OPENSSL_free(rData);
-    if (sData)
-        OPENSSL_free(sData);
-    return lresult;
+    BN_CTX_free(ctx);
 }
 
-int SM2::verify(const string& _signData, int _signDataLen, const char* originalData,
-    int originalDataLen, const string& publicKey)
+SM2::~SM2()
 {
-    // LOG(DEBUG)<<"_signData:"<<_signData<<" _signDataLen:"<<_signDataLen<<"
-    // originalData:"<<(originalData,originalDataLen)<<"
-    // originalDataLen:"<<originalDataLen<<" publicKey:"<<publicKey;
-    bool lresult = false;
-    SM3_CTX sm3Ctx;
-    EC_KEY* sm2Key = NULL;
-    EC_POINT* pubPoint = NULL;
-    EC_GROUP* sm2Group = NULL;
-    ECDSA_SIG* signData = NULL;
-    unsigned char zValue[SM3_DIGEST_LENGTH];
-    size_t zValueLen = SM3_DIGEST_LENGTH;
-    string r = _signData.substr(0, 64);
-    string s = _signData.substr(64, 64);
-    // LOG(DEBUG)<<"r:"<<r<<" s:"<<s;
+    if (m_group)
+        EC_GROUP_free(m_group);
+}
 
-    sm2Group = EC_GROUP_new_by_curve_name(NID_sm2);
-    if (sm2Group == NULL)
+bool SM2::sign(const unsigned char* _data, size_t _dataLen, const unsigned char* _pri,
+    const unsigned char* _pub, unsigned char* o_sig)
+{
+    auto& ctx = context();
+    if (!ctx.valid())
     {
-        LOG(ERROR) << "ERROR Verify EC_GROUP_new_by_curve_name";
-        goto err;
+        LOG(ERROR) << "Error Of Alloc SM2 Context";
+        return false;
     }
-
-    if ((pubPoint = EC_POINT_new(sm2Group)) == NULL)
+    const EC_GROUP* group = EC_KEY_get0_group(ctx.signKey);
+    // the key keeps its own copy of the private key
+    bool setPrivate =
+        BN_bin2bn(_pri, 32, ctx.number) && EC_KEY_set_private_key(ctx.signKey, ctx.number);
+    BN_clear(ctx.number);
+    if (!setPrivate)
     {
-        LOG(ERROR) << "ERROR Verify EC_POINT_new";
-        goto err;
+        LOG(ERROR) << "Error Of Set SM2 Private Key";
+        return false;
     }
-
-    if (!EC_POINT_hex2point(sm2Group, (const char*)publicKey.c_str(), pubPoint, NULL))
+    if (!toPoint(group, _pub, ctx.point, ctx.bnCtx) ||
+        !EC_KEY_set_public_key(ctx.signKey, ctx.point))
     {
-        LOG(ERROR) << "ERROR Verify EC_POINT_hex2point";
-        goto err;
+        LOG(ERROR) << "Error Of Set SM2 Public Key";
+        return false;
     }
-
-    sm2Key = EC_KEY_new_by_curve_name(NID_sm2);
-
-    if (sm2Key == NULL)
+    unsigned char zValue[SM3_DIGEST_LENGTH];
+    if (!digest(ctx.signKey, _data, _dataLen, zValue))
     {
-        LOG(ERROR) << "ERROR Verify EC_KEY_new_by_curve_name";
-        goto err;
+        return false;
     }
-
-    if (!EC_KEY_set_public_key(sm2Key, pubPoint))
+    ECDSA_SIG* signData = ECDSA_do_sign_ex(zValue, sizeof(zValue), NULL, NULL, ctx.signKey);
+    if (signData == NULL)
     {
-        LOG(ERROR) << "ERROR verify EC_KEY_set_public_key";
-        goto err;
+        LOG(ERROR) << "Error Of SM2 Signature";
+        return false;
     }
+    toBytes32(signData->r, o_sig);
+    toBytes32(signData->s, o_sig + 32);
+    ECDSA_SIG_free(signData);
+    return true;
+}
 
-    if (!ECDSA_sm2_get_Z((const EC_KEY*)sm2Key, NULL, NULL, 0, zValue, &zValueLen))
+bool SM2::verify(const unsigned char* _sig, const unsigned char* _data, size_t _dataLen,
+    const unsigned char* _pub)
+{
+    auto& ctx = context();
+    if (!ctx.valid())
     {
-        LOG(ERROR) << "Error Of Compute Z";
-        goto err;
+        LOG(ERROR) << "Error Of Alloc SM2 Context";
+        return false;
     }
-    // SM3 Degist
-    SM3_Init(&sm3Ctx);
-    SM3_Update(&sm3Ctx, zValue, zValueLen);
-    SM3_Update(&sm3Ctx, originalData, originalDataLen);
-    SM3_Final(zValue, &sm3Ctx);
-
-    /*Now Verify it*/
-    signData = ECDSA_SIG_new();
-    if (!BN_hex2bn(&signData->r, r.c_str()))
+    if (!toPoint(EC_KEY_get0_group(ctx.verifyKey), _pub, ctx.point, ctx.bnCtx) ||
+        !EC_KEY_set_public_key(ctx.verifyKey, ctx.point))
     {
-        LOG(ERROR) << "ERROR BN_hex2bn R:" << r;
-        goto err;
+        LOG(ERROR) << "ERROR Verify EC_KEY_set_public_key";
+        return false;
     }
-
-    if (!BN_hex2bn(&signData->s, s.c_str()))
+    unsigned char zValue[SM3_DIGEST_LENGTH];
+    if (!digest(ctx.verifyKey, _data, _dataLen, zValue))
     {
-        LOG(ERROR) << "ERROR BN_hex2bn S:" << s;
-        goto err;
+        return false;
     }
-
-    if (ECDSA_do_verify(zValue, zValueLen, signData, sm2Key) != 1)
+    if (!BN_bin2bn(_sig, 32, ctx.signature->r) || !BN_bin2bn(_sig + 32, 32, ctx.signature->s))
+    {
+        LOG(ERROR) << "ERROR BN_bin2bn R/S";
+        return false;
+    }
+    if (ECDSA_do_verify(zValue, sizeof(zValue), ctx.signature, ctx.verifyKey) != 1)
     {
         LOG(ERROR) << "Error Of SM2 Verify";
-        goto err;
+        return false;
     }
-    // LOG(DEBUG)<<"SM2 Verify successed.";
-    lresult = true;
-err:
-    if (sm2Key)
-        EC_KEY_free(sm2Key);
-    if (pubPoint)
-        EC_POINT_free(pubPoint);
-    if (signData)
-        ECDSA_SIG_free(signData);
-    if (sm2Group)
-        EC_GROUP_free(sm2Group);
-    return lresult;
+    return true;
 }
 
-string SM2::priToPub(const string& pri)
+bool SM2::priToPub(const unsigned char* _pri, unsigned char* o_pub)
 {
-    EC_KEY* sm2Key = NULL;
-    EC_POINT* pubPoint = NULL;
-    const EC_GROUP* sm2Group = NULL;
-    string pubKey = "";
-    BIGNUM start;
-    BIGNUM* res;
-    BN_CTX* ctx;
-    BN_init(&start);
-    ctx = BN_CTX_new();
-    char* pub = NULL;
-    // LOG(DEBUG)<<"pri:"<<pri;
-    res = &start;
-    BN_hex2bn(&res, (const char*)pri.c_str());
-    sm2Key = EC_KEY_new_by_curve_name(NID_sm2);
-    if (!EC_KEY_set_private_key(sm2Key, res))
+    auto& ctx = context();
+    if (!ctx.valid())
     {
-        LOG(ERROR) << "Error PriToPub EC_KEY_set_private_key";
-        goto err;
+        LOG(ERROR) << "Error Of Alloc SM2 Context";
+        return false;
     }
-
-    sm2Group = EC_KEY_get0_group(sm2Key);
-    pubPoint = EC_POINT_new(sm2Group);
-
-    if (!EC_POINT_mul(sm2Group, pubPoint, res, NULL, NULL, ctx))
+    const EC_GROUP* group = EC_KEY_get0_group(ctx.signKey);
+    bool multiplied = BN_bin2bn(_pri, 32, ctx.number) &&
+                      EC_POINT_mul(group, ctx.point, ctx.number, NULL, NULL, ctx.bnCtx);
+    BN_clear(ctx.number);
+    if (!multiplied)
     {
         LOG(ERROR) << "Error PriToPub EC_POINT_mul.";
-        goto err;
+        return false;
     }
-
-    pub = EC_POINT_point2hex(sm2Group, pubPoint, POINT_CONVERSION_UNCOMPRESSED, ctx);
-    pubKey = pub;
-    pubKey = pubKey.substr(2, 128);
-    pubKey = strlower((char*)pubKey.c_str());
-    // LOG(DEBUG)<<"PriToPub:"<<pubKey << "PriToPubLen:" << pubKey.length();
-err:
-    if (pub)
-        OPENSSL_free(pub);
-    if (ctx)
-        BN_CTX_free(ctx);
-    if (sm2Key)
-        EC_KEY_free(sm2Key);
-    if (pubPoint)
-        EC_POINT_free(pubPoint);
-    return pubKey;
+    unsigned char octets[65];
+    if (EC_POINT_point2oct(group, ctx.point, POINT_CONVERSION_UNCOMPRESSED, octets,
+            sizeof(octets), ctx.bnCtx) != sizeof(octets))
+    {
+        LOG(ERROR) << "Error PriToPub EC_POINT_point2oct.";
+        return false;
+    }
+    memcpy(o_pub, octets + 1, 64);
+    return true;
 }
 
 char* SM2::strlower(char* s)
@@ -32,16 +32,30 @@ public:
     bool genKey();
     string getPublicKey();
     string getPrivateKey();
-    bool sign(const char* originalData, int originalDataLen, const string& privateKey, string& r,
-        string& s);
-    int verify(const string& signData, int signDataLen, const char* originalData,
-        int originalDataLen, const string& publicKey);
-    string priToPub(const string& privateKey);
+    /// sign SM3(Z || _data), keys and signatures are raw big endian bytes, no hex round trip
+    /// @param _pri 32 bytes private key
+    /// @param _pub 64 bytes public key (x || y) of _pri, used for Z
+    /// @param o_sig 64 bytes r || s
+    bool sign(const unsigned char* _data, size_t _dataLen, const unsigned char* _pri,
+        const unsigned char* _pub, unsigned char* o_sig);
+    /// @param _sig 64 bytes r || s
+    /// @param _pub 64 bytes public key (x || y)
+    bool verify(const unsigned char* _sig, const unsigned char* _data, size_t _dataLen,
+        const unsigned char* _pub);
+    /// @param o_pub 64 bytes x || y of _pri * G
+    bool priToPub(const unsigned char* _pri, unsigned char* o_pub);
     char* strlower(char* s);
     string ascii2hex(const char* chs, int len);
     static SM2& getInstance();
 
+    /// the SM2 group with the multiples of the generator precomputed, read only
+    const EC_GROUP* group() const { return m_group; }
+
 private:
+    SM2();
+    ~SM2();
+
     string publicKey;
     string privateKey;
+    EC_GROUP* m_group = NULL;
 };
\ No newline at end of file
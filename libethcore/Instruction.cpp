@@ -218,6 +218,10 @@ static const std::map<Instruction, InstructionInfo> c_instructionInfo = {
     {Instruction::PUSHC, {"PUSHC", 0, 1, Tier::VeryLow}},
     {Instruction::JUMPC, {"JUMPC", 1, 0, Tier::Mid}},
     {Instruction::JUMPCI, {"JUMPCI", 2, 0, Tier::High}},
+    {Instruction::PUSH2JUMP, {"PUSH2JUMP", 0, 0, Tier::Special}},
+    {Instruction::PUSH2JUMPI, {"PUSH2JUMPI", 1, 0, Tier::Special}},
+    {Instruction::PUSH1MSTORE, {"PUSH1MSTORE", 1, 0, Tier::Special}},
+    {Instruction::SWAP1POP, {"SWAP1POP", 2, 1, Tier::Special}},
 };
 
 InstructionInfo instructionInfo(Instruction _inst)
@@ -173,6 +173,11 @@ enum class Instruction : uint8_t
     LOG4,         ///< Makes a log entry; 4 topics.
 
     // these are generated by the interpreter - should never be in user code
+    PUSH2JUMP = 0xa5,  ///< PUSH2 followed by a pre-verified JUMP
+    PUSH2JUMPI,        ///< PUSH2 followed by a pre-verified JUMPI
+    PUSH1MSTORE,       ///< PUSH1 followed by MSTORE
+    SWAP1POP,          ///< SWAP1 followed by POP
+
     PUSHC = 0xac,  ///< push value from constant pool
     JUMPC,         ///< alter the program counter - pre-verified
     JUMPCI,        ///< conditionally alter the program counter - pre-verified
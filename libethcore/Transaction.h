@@ -46,7 +46,8 @@ enum class CheckTransaction
     Cheap,
     Everything
 };
-/// function called after the transaction has been submitted
+/// function called after the transaction has been committed, with a null receipt if the
+/// transaction pool drops it
 using RPCCallback = std::function<void(LocalisedTransactionReceipt::Ptr)>;
 /// Encodes a transaction, ready to be exported to or freshly imported from RLP.
 /// Remove m_chainId ,EIP155 value for calculating transaction hash
@@ -194,6 +195,12 @@ public:
     /// Sets the utc time at which a transaction enters the queue.
     void setImportTime(u256 _t) { m_importTime = _t; }
 
+    /// @returns the order in which a transaction enters the queue, breaks ties of importTime().
+    uint64_t importSeq() const { return m_importSeq; }
+
+    /// Sets the order in which a transaction enters the queue.
+    void setImportSeq(uint64_t _seq) { m_importSeq = _seq; }
+
     /// @returns true if the transaction was signed
     bool hasSignature() const { return m_vrs.is_initialized(); }
 
@@ -264,6 +271,7 @@ protected:
     mutable Address m_sender;                ///< Cached sender, determined from signature.
     u256 m_blockLimit;            ///< The latest block number to be packaged for transaction.
     u256 m_importTime = u256(0);  ///< The utc time at which a transaction enters the queue.
+    uint64_t m_importSeq = 0;     ///< The order in which a transaction enters the queue.
 
     RPCCallback m_rpcCallback;
 };
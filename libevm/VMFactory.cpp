@@ -24,7 +24,9 @@
 #include "VMFactory.h"
 #include "EVMC.h"
 
+#include <libdevcore/easylog.h>
 #include <libinterpreter/interpreter.h>
+#include <boost/algorithm/string.hpp>
 
 #include <evmc/loader.h>
 
@@ -46,6 +48,9 @@ namespace
 {
 auto g_kind = VMKind::Interpreter;
 
+/// The name or path the global kind was selected with.
+std::string g_vmName = "interpreter";
+
 /// The pointer to EVMC create function in DLL EVMC VM.
 ///
 /// This variable is only written once when processing command line arguments,
@@ -83,6 +88,7 @@ void setVMKind(const std::string& _name)
         if (_name == entry.name)
         {
             g_kind = entry.kind;
+            g_vmName = _name;
             return;
         }
     }
@@ -104,7 +110,16 @@ void setVMKind(const std::string& _name)
             std::system_error(std::error_code(static_cast<int>(ec), std::generic_category()),
                 "loading " + _name + " failed"));
     }
+    // EVMC asserts the ABI version of every instance, check it once here instead
+    evmc_instance* instance = g_evmcCreateFn();
+    auto abiVersion = instance ? instance->abi_version : -1;
+    if (instance && instance->destroy)
+        instance->destroy(instance);
+    if (abiVersion != EVMC_ABI_VERSION)
+        BOOST_THROW_EXCEPTION(std::runtime_error("loading " + _name + " failed: EVMC ABI version " +
+                                                 std::to_string(abiVersion) + " not supported"));
     g_kind = VMKind::DLL;
+    g_vmName = _name;
 }
 }  // namespace
 
@@ -180,6 +195,35 @@ std::unique_ptr<VMFace> VMFactory::create()
     return create(g_kind);
 }
 
+bool VMFactory::setDefaultVM(std::string const& _nameOrPath, std::string const& _evmcOptions)
+{
+    try
+    {
+        std::vector<std::string> options;
+        boost::split(options, _evmcOptions, boost::is_any_of(","));
+        for (auto& option : options)
+            boost::trim(option);
+        options.erase(std::remove(options.begin(), options.end(), ""), options.end());
+        parseEvmcOptions(options);
+        setVMKind(_nameOrPath);
+        LOG(INFO) << "[#VMFactory] use vm: " << _nameOrPath;
+        return true;
+    }
+    catch (std::exception const& e)
+    {
+        LOG(ERROR) << "[#VMFactory] load vm failed, fallback to interpreter, [vm/EINFO]: "
+                   << _nameOrPath << "/" << boost::diagnostic_information(e);
+        g_kind = VMKind::Interpreter;
+        g_vmName = "interpreter";
+        return false;
+    }
+}
+
+std::string const& VMFactory::defaultVM()
+{
+    return g_vmName;
+}
+
 std::unique_ptr<VMFace> VMFactory::create(VMKind _kind)
 {
     switch (_kind)
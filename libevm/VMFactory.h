@@ -59,6 +59,16 @@ public:
 
     /// Creates a VM instance of the kind provided.
     static std::unique_ptr<VMFace> create(VMKind _kind);
+
+    /// Selects the VM used by create(): a name of the builtin VMs or the path of an EVMC module,
+    /// with the EVMC options given as "name=value,name2=value2".
+    /// @return false if the module can't be loaded or an option has no value, the interpreter is
+    /// selected instead
+    static bool setDefaultVM(
+        std::string const& _nameOrPath, std::string const& _evmcOptions = std::string());
+
+    /// @return the name or path passed to the last successful setDefaultVM()
+    static std::string const& defaultVM();
 };
 }  // namespace eth
 }  // namespace dev
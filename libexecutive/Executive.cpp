@@ -143,6 +143,7 @@ bool Executive::call(CallParameters const& _p, u256 const& _gasPrice, Address co
 
     m_savepoint = m_s->savepoint();
     m_tableFactorySavepoint = m_envInfo.precompiledEngine()->getMemoryTableFactory()->savepoint();
+    m_precompiledSavepoint = m_envInfo.precompiledEngine()->temporaryPrecompiledSavepoint();
     if (m_envInfo.precompiledEngine() &&
         m_envInfo.precompiledEngine()->isOrginPrecompiled(_p.codeAddress))
     {
@@ -226,6 +227,7 @@ bool Executive::executeCreate(Address const& _sender, u256 const& _endowment, u2
 
     m_savepoint = m_s->savepoint();
     m_tableFactorySavepoint = m_envInfo.precompiledEngine()->getMemoryTableFactory()->savepoint();
+    m_precompiledSavepoint = m_envInfo.precompiledEngine()->temporaryPrecompiledSavepoint();
 
     m_isCreation = true;
 
@@ -409,4 +411,5 @@ void Executive::revert()
     m_s->rollback(m_savepoint);
     auto memoryTableFactory = m_envInfo.precompiledEngine()->getMemoryTableFactory();
     memoryTableFactory->rollback(m_tableFactorySavepoint);
+    m_envInfo.precompiledEngine()->rollbackTemporaryPrecompiled(m_precompiledSavepoint);
 }
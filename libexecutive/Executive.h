@@ -198,6 +198,7 @@ private:
     Address m_newAddress;
     size_t m_savepoint = 0;
     size_t m_tableFactorySavepoint = 0;
+    size_t m_precompiledSavepoint = 0;
 };
 
 }  // namespace executive
@@ -181,6 +181,8 @@ evmc_status_code transactionExceptionToEvmcStatusCode(TransactionException ex) n
 
 evmc_result ExtVM::call(CallParameters& _p)
 {
+    // the callee may read or write the storage of this contract
+    clearStorageCache();
     Executive e{m_s, envInfo(), depth() + 1};
     if (!e.call(_p, gasPrice(), origin()))
     {
@@ -210,18 +212,40 @@ h256 ExtVM::codeHashAt(Address _a)
     return exists(_a) ? m_s->codeHash(_a) : h256{};
 }
 
+u256 ExtVM::store(u256 _n)
+{
+    auto it = m_slots.find(_n);
+    if (it != m_slots.end())
+        return it->second;
+    auto value = m_s->storage(myAddress(), _n);
+    m_slots.emplace(_n, value);
+    return value;
+}
+
 void ExtVM::setStore(u256 _n, u256 _v)
 {
     // check authority by tx.origin
-    if (!m_s->checkAuthority(origin(), myAddress()))
+    if (!m_storeAuthorized)
+        m_storeAuthorized = m_s->checkAuthority(origin(), myAddress());
+    if (!*m_storeAuthorized)
         BOOST_THROW_EXCEPTION(PermissionDenied());
 
+    // written through so the state records and rolls back every write as before
     m_s->setStorage(myAddress(), _n, _v);
+    m_slots[_n] = _v;
+}
+
+void ExtVM::clearStorageCache()
+{
+    m_slots.clear();
+    // authorities may be changed by the next frame
+    m_storeAuthorized = boost::none;
 }
 
 evmc_result ExtVM::create(u256 _endowment, u256& io_gas, bytesConstRef _code, Instruction _op,
     u256 _salt, OnOpFunc const& _onOp)
 {
+    clearStorageCache();
     Executive e{m_s, envInfo(), depth() + 1};
     bool result = false;
     if (_op == Instruction::CREATE)
@@ -32,8 +32,11 @@
 #include <libethcore/Common.h>
 #include <libethcore/EVMSchedule.h>
 #include <libevm/ExtVMFace.h>
+#include <boost/functional/hash.hpp>
+#include <boost/optional.hpp>
 #include <functional>
 #include <map>
+#include <unordered_map>
 
 
 namespace dev
@@ -59,12 +62,15 @@ public:
         assert(m_s->addressInUse(_myAddress));
     }
 
-    /// Read storage location.
-    u256 store(u256 _n) final { return m_s->storage(myAddress(), _n); }
+    /// Read storage location, served from the slot cache of this call frame when possible.
+    u256 store(u256 _n) final;
 
-    /// Write a value in storage.
+    /// Write a value in storage, through to the state and into the slot cache.
     void setStore(u256 _n, u256 _v) final;
 
+    /// Empty the slot cache, called before another frame may change the storage of this contract.
+    void clearStorageCache();
+
     /// Read address's code.
     bytes const codeAt(Address _a) final { return m_s->code(_a); }
 
@@ -105,7 +111,21 @@ public:
     h256 blockHash(int64_t _number) final;
 
 private:
+    struct SlotHash
+    {
+        // all limbs, as mapping slots are keccak hashes of caller chosen keys and the low 64 bits
+        // alone can be collided on purpose to degrade the map
+        size_t operator()(u256 const& _slot) const
+        {
+            auto const& backend = _slot.backend();
+            return boost::hash_range(backend.limbs(), backend.limbs() + backend.size());
+        }
+    };
     std::shared_ptr<StateFace> m_s;  ///< A reference to the base state.
+    /// values of the storage slots read or written by this frame
+    std::unordered_map<u256, u256, SlotHash> m_slots;
+    /// result of the authority check of tx.origin on this contract
+    boost::optional<bool> m_storeAuthorized;
 };
 
 }  // namespace executive
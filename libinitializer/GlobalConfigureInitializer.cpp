@@ -22,6 +22,7 @@
 
 
 #include "GlobalConfigureInitializer.h"
+#include <libevm/VMFactory.h>
 
 using namespace std;
 using namespace dev;
@@ -41,4 +42,8 @@ void GlobalConfigureInitializer::initConfig(const boost::property_tree::ptree& _
                            << g_BCOSConfig.diskEncryption.keyCenterIP << ":"
                            << g_BCOSConfig.diskEncryption.keyCenterPort << "/"
                            << g_BCOSConfig.diskEncryption.cipherDataKey << std::endl;
+
+    // "interpreter" or the path of an EVMC module, fallback to the interpreter if loading fails
+    eth::VMFactory::setDefaultVM(_pt.get<std::string>("evm.vm", "interpreter"),
+        _pt.get<std::string>("evm.evmc_options", ""));
 }
@@ -21,6 +21,8 @@
  */
 
 #include "RPCInitializer.h"
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
 
 using namespace dev;
 using namespace dev::initializer;
@@ -30,7 +32,9 @@ void RPCInitializer::initConfig(boost::property_tree::ptree const& _pt)
     std::string listenIP = _pt.get<std::string>("rpc.listen_ip", "0.0.0.0");
     int listenPort = _pt.get<int>("rpc.channel_listen_port", 30301);
     int httpListenPort = _pt.get<int>("rpc.jsonrpc_listen_port", 0);
-    if (!isValidPort(listenPort) || !isValidPort(httpListenPort))
+    int webSocketListenPort = _pt.get<int>("rpc.websocket_listen_port", 0);
+    if (!isValidPort(listenPort) || !isValidPort(httpListenPort) ||
+        (webSocketListenPort && !isValidPort(webSocketListenPort)))
     {
         INITIALIZER_LOG(ERROR) << "[#RPCInitializer] initConfig for RPCInitializer failed";
         ERROR_OUTPUT << "[#RPCInitializer] initConfig for RPCInitializer failed! Invalid "
@@ -61,20 +65,53 @@ void RPCInitializer::initConfig(boost::property_tree::ptree const& _pt)
 
         m_channelRPCServer->setChannelServer(server);
 
+        /// the committed blocks and their logs are pushed to the filters of the channel clients
+        m_channelSubscriptions = std::make_shared<dev::channel::ChannelSubscriptions>();
+        for (auto groupID : m_ledgerManager->getGrouplList())
+        {
+            m_channelSubscriptions->addGroup(groupID, m_ledgerManager->blockChain(groupID));
+        }
+        m_channelSubscriptions->start();
+        m_channelRPCServer->setSubscriptions(m_channelSubscriptions);
+
         auto rpcEntity = new rpc::Rpc(m_ledgerManager, m_p2pService);
         m_channelRPCHttpServer = new ModularServer<rpc::Rpc>(rpcEntity);
         m_channelRPCHttpServer->addConnector(m_channelRPCServer.get());
         m_channelRPCHttpServer->StartListening();
         INITIALIZER_LOG(INFO) << "ChannelRPCHttpServer started.";
 
-        /// init httpListenPort
+        /// the block, transaction and receipt results of the committed blocks are cached
+        size_t responseCacheMB = _pt.get<size_t>("rpc.response_cache_mb", 64);
+        if (responseCacheMB)
+        {
+            rpcEntity->setResponseCache(
+                std::make_shared<rpc::ResponseCache>(responseCacheMB << 20));
+        }
+
+        /// init httpListenPort, the http connections share the io_service of the channelServer
         ///< Donot to set destructions, the ModularServer will destruct.
-        m_safeHttpServer.reset(
-            new SafeHttpServer(listenIP, httpListenPort), [](SafeHttpServer* p) { (void)p; });
+        m_httpServer.reset(new rpc::AsyncHttpServer(listenIP, httpListenPort, ioService,
+                               createDispatcher(_pt, rpcEntity)),
+            [](rpc::AsyncHttpServer* p) { (void)p; });
         m_jsonrpcHttpServer = new ModularServer<rpc::Rpc>(rpcEntity);
-        m_jsonrpcHttpServer->addConnector(m_safeHttpServer.get());
+        m_jsonrpcHttpServer->addConnector(m_httpServer.get());
         m_jsonrpcHttpServer->StartListening();
         INITIALIZER_LOG(INFO) << "JsonrpcHttpServer started.";
+
+        /// init webSocketListenPort on the same io_service, with workers of its own
+        if (webSocketListenPort)
+        {
+            m_webSocketServer = std::make_shared<rpc::WebSocketServer>(
+                listenIP, webSocketListenPort, ioService, createDispatcher(_pt, rpcEntity));
+            for (auto groupID : m_ledgerManager->getGrouplList())
+            {
+                m_webSocketServer->addGroup(groupID, m_ledgerManager->blockChain(groupID));
+            }
+            m_jsonrpcWebSocketServer = new ModularServer<rpc::Rpc>(rpcEntity);
+            m_jsonrpcWebSocketServer->addConnector(m_webSocketServer);
+            m_jsonrpcWebSocketServer->StartListening();
+            INITIALIZER_LOG(INFO) << "JsonrpcWebSocketServer started.";
+        }
     }
     catch (std::exception& e)
     {
@@ -85,3 +122,58 @@ void RPCInitializer::initConfig(boost::property_tree::ptree const& _pt)
         exit(1);
     }
 }
+
+/// a dispatcher per connector, the connectors set their own handler on it
+rpc::RpcDispatcher::Ptr RPCInitializer::createDispatcher(
+    boost::property_tree::ptree const& _pt, rpc::Rpc* _rpcEntity)
+{
+    auto dispatcher =
+        std::make_shared<rpc::RpcDispatcher>(_pt.get<size_t>("rpc.jsonrpc_worker_threads", 8),
+            _pt.get<size_t>("rpc.jsonrpc_max_pending", 4096));
+    initMethodLimits(_pt, dispatcher);
+    /// the large block and receipt responses skip the Json::Value tree
+    std::map<std::string, bool (rpc::Rpc::*)(Json::Value const&, rpc::JsonWriter&)> rawMethods = {
+        {"getBlockByHash", &rpc::Rpc::writeBlockByHash},
+        {"getBlockByNumber", &rpc::Rpc::writeBlockByNumber},
+        {"getTransactionByHash", &rpc::Rpc::writeTransactionByHash},
+        {"getTransactionByBlockNumberAndIndex", &rpc::Rpc::writeTransactionByBlockNumberAndIndex},
+        {"getTransactionReceipt", &rpc::Rpc::writeTransactionReceipt}};
+    for (auto const& method : rawMethods)
+    {
+        dispatcher->setRawMethod(method.first,
+            std::bind(method.second, _rpcEntity, std::placeholders::_1, std::placeholders::_2));
+    }
+    /// the batches waiting for their receipts do not hold a worker
+    dispatcher->setAsyncMethod("sendRawTransactions",
+        std::bind(&rpc::Rpc::sendRawTransactionsAsync, _rpcEntity, std::placeholders::_1,
+            std::placeholders::_2));
+    return dispatcher;
+}
+
+/// rpc.jsonrpc_method_limits: comma separated method=maxConcurrentCalls, e.g. call=4
+void RPCInitializer::initMethodLimits(
+    boost::property_tree::ptree const& _pt, rpc::RpcDispatcher::Ptr _dispatcher)
+{
+    std::string limits = _pt.get<std::string>("rpc.jsonrpc_method_limits", "");
+    std::vector<std::string> pairs;
+    boost::split(pairs, limits, boost::is_any_of(","), boost::token_compress_on);
+    for (auto& pair : pairs)
+    {
+        boost::trim(pair);
+        auto separatorPos = pair.find('=');
+        if (separatorPos == std::string::npos)
+        {
+            continue;
+        }
+        try
+        {
+            _dispatcher->setMethodLimit(pair.substr(0, separatorPos),
+                boost::lexical_cast<size_t>(pair.substr(separatorPos + 1)));
+        }
+        catch (boost::bad_lexical_cast const&)
+        {
+            INITIALIZER_LOG(WARNING) << "[#initMethodLimits] invalid limit: " << pair;
+        }
+    }
+    INITIALIZER_LOG(INFO) << "[#initMethodLimits] [limits]: " << limits;
+}
@@ -26,8 +26,9 @@
 #include <libchannelserver/ChannelRPCServer.h>
 #include <libledger/LedgerManager.h>
 #include <libp2p/P2PInterface.h>
+#include <librpc/AsyncHttpServer.h>
 #include <librpc/Rpc.h>
-#include <librpc/SafeHttpServer.h>
+#include <librpc/WebSocketServer.h>
 
 namespace dev
 {
@@ -40,6 +41,10 @@ public:
 
     virtual ~RPCInitializer()
     {
+        if (m_channelSubscriptions)
+        {
+            m_channelSubscriptions->stop();
+        }
         if (m_channelRPCHttpServer)
         {
             m_channelRPCHttpServer->StopListening();
@@ -50,6 +55,11 @@ public:
             m_jsonrpcHttpServer->StopListening();
             INITIALIZER_LOG(INFO) << "JsonrpcHttpServer stoped.";
         }
+        if (m_jsonrpcWebSocketServer)
+        {
+            m_jsonrpcWebSocketServer->StopListening();
+            INITIALIZER_LOG(INFO) << "JsonrpcWebSocketServer stoped.";
+        }
     };
 
     void initConfig(boost::property_tree::ptree const& _pt);
@@ -67,13 +77,21 @@ public:
     }
 
 private:
+    void initMethodLimits(
+        boost::property_tree::ptree const& _pt, rpc::RpcDispatcher::Ptr _dispatcher);
+    rpc::RpcDispatcher::Ptr createDispatcher(
+        boost::property_tree::ptree const& _pt, rpc::Rpc* _rpcEntity);
+
     std::shared_ptr<p2p::P2PInterface> m_p2pService;
     std::shared_ptr<ledger::LedgerManager> m_ledgerManager;
     std::shared_ptr<boost::asio::ssl::context> m_sslContext;
-    std::shared_ptr<dev::SafeHttpServer> m_safeHttpServer;
+    std::shared_ptr<rpc::AsyncHttpServer> m_httpServer;
+    std::shared_ptr<rpc::WebSocketServer> m_webSocketServer;
     ChannelRPCServer::Ptr m_channelRPCServer;
+    dev::channel::ChannelSubscriptions::Ptr m_channelSubscriptions;
     ModularServer<>* m_channelRPCHttpServer;
     ModularServer<>* m_jsonrpcHttpServer;
+    ModularServer<>* m_jsonrpcWebSocketServer = nullptr;
 };
 
 }  // namespace initializer
@@ -0,0 +1,104 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/** @file AnalysedCode.cpp
+ */
+
+#include "AnalysedCode.h"
+
+using namespace dev;
+using namespace dev::eth;
+
+AnalysedCodeCache& AnalysedCodeCache::instance()
+{
+    static AnalysedCodeCache s_cache;
+    return s_cache;
+}
+
+AnalysedCode::Ptr AnalysedCodeCache::get(h256 const& _codeHash, size_t _codeSize)
+{
+    Guard l(x_codes);
+    auto it = m_index.find(_codeHash);
+    if (it == m_index.end() || it->second->second->codeSize != _codeSize)
+    {
+        ++m_misses;
+        return nullptr;
+    }
+    m_codes.splice(m_codes.begin(), m_codes, it->second);
+    ++m_hits;
+    return it->second->second;
+}
+
+void AnalysedCodeCache::put(h256 const& _codeHash, AnalysedCode::Ptr _code)
+{
+    Guard l(x_codes);
+    auto it = m_index.find(_codeHash);
+    if (it != m_index.end())
+    {
+        m_memorySize -= it->second->second->memorySize();
+        m_codes.erase(it->second);
+        m_index.erase(it);
+    }
+    m_memorySize += _code->memorySize();
+    m_codes.emplace_front(_codeHash, std::move(_code));
+    m_index[_codeHash] = m_codes.begin();
+    evict();
+}
+
+void AnalysedCodeCache::evict()
+{
+    // keep at least the newest entry, a single contract larger than the limit is still shared
+    while (m_memorySize > m_capacity && m_codes.size() > 1)
+    {
+        auto& last = m_codes.back();
+        m_memorySize -= last.second->memorySize();
+        m_index.erase(last.first);
+        m_codes.pop_back();
+    }
+}
+
+void AnalysedCodeCache::setCapacity(size_t _capacity)
+{
+    Guard l(x_codes);
+    m_capacity = _capacity;
+    evict();
+}
+
+size_t AnalysedCodeCache::capacity() const
+{
+    Guard l(x_codes);
+    return m_capacity;
+}
+
+size_t AnalysedCodeCache::size() const
+{
+    Guard l(x_codes);
+    return m_codes.size();
+}
+
+size_t AnalysedCodeCache::memorySize() const
+{
+    Guard l(x_codes);
+    return m_memorySize;
+}
+
+void AnalysedCodeCache::clear()
+{
+    Guard l(x_codes);
+    m_codes.clear();
+    m_index.clear();
+    m_memorySize = 0;
+}
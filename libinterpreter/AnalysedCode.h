@@ -0,0 +1,90 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/** @file AnalysedCode.h
+ */
+
+#pragma once
+
+#include <libdevcore/Common.h>
+#include <libdevcore/FixedHash.h>
+#include <libdevcore/Guards.h>
+#include <atomic>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+namespace dev
+{
+namespace eth
+{
+/// Bytecode prepared by the interpreter: code padded (and rewritten with PUSHC/JUMPC/JUMPCI and
+/// fused instructions when EVM_DO_FIRST_PASS_OPTIMIZATION is on), sorted JUMPDEST table and
+/// constant pool.
+/// Immutable once built, so one copy is shared by every VM running the same contract.
+struct AnalysedCode
+{
+    typedef std::shared_ptr<AnalysedCode const> Ptr;
+
+    /// size of the original code, the padding is not included
+    size_t codeSize = 0;
+    bytes code;
+    std::vector<uint64_t> jumpDests;
+    std::vector<u256> pool;
+
+    size_t memorySize() const
+    {
+        return sizeof(AnalysedCode) + code.capacity() + jumpDests.capacity() * sizeof(uint64_t) +
+               pool.capacity() * sizeof(u256);
+    }
+};
+
+/// Process-wide LRU cache of analysed code keyed by code hash, bounded by memory size.
+class AnalysedCodeCache
+{
+public:
+    static AnalysedCodeCache& instance();
+
+    /// @return the cached code or nullptr; an entry whose size differs from _codeSize is ignored
+    AnalysedCode::Ptr get(h256 const& _codeHash, size_t _codeSize);
+    void put(h256 const& _codeHash, AnalysedCode::Ptr _code);
+
+    /// memory limit in bytes, evicts least recently used code when exceeded
+    void setCapacity(size_t _capacity);
+    size_t capacity() const;
+    size_t size() const;
+    size_t memorySize() const;
+    uint64_t hits() const { return m_hits; }
+    uint64_t misses() const { return m_misses; }
+    void clear();
+
+private:
+    AnalysedCodeCache() = default;
+    void evict();
+
+    typedef std::list<std::pair<h256, AnalysedCode::Ptr>> CodeList;
+    /// most recently used first
+    CodeList m_codes;
+    std::unordered_map<h256, CodeList::iterator> m_index;
+    size_t m_capacity = 64 * 1024 * 1024;
+    size_t m_memorySize = 0;
+    std::atomic<uint64_t> m_hits = {0};
+    std::atomic<uint64_t> m_misses = {0};
+    mutable Mutex x_codes;
+};
+
+}  // namespace eth
+}  // namespace dev
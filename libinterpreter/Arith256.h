@@ -0,0 +1,157 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/** @file Arith256.h
+ */
+
+#pragma once
+
+#include "VMConfig.h"
+
+#include <libdevcore/Common.h>
+#include <cstring>
+
+#if EVM_NATIVE_ARITH
+
+namespace dev
+{
+namespace eth
+{
+/// 256 bit arithmetic on four 64 bit limbs with 128 bit carries, results wrap around 2^256
+/// like the EVM. Only used by the interpreter for the hot opcodes, values are loaded from
+/// and stored to the u256 stack items directly through their limbs.
+namespace arith
+{
+typedef unsigned __int128 uint128;
+
+/// little endian limbs
+struct uint256
+{
+    uint64_t w[4];
+};
+
+static_assert(sizeof(boost::multiprecision::limb_type) == sizeof(uint64_t),
+    "EVM_NATIVE_ARITH needs 64 bit limbs in boost::multiprecision");
+
+inline uint256 load(u256 const& _v)
+{
+    uint256 r{{0, 0, 0, 0}};
+    auto const& backend = _v.backend();
+    std::memcpy(r.w, backend.limbs(), backend.size() * sizeof(uint64_t));
+    return r;
+}
+
+inline void store(u256& o_v, uint256 const& _v)
+{
+    auto& backend = o_v.backend();
+    backend.resize(4, 4);
+    std::memcpy(backend.limbs(), _v.w, sizeof(_v.w));
+    backend.normalize();
+}
+
+inline bool isZero(uint256 const& _a)
+{
+    return (_a.w[0] | _a.w[1] | _a.w[2] | _a.w[3]) == 0;
+}
+
+inline bool lessThan(uint256 const& _a, uint256 const& _b)
+{
+    for (int i = 3; i >= 0; --i)
+    {
+        if (_a.w[i] != _b.w[i])
+            return _a.w[i] < _b.w[i];
+    }
+    return false;
+}
+
+/// @param o_carry set if the sum wrapped around 2^256
+inline uint256 add(uint256 const& _a, uint256 const& _b, bool& o_carry)
+{
+    uint256 r;
+    uint128 carry = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        carry += uint128(_a.w[i]) + _b.w[i];
+        r.w[i] = uint64_t(carry);
+        carry >>= 64;
+    }
+    o_carry = carry != 0;
+    return r;
+}
+
+inline uint256 add(uint256 const& _a, uint256 const& _b)
+{
+    bool carry;
+    return add(_a, _b, carry);
+}
+
+inline uint256 sub(uint256 const& _a, uint256 const& _b)
+{
+    uint256 r;
+    uint64_t borrow = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        uint64_t d = _a.w[i] - _b.w[i];
+        uint64_t borrowOut = _a.w[i] < _b.w[i];
+        r.w[i] = d - borrow;
+        borrow = borrowOut | (d < borrow);
+    }
+    return r;
+}
+
+/// @return _a * _b truncated to 256 bits, the limbs above are never computed
+inline uint256 mul(uint256 const& _a, uint256 const& _b)
+{
+    uint256 r{{0, 0, 0, 0}};
+    for (int i = 0; i < 4; ++i)
+    {
+        // (2^64-1)^2 + 2 * (2^64-1) fits in 128 bits
+        uint128 carry = 0;
+        for (int j = 0; i + j < 4; ++j)
+        {
+            carry += uint128(_a.w[i]) * _b.w[j] + r.w[i + j];
+            r.w[i + j] = uint64_t(carry);
+            carry >>= 64;
+        }
+    }
+    return r;
+}
+
+/// exponentiation by squaring, stops at the highest bit set in _exponent
+inline uint256 exp(uint256 _base, uint256 const& _exponent)
+{
+    uint256 result{{1, 0, 0, 0}};
+    int top = 3;
+    while (top >= 0 && _exponent.w[top] == 0)
+        --top;
+    for (int i = 0; i <= top; ++i)
+    {
+        uint64_t e = _exponent.w[i];
+        for (int bit = 0; bit < 64 && (i < top || e); ++bit, e >>= 1)
+        {
+            if (e & 1)
+                result = mul(result, _base);
+            _base = mul(_base, _base);
+        }
+    }
+    return result;
+}
+
+}  // namespace arith
+}  // namespace eth
+}  // namespace dev
+
+#endif
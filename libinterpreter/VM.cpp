@@ -127,9 +127,14 @@ namespace dev
 {
 namespace eth
 {
-uint64_t VM::memNeed(u256 _offset, u256 _size)
+uint64_t VM::memNeed(u256 const& _offset, u256 const& _size)
 {
-    return toInt63(_size ? u512(_offset) + _size : u512(0));
+    if (!_size)
+        return 0;
+    // the sum of two 63 bit values can't overflow 64 bits, no need to widen to u512
+    if (_offset > 0x7FFFFFFFFFFFFFFF || _size > 0x7FFFFFFFFFFFFFFF)
+        throwOutOfGas();
+    return toInt63(uint64_t(_offset) + uint64_t(_size));
 }
 
 template <class S>
@@ -193,11 +198,16 @@ void VM::adjustStack(int _removed, int _added)
         throwBadStack(_removed, _added);
 }
 
-uint64_t VM::gasForMem(u512 _size)
+uint64_t VM::gasForMem(uint64_t _size)
 {
     constexpr int64_t memoryGas = VMSchedule::memoryGas;
     constexpr int64_t quadCoeffDiv = VMSchedule::quadCoeffDiv;
+#if EVM_NATIVE_ARITH
+    // _size is below 2^64, the square of the word count fits in 128 bits
+    arith::uint128 s = _size / 32;
+#else
     u512 s = _size / 32;
+#endif
     return toInt63(memoryGas * s + s * s / quadCoeffDiv);
 }
 
@@ -572,7 +582,11 @@ void VM::interpretCases()
             updateIOGas();
 
             // pops two items and pushes their sum mod 2^256.
+#if EVM_NATIVE_ARITH
+            arith::store(m_SPP[0], arith::add(arith::load(m_SP[0]), arith::load(m_SP[1])));
+#else
             m_SPP[0] = m_SP[0] + m_SP[1];
+#endif
         }
         NEXT
 
@@ -582,7 +596,11 @@ void VM::interpretCases()
             updateIOGas();
 
             // pops two items and pushes their product mod 2^256.
+#if EVM_NATIVE_ARITH
+            arith::store(m_SPP[0], arith::mul(arith::load(m_SP[0]), arith::load(m_SP[1])));
+#else
             m_SPP[0] = m_SP[0] * m_SP[1];
+#endif
         }
         NEXT
 
@@ -591,7 +609,11 @@ void VM::interpretCases()
             ON_OP();
             updateIOGas();
 
+#if EVM_NATIVE_ARITH
+            arith::store(m_SPP[0], arith::sub(arith::load(m_SP[0]), arith::load(m_SP[1])));
+#else
             m_SPP[0] = m_SP[0] - m_SP[1];
+#endif
         }
         NEXT
 
@@ -799,7 +821,24 @@ void VM::interpretCases()
             ON_OP();
             updateIOGas();
 
+#if EVM_NATIVE_ARITH
+            if (m_SP[2])
+            {
+                // (a + b) % m == (a % m + b % m) % m, the inner sum is below 2m so one
+                // subtraction is enough, it may wrap around 2^256 which the carry tells
+                auto m = arith::load(m_SP[2]);
+                bool carry = false;
+                auto sum = arith::add(
+                    arith::load(m_SP[0] % m_SP[2]), arith::load(m_SP[1] % m_SP[2]), carry);
+                if (carry || !arith::lessThan(sum, m))
+                    sum = arith::sub(sum, m);
+                arith::store(m_SPP[0], sum);
+            }
+            else
+                m_SPP[0] = 0;
+#else
             m_SPP[0] = m_SP[2] ? u256((u512(m_SP[0]) + u512(m_SP[1])) % m_SP[2]) : 0;
+#endif
         }
         NEXT
 
@@ -1277,6 +1316,84 @@ void VM::interpretCases()
         }
         CONTINUE
 
+        //
+        // fused instructions, the stack check of the PUSH is done here since the pair as a
+        // whole does not grow the stack. When the second instruction consumes an item below the
+        // pushed one, the PUSH is charged before that item is checked, so that the pair fails
+        // with the same status as the two instructions executed one by one
+        //
+
+        CASE(PUSH2JUMP)
+        {
+#if EVM_FUSE_INSTRUCTIONS
+            ON_OP();
+            if (m_SP == m_stack)
+                throwBadStack(0, 1);
+            updateIOGas();
+
+            m_PC = (uint64_t(m_code[m_PC + 1]) << 8) | m_code[m_PC + 2];
+#else
+            throwBadInstruction();
+#endif
+        }
+        CONTINUE
+
+        CASE(PUSH2JUMPI)
+        {
+#if EVM_FUSE_INSTRUCTIONS
+            ON_OP();
+            if (m_SP == m_stack)
+                throwBadStack(0, 1);
+            if (m_io_gas < uint64_t(c_metrics[uint8_t(Instruction::PUSH2)].gas_cost))
+                throwOutOfGas();
+            adjustStack(1, 0);
+            updateIOGas();
+
+            if (m_SP[0])
+                m_PC = (uint64_t(m_code[m_PC + 1]) << 8) | m_code[m_PC + 2];
+            else
+                m_PC += 4;
+#else
+            throwBadInstruction();
+#endif
+        }
+        CONTINUE
+
+        CASE(PUSH1MSTORE)
+        {
+#if EVM_FUSE_INSTRUCTIONS
+            ON_OP();
+            if (m_SP == m_stack)
+                throwBadStack(0, 1);
+            if (m_io_gas < uint64_t(c_metrics[uint8_t(Instruction::PUSH1)].gas_cost))
+                throwOutOfGas();
+            adjustStack(1, 0);
+            uint64_t offset = m_code[m_PC + 1];
+            updateMem(offset + 32);
+            updateIOGas();
+
+            *(h256*)&m_mem[offset] = (h256)m_SP[0];
+            m_PC += 3;
+#else
+            throwBadInstruction();
+#endif
+        }
+        CONTINUE
+
+        CASE(SWAP1POP)
+        {
+#if EVM_FUSE_INSTRUCTIONS
+            ON_OP();
+            updateIOGas();
+
+            m_SPP[0] = m_SP[0];
+            m_PC += 2;
+#else
+            throwBadInstruction();
+#endif
+        }
+        CONTINUE
+
         CASE(DUP1)
         CASE(DUP2)
         CASE(DUP3)
@@ -22,6 +22,8 @@
 
 #pragma once
 
+#include "AnalysedCode.h"
+#include "Arith256.h"
 #include "VMConfig.h"
 
 #include <libdevcore/Common.h>
@@ -84,7 +86,6 @@ private:
     static std::array<evmc_instruction_metrics, 256> c_metrics;
     static void initMetrics();
     static u256 exp256(u256 _base, u256 _exponent);
-    void copyCode(int);
     typedef void (VM::*MemFnPtr)();
     MemFnPtr m_bounce = nullptr;
     uint64_t m_nSteps = 0;
@@ -97,8 +98,10 @@ private:
 
     uint8_t const* m_pCode = nullptr;
     size_t m_codeSize = 0;
-    // space for code
-    bytes m_code;
+    // analysed code, shared with every VM running the same contract
+    AnalysedCode::Ptr m_analysedCode;
+    // padded and optimized code, owned by m_analysedCode
+    byte const* m_code = nullptr;
 
     /// RETURNDATA buffer for memory returned from direct subcalls.
     bytes m_returnData;
@@ -108,8 +111,8 @@ private:
     u256* m_stackEnd = &m_stack[VMSchedule::stackLimit];
     size_t stackSize() { return m_stackEnd - m_SP; }
 
-    // constant pool
-    std::vector<u256> m_pool;
+    // constant pool, owned by m_analysedCode
+    u256 const* m_pool = nullptr;
 
     // interpreter state
     Instruction m_OP;         // current operation
@@ -125,6 +128,7 @@ private:
     // initialize interpreter
     void initEntry();
     void optimize();
+    static AnalysedCode::Ptr analyse(uint8_t const* _code, size_t _codeSize);
 
     // interpreter loop & switch
     void interpretCases();
@@ -135,7 +139,7 @@ private:
     void caseCall();
 
     void copyDataToMemory(bytesConstRef _data, u256* _sp);
-    uint64_t memNeed(u256 _offset, u256 _size);
+    uint64_t memNeed(u256 const& _offset, u256 const& _size);
 
     const evmc_tx_context& getTxContext();
 
@@ -148,12 +152,11 @@ private:
     void throwBufferOverrun(bigint const& _enfOfAccess);
 
     std::vector<uint64_t> m_beginSubs;
-    std::vector<uint64_t> m_jumpDests;
     int64_t verifyJumpDest(u256 const& _dest, bool _throw = true);
 
     void onOperation() {}
     void adjustStack(int _removed, int _added);
-    uint64_t gasForMem(u512 _size);
+    uint64_t gasForMem(uint64_t _size);
     void updateIOGas();
     void updateGas();
     void updateMem(uint64_t _newMem);
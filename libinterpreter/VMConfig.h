@@ -39,6 +39,10 @@ namespace eth
 //
 // EVM_REPLACE_CONST_JUMP - pre-verified jumps to save runtime lookup
 //
+// EVM_FUSE_INSTRUCTIONS  - common instruction pairs dispatched and metered as one
+//
+// EVM_NATIVE_ARITH       - 256 bit arithmetic on 64 bit limbs with 128 bit carries
+//
 // EVM_TRACE              - provides various levels of tracing
 
 #ifndef EVM_JUMP_DISPATCH
@@ -57,12 +61,22 @@ namespace eth
 #endif
 
 #ifndef EVM_OPTIMIZE
-#define EVM_OPTIMIZE false
+#define EVM_OPTIMIZE true
 #endif
 #if EVM_OPTIMIZE
 #define EVM_REPLACE_CONST_JUMP true
 #define EVM_USE_CONSTANT_POOL true
-#define EVM_DO_FIRST_PASS_OPTIMIZATION (EVM_REPLACE_CONST_JUMP || EVM_USE_CONSTANT_POOL)
+#define EVM_FUSE_INSTRUCTIONS EVM_REPLACE_CONST_JUMP
+#define EVM_DO_FIRST_PASS_OPTIMIZATION \
+    (EVM_REPLACE_CONST_JUMP || EVM_USE_CONSTANT_POOL || EVM_FUSE_INSTRUCTIONS)
+#endif
+
+#ifndef EVM_NATIVE_ARITH
+#ifdef __SIZEOF_INT128__
+#define EVM_NATIVE_ARITH true
+#else
+#define EVM_NATIVE_ARITH false
+#endif
 #endif
 
 
@@ -323,10 +337,10 @@ namespace eth
         &&LOG2,                                 \
         &&LOG3,                                 \
         &&LOG4,                                 \
-        &&INVALID,                              \
-        &&INVALID,                              \
-        &&INVALID,                              \
-        &&INVALID,                              \
+        &&PUSH2JUMP,                            \
+        &&PUSH2JUMPI,                           \
+        &&PUSH1MSTORE,                          \
+        &&SWAP1POP,                             \
         &&INVALID,                              \
         &&INVALID,                              \
         &&INVALID,                              \
@@ -22,6 +22,8 @@
 
 #include "VM.h"
 
+#include <libdevcrypto/Hash.h>
+
 namespace dev
 {
 namespace eth
@@ -39,47 +41,64 @@ void VM::initMetrics()
         c_metrics[uint8_t(Instruction::PUSHC)] = c_metrics[uint8_t(Instruction::PUSH1)];
         c_metrics[uint8_t(Instruction::JUMPC)] = c_metrics[uint8_t(Instruction::JUMP)];
         c_metrics[uint8_t(Instruction::JUMPCI)] = c_metrics[uint8_t(Instruction::JUMPI)];
+
+        // fused instructions are metered as the sum of the pair, their stack metrics give the
+        // net effect, the room for the pushed item is checked by the instruction itself. The
+        // items consumed below the pushed one are checked by the instruction too, after the
+        // gas of the PUSH, so their metrics do not take any argument
+        auto fuse = [](Instruction _fused, Instruction _first, Instruction _second,
+                        int8_t _args, int8_t _returned) {
+            auto& metric = c_metrics[uint8_t(_fused)];
+            metric.gas_cost =
+                c_metrics[uint8_t(_first)].gas_cost + c_metrics[uint8_t(_second)].gas_cost;
+            metric.num_stack_arguments = _args;
+            metric.num_stack_returned_items = _returned;
+        };
+        fuse(Instruction::PUSH2JUMP, Instruction::PUSH2, Instruction::JUMP, 0, 0);
+        fuse(Instruction::PUSH2JUMPI, Instruction::PUSH2, Instruction::JUMPI, 0, 0);
+        fuse(Instruction::PUSH1MSTORE, Instruction::PUSH1, Instruction::MSTORE, 0, 0);
+        fuse(Instruction::SWAP1POP, Instruction::SWAP1, Instruction::POP, 2, 1);
         return true;
     }
     ();
     (void)done;
 }
 
-void VM::copyCode(int _extraBytes)
+AnalysedCode::Ptr VM::analyse(uint8_t const* _code, size_t _codeSize)
 {
+    auto analysed = std::make_shared<AnalysedCode>();
+    analysed->codeSize = _codeSize;
+
     // Copy code so that it can be safely modified and extend code by
-    // _extraBytes zero bytes to allow reading virtual data at the end
+    // 33 zero bytes to allow reading virtual data at the end
     // of the code without bounds checks.
-    auto extendedSize = m_codeSize + _extraBytes;
-    m_code.reserve(extendedSize);
-    m_code.assign(m_pCode, m_pCode + m_codeSize);
-    m_code.resize(extendedSize);
-}
-
-void VM::optimize()
-{
-    copyCode(33);
+    bytes& code = analysed->code;
+    code.reserve(_codeSize + 33);
+    code.assign(_code, _code + _codeSize);
+    code.resize(_codeSize + 33);
 
-    size_t const nBytes = m_codeSize;
+    std::vector<uint64_t>& jumpDests = analysed->jumpDests;
+    size_t const nBytes = _codeSize;
 
     // build a table of jump destinations for use in verifyJumpDest
 
     TRACE_STR(1, "Build JUMPDEST table")
     for (size_t pc = 0; pc < nBytes; ++pc)
     {
-        Instruction op = Instruction(m_code[pc]);
+        Instruction op = Instruction(code[pc]);
         TRACE_OP(2, pc, op);
 
         // make synthetic ops in user code trigger invalid instruction if run
-        if (op == Instruction::PUSHC || op == Instruction::JUMPC || op == Instruction::JUMPCI)
+        if (op == Instruction::PUSHC || op == Instruction::JUMPC || op == Instruction::JUMPCI ||
+            (op >= Instruction::PUSH2JUMP && op <= Instruction::SWAP1POP))
         {
             TRACE_OP(1, pc, op);
-            m_code[pc] = (byte)Instruction::INVALID;
+            code[pc] = (byte)Instruction::INVALID;
         }
 
         if (op == Instruction::JUMPDEST)
         {
-            m_jumpDests.push_back(pc);
+            jumpDests.push_back(pc);
         }
         else if ((byte)Instruction::PUSH1 <= (byte)op && (byte)op <= (byte)Instruction::PUSH32)
         {
@@ -90,20 +109,26 @@ void VM::optimize()
 #ifdef EVM_DO_FIRST_PASS_OPTIMIZATION
 
     TRACE_STR(1, "Do first pass optimizations")
+#if EVM_REPLACE_CONST_JUMP
+    auto isJumpDest = [&jumpDests, nBytes](u256 const& _dest) {
+        return _dest < nBytes && std::binary_search(jumpDests.begin(), jumpDests.end(),
+                                     static_cast<uint64_t>(_dest));
+    };
+#endif
     for (size_t pc = 0; pc < nBytes; ++pc)
     {
         u256 val = 0;
-        Instruction op = Instruction(m_code[pc]);
+        Instruction op = Instruction(code[pc]);
 
         if ((byte)Instruction::PUSH1 <= (byte)op && (byte)op <= (byte)Instruction::PUSH32)
         {
             byte nPush = (byte)op - (byte)Instruction::PUSH1 + 1;
 
             // decode pushed bytes to integral value
-            val = m_code[pc + 1];
+            val = code[pc + 1];
             for (uint64_t i = pc + 2, n = nPush; --n; ++i)
             {
-                val = (val << 8) | m_code[i];
+                val = (val << 8) | code[i];
             }
 
 #if EVM_USE_CONSTANT_POOL
@@ -111,18 +136,19 @@ void VM::optimize()
             // add value to constant pool and replace PUSHn with PUSHC
             // place offset in code as 2 bytes MSB-first
             // followed by one byte count of remaining pushed bytes
-            if (5 < nPush)
+            // the offset has two bytes, constants past a full pool are left as PUSHn
+            if (5 < nPush && analysed->pool.size() <= 0xffff)
             {
-                uint16_t pool_off = m_pool.size();
+                uint16_t pool_off = analysed->pool.size();
                 TRACE_VAL(1, "stash", val);
                 TRACE_VAL(1, "... in pool at offset", pool_off);
-                m_pool.push_back(val);
+                analysed->pool.push_back(val);
 
                 TRACE_PRE_OPT(1, pc, op);
-                m_code[pc] = byte(op = Instruction::PUSHC);
-                m_code[pc + 3] = nPush - 2;
-                m_code[pc + 2] = pool_off & 0xff;
-                m_code[pc + 1] = pool_off >> 8;
+                code[pc] = byte(op = Instruction::PUSHC);
+                code[pc + 3] = nPush - 2;
+                code[pc + 2] = pool_off & 0xff;
+                code[pc + 1] = pool_off >> 8;
                 TRACE_POST_OPT(1, pc, op);
             }
 
@@ -134,14 +160,14 @@ void VM::optimize()
             // outer loop is N = number of bytes in code array
             // so complexity is N log M, worst case is N log N
             size_t i = pc + nPush + 1;
-            op = Instruction(m_code[i]);
+            op = Instruction(code[i]);
             if (op == Instruction::JUMP)
             {
                 TRACE_VAL(1, "Replace const JUMP with JUMPC to", val)
                 TRACE_PRE_OPT(1, i, op);
 
-                if (0 <= verifyJumpDest(val, false))
-                    m_code[i] = byte(op = Instruction::JUMPC);
+                if (isJumpDest(val))
+                    code[i] = byte(op = Instruction::JUMPC);
 
                 TRACE_POST_OPT(1, i, op);
             }
@@ -150,18 +176,66 @@ void VM::optimize()
                 TRACE_VAL(1, "Replace const JUMPI with JUMPCI to", val)
                 TRACE_PRE_OPT(1, i, op);
 
-                if (0 <= verifyJumpDest(val, false))
-                    m_code[i] = byte(op = Instruction::JUMPCI);
+                if (isJumpDest(val))
+                    code[i] = byte(op = Instruction::JUMPCI);
 
                 TRACE_POST_OPT(1, i, op);
             }
 #endif
 
+#if EVM_FUSE_INSTRUCTIONS
+            // the second instruction of a pair is never a JUMPDEST so nothing can jump between
+            // them, it stays in the code and is skipped by the fused instruction
+            op = Instruction(code[i]);
+            Instruction fused = Instruction::INVALID;
+            if (nPush == 2 && op == Instruction::JUMPC)
+                fused = Instruction::PUSH2JUMP;
+            else if (nPush == 2 && op == Instruction::JUMPCI)
+                fused = Instruction::PUSH2JUMPI;
+            else if (nPush == 1 && op == Instruction::MSTORE)
+                fused = Instruction::PUSH1MSTORE;
+            if (fused != Instruction::INVALID)
+            {
+                TRACE_PRE_OPT(1, pc, Instruction(code[pc]));
+                code[pc] = byte(fused);
+                TRACE_POST_OPT(1, pc, fused);
+            }
+#endif
+
             pc += nPush;
         }
+#if EVM_FUSE_INSTRUCTIONS
+        else if (op == Instruction::SWAP1 && Instruction(code[pc + 1]) == Instruction::POP)
+        {
+            TRACE_PRE_OPT(1, pc, op);
+            code[pc] = byte(op = Instruction::SWAP1POP);
+            TRACE_POST_OPT(1, pc, op);
+            ++pc;
+        }
+#endif
     }
     TRACE_STR(1, "Finished optimizations")
 #endif
+
+    return analysed;
+}
+
+void VM::optimize()
+{
+    // the analysis only depends on the code, reuse it across calls and transactions
+    h256 codeHash(m_message->code_hash.bytes, h256::ConstructFromPointer);
+    if (!codeHash)
+        codeHash = sha3(bytesConstRef(m_pCode, m_codeSize));
+
+    auto& cache = AnalysedCodeCache::instance();
+    m_analysedCode = cache.get(codeHash, m_codeSize);
+    if (!m_analysedCode)
+    {
+        m_analysedCode = analyse(m_pCode, m_codeSize);
+        cache.put(codeHash, m_analysedCode);
+    }
+    m_code = m_analysedCode->code.data();
+    m_pool = m_analysedCode->pool.data();
 }
 
 
@@ -184,6 +258,11 @@ void VM::initEntry()
 // Do not inline it.
 u256 VM::exp256(u256 _base, u256 _exponent)
 {
+#if EVM_NATIVE_ARITH
+    u256 result;
+    arith::store(result, arith::exp(arith::load(_base), arith::load(_exponent)));
+    return result;
+#else
     using boost::multiprecision::limb_type;
     u256 result = 1;
     while (_exponent)
@@ -194,6 +273,7 @@ u256 VM::exp256(u256 _base, u256 _exponent)
         _exponent >>= 1;
     }
     return result;
+#endif
 }
 }  // namespace eth
 }  // namespace dev
@@ -27,6 +27,9 @@
 #include <libmptstate/MPTStateFactory.h>
 #include <libsecurity/EncryptedLevelDB.h>
 #include <libstorage/LevelDBStorage.h>
+#ifdef FISCO_ROCKSDB
+#include <libstorage/RocksDBStorage.h>
+#endif
 #include <libstoragestate/StorageStateFactory.h>
 
 using namespace dev;
@@ -46,11 +49,31 @@ void DBInitializer::initStorageDB()
 {
     DBInitializer_LOG(DEBUG) << "[#initStorageDB]" << std::endl;
     /// TODO: implement AMOP storage
-    if (dev::stringCmpIgnoreCase(m_param->mutableStorageParam().type, "LevelDB") != 0)
+    if (dev::stringCmpIgnoreCase(m_param->mutableStorageParam().type, "LevelDB") == 0)
     {
-        DBInitializer_LOG(ERROR) << "Unsupported dbType, current version only supports levelDB"
-                                 << std::endl;
+        initLevelDBStorage();
+        return;
     }
+#ifdef FISCO_ROCKSDB
+    if (dev::stringCmpIgnoreCase(m_param->mutableStorageParam().type, "RocksDB") == 0)
+    {
+        if (g_BCOSConfig.diskEncryption.enable)
+        {
+            /// refuse to start rather than silently storing the group in another db type
+            DBInitializer_LOG(ERROR) << "[#initStorageDB] Disk encryption only supports levelDB"
+                                     << std::endl;
+            BOOST_THROW_EXCEPTION(OpenRocksDBFailed() << errinfo_comment(
+                                      "Disk encryption only supports levelDB, set storage.type"));
+        }
+        initRocksDBStorage();
+        return;
+    }
+#endif
+    DBInitializer_LOG(ERROR) << "Unsupported dbType, current version only supports levelDB"
+#ifdef FISCO_ROCKSDB
+                             << "/rocksDB"
+#endif
+                             << std::endl;
     initLevelDBStorage();
 }
 
@@ -59,13 +82,17 @@ void DBInitializer::initLevelDBStorage()
 {
     DBInitializer_LOG(INFO) << "[#initStorageDB] [#initLevelDBStorage] ..." << std::endl;
     /// open and init the levelDB
-    leveldb::Options ldb_option;
     dev::db::BasicLevelDB* pleveldb = nullptr;
     try
     {
         boost::filesystem::create_directories(m_param->mutableStorageParam().path);
-        ldb_option.create_if_missing = true;
-        ldb_option.max_open_files = 100;
+        LevelDBConfig config;
+        config.blockCacheMB = m_param->mutableStorageParam().blockCacheMB;
+        config.writeBufferMB = m_param->mutableStorageParam().writeBufferMB;
+        config.maxOpenFiles = m_param->mutableStorageParam().maxOpenFiles;
+        config.bloomBitsPerKey = m_param->mutableStorageParam().bloomBitsPerKey;
+        config.compression = m_param->mutableStorageParam().compression;
+        leveldb::Options ldb_option = sharedLevelDBOptions(config);
 
         leveldb::Status status;
 
@@ -100,6 +127,8 @@ void DBInitializer::initLevelDBStorage()
         std::shared_ptr<dev::db::BasicLevelDB> leveldb_handler =
             std::shared_ptr<dev::db::BasicLevelDB>(pleveldb);
         leveldb_storage->setDB(leveldb_handler);
+        leveldb_storage->setSyncWrite(m_param->mutableStorageParam().syncWrite);
+        leveldb_storage->setStatsInterval(m_param->mutableStorageParam().statsInterval);
         m_storage = leveldb_storage;
     }
     catch (std::exception& e)
@@ -110,6 +139,32 @@ void DBInitializer::initLevelDBStorage()
     }
 }
 
+#ifdef FISCO_ROCKSDB
+/// init the storage with rocksdb
+void DBInitializer::initRocksDBStorage()
+{
+    DBInitializer_LOG(INFO) << "[#initStorageDB] [#initRocksDBStorage] ..." << std::endl;
+    try
+    {
+        boost::filesystem::create_directories(m_param->mutableStorageParam().path);
+        RocksDBOptions options;
+        options.blockCacheMB = m_param->mutableStorageParam().blockCacheMB;
+        options.maxBackgroundJobs = m_param->mutableStorageParam().maxBackgroundJobs;
+        options.bloomBitsPerKey = m_param->mutableStorageParam().bloomBitsPerKey;
+        auto rocksdb_storage = std::make_shared<RocksDBStorage>();
+        rocksdb_storage->open(m_param->mutableStorageParam().path, options);
+        rocksdb_storage->setSyncWrite(m_param->mutableStorageParam().syncWrite);
+        m_storage = rocksdb_storage;
+    }
+    catch (std::exception& e)
+    {
+        DBInitializer_LOG(ERROR) << "[#initRocksDBStorage] initRocksDBStorage failed, [EINFO]: "
+                                 << boost::diagnostic_information(e);
+        BOOST_THROW_EXCEPTION(OpenRocksDBFailed() << errinfo_comment("initRocksDBStorage failed"));
+    }
+}
+#endif
+
 /// TODO: init AMOP Storage
 void DBInitializer::initAMOPStorage()
 {
@@ -131,6 +186,8 @@ void DBInitializer::createExecutiveContext()
     m_executiveContextFac->setStateStorage(m_storage);
     // mpt or storage
     m_executiveContextFac->setStateFactory(m_stateFactory);
+    m_executiveContextFac->setReleaseTemporaryPrecompiled(
+        m_param->mutableTxParam().releaseTemporaryPrecompiled);
     DBInitializer_LOG(DEBUG) << "[#createExecutiveContext SUCC]" << std::endl;
 }
 
@@ -157,7 +214,11 @@ void DBInitializer::createStateFactory(dev::h256 const& genesisHash)
 void DBInitializer::createStorageState()
 {
     DBInitializer_LOG(DEBUG) << "[#createStateFactory] [#createStorageState]" << std::endl;
-    m_stateFactory = std::make_shared<StorageStateFactory>(u256(0x0));
+    StorageLayout layout;
+    layout.codeTable = m_param->mutableStateParam().codeTable;
+    layout.accountHeader = m_param->mutableStateParam().accountHeader;
+    layout.fixedWidthSlots = m_param->mutableStateParam().fixedWidthSlots;
+    m_stateFactory = std::make_shared<StorageStateFactory>(u256(0x0), layout);
     DBInitializer_LOG(DEBUG) << "[#createStateFactory] [#createStorageState SUCC]" << std::endl;
 }
 
@@ -71,6 +71,10 @@ private:
     void initAMOPStorage();
     /// TOCHECK: init levelDB storage
     void initLevelDBStorage();
+#ifdef FISCO_ROCKSDB
+    /// init rocksDB storage
+    void initRocksDBStorage();
+#endif
     /// TOCHECK: create storage/mpt state
     void createStorageState();
     void createMptState(dev::h256 const& genesisHash);
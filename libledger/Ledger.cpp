@@ -120,6 +120,8 @@ void Ledger::initIniConfig(std::string const& iniConfigFileName)
         initTxPoolConfig(pt);
         /// init params related to sync
         initSyncConfig(pt);
+        /// init params related to local storage
+        initStorageConfig(pt);
     }
     catch (std::exception& e)
     {
@@ -199,6 +201,35 @@ void Ledger::initSyncConfig(ptree const& pt)
                       << std::endl;
 }
 
+/// init local storage configurations
+/// 1. syncWrite: fsync the db on every block commit, default is false
+/// 2. blockCacheMB: block cache size (shared by all leveldb groups), default is 128
+/// 3. maxBackgroundJobs: rocksdb flush/compaction threads, default is 4
+/// 4. writeBufferMB/maxOpenFiles/bloomBitsPerKey/compression: leveldb options
+/// 5. statsInterval: log db stats every statsInterval blocks, default is 1000
+/// 6. decodedBlockCacheMB: decoded blocks kept by the blockchain, default is 32
+void Ledger::initStorageConfig(ptree const& pt)
+{
+    StorageParam& param = m_param->mutableStorageParam();
+    param.syncWrite = pt.get<bool>("storage.syncWrite", false);
+    param.blockCacheMB = pt.get<size_t>("storage.blockCacheMB", 128);
+    param.maxBackgroundJobs = pt.get<int>("storage.maxBackgroundJobs", 4);
+    param.writeBufferMB = pt.get<size_t>("storage.writeBufferMB", 4);
+    param.maxOpenFiles = pt.get<int>("storage.maxOpenFiles", 100);
+    param.bloomBitsPerKey = pt.get<int>("storage.bloomBitsPerKey", 10);
+    param.compression = pt.get<bool>("storage.compression", true);
+    param.statsInterval = pt.get<int64_t>("storage.statsInterval", 1000);
+    param.decodedBlockCacheMB = pt.get<size_t>("storage.decodedBlockCacheMB", 32);
+    Ledger_LOG(DEBUG)
+        << "[#initStorageConfig] "
+           "[syncWrite/blockCacheMB/maxBackgroundJobs/writeBufferMB/maxOpenFiles/"
+           "bloomBitsPerKey/compression/statsInterval/decodedBlockCacheMB]:"
+        << param.syncWrite << "/" << param.blockCacheMB << "/" << param.maxBackgroundJobs << "/"
+        << param.writeBufferMB << "/" << param.maxOpenFiles << "/" << param.bloomBitsPerKey << "/"
+        << param.compression << "/" << param.statsInterval << "/" << param.decodedBlockCacheMB
+        << std::endl;
+}
+
 /// init db related configurations:
 /// dbType: leveldb/AMDB, storage type, default is "AMDB"
 /// mpt: true/false, enable mpt or not, default is true
@@ -211,6 +242,10 @@ void Ledger::initDBConfig(ptree const& pt)
     m_param->mutableStorageParam().path = m_param->baseDir() + "/block";
     /// set state db related param
     m_param->mutableStateParam().type = pt.get<std::string>("state.type", "mpt");
+    /// layout of storage state, changes the state root when enabled
+    m_param->mutableStateParam().codeTable = pt.get<bool>("state.codeTable", false);
+    m_param->mutableStateParam().accountHeader = pt.get<bool>("state.accountHeader", false);
+    m_param->mutableStateParam().fixedWidthSlots = pt.get<bool>("state.fixedWidthSlots", false);
 
     Ledger_LOG(DEBUG) << "[#initDBConfig] [storageDB/storagePath/stateDB/baseDir]:  "
                       << m_param->mutableStorageParam().type << "/"
@@ -220,10 +255,15 @@ void Ledger::initDBConfig(ptree const& pt)
 
 /// init tx related configurations
 /// 1. gasLimit: default is 300000000
+/// 2. releaseTemporaryPrecompiled: default is false, changes execution results when enabled
 void Ledger::initTxConfig(boost::property_tree::ptree const& pt)
 {
     m_param->mutableTxParam().txGasLimit = pt.get<unsigned>("tx.gasLimit", 300000000);
-    Ledger_LOG(DEBUG) << "[#initTxConfig] [txGasLimit]:" << m_param->mutableTxParam().txGasLimit;
+    m_param->mutableTxParam().releaseTemporaryPrecompiled =
+        pt.get<bool>("tx.releaseTemporaryPrecompiled", false);
+    Ledger_LOG(DEBUG) << "[#initTxConfig] [txGasLimit/releaseTemporaryPrecompiled]:"
+                      << m_param->mutableTxParam().txGasLimit << "/"
+                      << m_param->mutableTxParam().releaseTemporaryPrecompiled;
 }
 
 /// init mark of this group
@@ -237,6 +277,16 @@ void Ledger::initMark()
     s << m_param->mutableStateParam().type << "-";
     s << m_param->mutableConsensusParam().maxTransactions << "-";
     s << m_param->mutableTxParam().txGasLimit;
+    /// options changing execution results are only marked when enabled, so the mark of an
+    /// existing group stays the same
+    if (m_param->mutableTxParam().releaseTemporaryPrecompiled)
+        s << "-releaseTemporaryPrecompiled";
+    if (m_param->mutableStateParam().codeTable)
+        s << "-codeTable";
+    if (m_param->mutableStateParam().accountHeader)
+        s << "-accountHeader";
+    if (m_param->mutableStateParam().fixedWidthSlots)
+        s << "-fixedWidthSlots";
     m_param->mutableGenesisParam().genesisMark = s.str();
     Ledger_LOG(DEBUG) << "[#initMark] [genesisMark]:  "
                       << m_param->mutableGenesisParam().genesisMark << std::endl;
@@ -291,6 +341,7 @@ bool Ledger::initBlockChain()
     }
     std::shared_ptr<BlockChainImp> blockChain = std::make_shared<BlockChainImp>();
     blockChain->setStateStorage(m_dbInitializer->storage());
+    blockChain->setBlockCacheCapacity(m_param->mutableStorageParam().decodedBlockCacheMB << 20);
     m_blockChain = blockChain;
     std::string consensusType = m_param->mutableConsensusParam().consensusType;
     std::string storageType = m_param->mutableStorageParam().type;
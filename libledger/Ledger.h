@@ -151,6 +151,7 @@ private:
     void initTxPoolConfig(boost::property_tree::ptree const& pt);
     void initConsensusConfig(boost::property_tree::ptree const& pt);
     void initSyncConfig(boost::property_tree::ptree const& pt);
+    void initStorageConfig(boost::property_tree::ptree const& pt);
     void initDBConfig(boost::property_tree::ptree const& pt);
     void initTxConfig(boost::property_tree::ptree const& pt);
     void initMark();
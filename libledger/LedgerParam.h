@@ -72,14 +72,36 @@ struct StorageParam
 {
     std::string type;
     std::string path;
+    bool syncWrite = false;
+    /// block cache size in MB, shared by the leveldb groups of the same size
+    size_t blockCacheMB = 128;
+    /// rocksdb background flush/compaction jobs
+    int maxBackgroundJobs = 4;
+    /// leveldb tunables
+    size_t writeBufferMB = 4;
+    int maxOpenFiles = 100;
+    int bloomBitsPerKey = 10;
+    bool compression = true;
+    /// log db stats every statsInterval blocks, 0 disables
+    int64_t statsInterval = 1000;
+    /// decoded blocks kept in memory by the blockchain of the group, in MB
+    size_t decodedBlockCacheMB = 32;
 };
 struct StateParam
 {
     std::string type;
+    /// code of storage state accounts kept once per hash in _sys_code_
+    bool codeTable = false;
+    /// fields of storage state accounts packed in one row
+    bool accountHeader = false;
+    /// storage slots keyed by fixed-width hex
+    bool fixedWidthSlots = false;
 };
 struct TxParam
 {
     uint64_t txGasLimit;
+    /// release precompiled temporaries at the end of every transaction instead of every block
+    bool releaseTemporaryPrecompiled = false;
 };
 class LedgerParam : public LedgerParamInterface
 {
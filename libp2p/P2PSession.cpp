@@ -94,6 +94,22 @@ void P2PSession::heartBeat()
     }
 }
 
+void P2PSession::setTopics(uint32_t seq, std::shared_ptr<std::set<std::string> > topics)
+{
+    {
+        std::lock_guard<std::mutex> lock(x_topic);
+
+        m_topicSeq = seq;
+        m_topics = topics;
+    }
+
+    auto service = m_service.lock();
+    if (service)
+    {
+        service->updateTopicPeers();
+    }
+}
+
 void P2PSession::onTopicMessage(P2PMessage::Ptr message)
 {
     auto service = m_service.lock();
@@ -56,20 +56,19 @@ public:
     virtual NodeID nodeID() { return m_nodeID; }
     virtual void setNodeID(NodeID nodeID) { m_nodeID = nodeID; }
 
-    virtual std::shared_ptr<std::set<std::string> > topics() { return m_topics; }
+    virtual std::shared_ptr<std::set<std::string> > topics()
+    {
+        std::lock_guard<std::mutex> lock(x_topic);
+        return m_topics;
+    }
 
     virtual std::weak_ptr<Service> service() { return m_service; }
     virtual void setService(std::weak_ptr<Service> service) { m_service = service; }
 
     virtual void onTopicMessage(P2PMessage::Ptr message);
 
-    virtual void setTopics(uint32_t seq, std::shared_ptr<std::set<std::string> > topics)
-    {
-        std::lock_guard<std::mutex> lock(x_topic);
-
-        m_topicSeq = seq;
-        m_topics = topics;
-    }
+    /// also updates the topic index of the service
+    virtual void setTopics(uint32_t seq, std::shared_ptr<std::set<std::string> > topics);
 
 private:
     dev::network::SessionFace::Ptr m_session;
@@ -87,6 +87,7 @@ void Service::stop()
         /// clear sessions
         RecursiveGuard l(x_sessions);
         m_sessions.clear();
+        updateTopicPeers();
     }
 }
 
@@ -217,6 +218,7 @@ void Service::onConnect(dev::network::NetworkException e, dev::network::NodeID n
     {
         m_sessions.insert(std::make_pair(nodeID, p2pSession));
     }
+    updateTopicPeers();
     SERVICE_LOG(INFO) << "Connection established to: " << nodeID << "@"
                       << session->nodeIPEndpoint().name();
 }
@@ -232,6 +234,7 @@ void Service::onDisconnect(dev::network::NetworkException e, P2PSession::Ptr p2p
                            << p2pSession->session()->nodeIPEndpoint().name();
 
         m_sessions.erase(it);
+        updateTopicPeers();
         if (e.errorCode() == dev::network::P2PExceptionType::DuplicateSession)
             return;
         SERVICE_LOG(WARNING) << "[#onDisconnect] [errCode/errMsg]" << e.errorCode() << "/"
@@ -710,30 +713,36 @@ P2PSessionInfos Service::sessionInfosByProtocolID(PROTOCOL_ID _protocolID)
 NodeIDs Service::getPeersByTopic(std::string const& topic)
 {
     NodeIDs nodeList;
-    try
-    {
-        RecursiveGuard l(x_sessions);
-        auto s = m_sessions;
-        for (auto const& it : s)
-        {
-            for (auto j : *(it.second->topics()))
-            {
-                if (j == topic)
-                {
-                    nodeList.push_back(it.first);
-                }
-            }
-        }
-    }
-    catch (std::exception& e)
+    auto topicPeers = std::atomic_load(&m_topicPeers);
+    auto it = topicPeers->find(topic);
+    if (it != topicPeers->end())
     {
-        P2PMSG_LOG(WARNING) << "[#getPeersByTopic] [EINFO]: " << e.what();
+        nodeList = it->second;
     }
     P2PMSG_LOG(DEBUG) << "[#getPeersByTopic] [topic/peers size]: " << topic << "/"
                       << nodeList.size();
     return nodeList;
 }
 
+void Service::updateTopicPeers()
+{
+    auto topicPeers = std::make_shared<TopicPeers>();
+    RecursiveGuard l(x_sessions);
+    for (auto const& it : m_sessions)
+    {
+        auto topics = it.second->topics();
+        if (!topics)
+        {
+            continue;
+        }
+        for (auto const& topic : *topics)
+        {
+            (*topicPeers)[topic].push_back(it.first);
+        }
+    }
+    std::atomic_store(&m_topicPeers, std::shared_ptr<const TopicPeers>(topicPeers));
+}
+
 bool Service::isConnected(NodeID nodeID)
 {
     RecursiveGuard l(x_sessions);
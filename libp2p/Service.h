@@ -136,6 +136,10 @@ public:
     void updateStaticNodes(
         std::shared_ptr<dev::network::SocketFace> const& _s, NodeID const& nodeId);
 
+    /// rebuilds the peers of every topic from the sessions, called when a session is added or
+    /// removed and when the topics of a peer change
+    void updateTopicPeers();
+
 private:
     NodeIDs getPeersByTopic(std::string const& topic);
 
@@ -149,6 +153,11 @@ private:
     std::unordered_map<NodeID, P2PSession::Ptr> m_sessions;
     RecursiveMutex x_sessions;
 
+    /// the peers of every topic, replaced as a whole by updateTopicPeers and read with
+    /// std::atomic_load, so sending by topic does not scan the sessions
+    typedef std::unordered_map<std::string, NodeIDs> TopicPeers;
+    std::shared_ptr<const TopicPeers> m_topicPeers = std::make_shared<TopicPeers>();
+
     std::atomic<uint32_t> m_topicSeq = {0};
     std::shared_ptr<std::vector<std::string>> m_topics;
     RecursiveMutex x_topics;
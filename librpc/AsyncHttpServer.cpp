@@ -0,0 +1,282 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @file AsyncHttpServer.cpp
+ */
+
+#include "AsyncHttpServer.h"
+#include "Common.h"
+#include <boost/beast.hpp>
+#include <boost/optional.hpp>
+#include <deque>
+
+using namespace dev;
+using namespace dev::rpc;
+
+namespace http = boost::beast::http;
+using tcp = boost::asio::ip::tcp;
+
+namespace
+{
+/// sendRawTransaction batches are large, the beast default is 1MB
+const uint64_t c_maxBodySize = 16 * 1024 * 1024;
+/// requests of a connection read ahead of their responses
+const size_t c_maxPipelined = 16;
+
+class AsyncHttpSession : public std::enable_shared_from_this<AsyncHttpSession>
+{
+public:
+    typedef http::response<http::string_body> Response;
+
+    AsyncHttpSession(tcp::socket&& _socket, RpcDispatcher::Ptr _dispatcher,
+        std::string const& _allowedOrigin)
+      : m_socket(std::move(_socket)),
+        m_strand(m_socket.get_io_service()),
+        m_dispatcher(_dispatcher),
+        m_allowedOrigin(_allowedOrigin)
+    {}
+
+    void start() { m_strand.post(std::bind(&AsyncHttpSession::read, shared_from_this())); }
+
+private:
+    /// a request in flight, answered when it and all the requests before it are done
+    struct Slot
+    {
+        std::shared_ptr<Response> response;
+    };
+
+    void read()
+    {
+        if (m_reading || m_closing || m_slots.size() >= c_maxPipelined)
+        {
+            return;
+        }
+        m_reading = true;
+        m_parser.emplace();
+        m_parser->body_limit(c_maxBodySize);
+        auto self = shared_from_this();
+        http::async_read(m_socket, m_buffer, *m_parser,
+            m_strand.wrap([self](boost::system::error_code const& _error, size_t) {
+                self->onRead(_error);
+            }));
+    }
+
+    void onRead(boost::system::error_code const& _error)
+    {
+        m_reading = false;
+        if (_error)
+        {
+            if (_error != http::error::end_of_stream)
+            {
+                RPC_LOG(TRACE) << "[#AsyncHttpSession] read failed: " << _error.message();
+            }
+            // answer the requests already read, then close
+            m_closing = true;
+            write();
+            return;
+        }
+
+        auto request = m_parser->release();
+        auto slot = std::make_shared<Slot>();
+        m_slots.push_back(slot);
+        unsigned version = request.version();
+        bool keepAlive = request.keep_alive();
+        if (!keepAlive)
+        {
+            m_closing = true;
+        }
+        if (request.method() == http::verb::options)
+        {
+            complete(slot, makeResponse(http::status::ok, std::string(), version, keepAlive));
+        }
+        else if (request.method() != http::verb::post)
+        {
+            complete(slot, makeResponse(http::status::method_not_allowed,
+                               "Not allowed HTTP Method", version, keepAlive));
+        }
+        else
+        {
+            auto self = shared_from_this();
+            m_dispatcher->dispatch(
+                request.body(), [self, slot, version, keepAlive](std::string const& _response) {
+                    auto response =
+                        self->makeResponse(http::status::ok, _response, version, keepAlive);
+                    self->m_strand.post(
+                        [self, slot, response]() { self->complete(slot, response); });
+                });
+        }
+        read();
+    }
+
+    void complete(std::shared_ptr<Slot> _slot, std::shared_ptr<Response> _response)
+    {
+        _slot->response = _response;
+        write();
+    }
+
+    void write()
+    {
+        if (m_writing)
+        {
+            return;
+        }
+        if (m_slots.empty())
+        {
+            if (m_closing && !m_reading)
+            {
+                close();
+            }
+            return;
+        }
+        auto response = m_slots.front()->response;
+        if (!response)
+        {
+            return;
+        }
+        m_writing = true;
+        auto self = shared_from_this();
+        http::async_write(m_socket, *response,
+            m_strand.wrap([self](boost::system::error_code const& _error, size_t) {
+                self->onWrite(_error);
+            }));
+    }
+
+    void onWrite(boost::system::error_code const& _error)
+    {
+        m_writing = false;
+        if (_error)
+        {
+            RPC_LOG(TRACE) << "[#AsyncHttpSession] write failed: " << _error.message();
+            m_slots.clear();
+            m_closing = true;
+            close();
+            return;
+        }
+        m_slots.pop_front();
+        write();
+        read();
+    }
+
+    std::shared_ptr<Response> makeResponse(
+        http::status _status, std::string const& _body, unsigned _version, bool _keepAlive) const
+    {
+        auto response = std::make_shared<Response>(_status, _version);
+        response->set(http::field::content_type, "application/json");
+        if (!m_allowedOrigin.empty())
+        {
+            response->set(http::field::access_control_allow_origin, m_allowedOrigin);
+        }
+        response->keep_alive(_keepAlive);
+        response->body() = _body;
+        response->prepare_payload();
+        return response;
+    }
+
+    void close()
+    {
+        if (m_closed)
+        {
+            return;
+        }
+        m_closed = true;
+        boost::system::error_code ignored;
+        m_socket.shutdown(tcp::socket::shutdown_both, ignored);
+        m_socket.close(ignored);
+    }
+
+    tcp::socket m_socket;
+    boost::asio::io_service::strand m_strand;
+    RpcDispatcher::Ptr m_dispatcher;
+    std::string m_allowedOrigin;
+
+    boost::beast::flat_buffer m_buffer;
+    boost::optional<http::request_parser<http::string_body>> m_parser;
+    std::deque<std::shared_ptr<Slot>> m_slots;
+    bool m_reading = false;
+    bool m_writing = false;
+    bool m_closing = false;
+    bool m_closed = false;
+};
+
+void accept(std::shared_ptr<tcp::acceptor> _acceptor, RpcDispatcher::Ptr _dispatcher,
+    std::string const& _allowedOrigin)
+{
+    auto socket = std::make_shared<tcp::socket>(_acceptor->get_io_service());
+    _acceptor->async_accept(*socket, [_acceptor, _dispatcher, _allowedOrigin, socket](
+                                         boost::system::error_code const& _error) {
+        if (!_acceptor->is_open())
+        {
+            return;
+        }
+        if (_error)
+        {
+            RPC_LOG(ERROR) << "[#AsyncHttpServer] accept failed: " << _error.message();
+        }
+        else
+        {
+            std::make_shared<AsyncHttpSession>(std::move(*socket), _dispatcher, _allowedOrigin)
+                ->start();
+        }
+        accept(_acceptor, _dispatcher, _allowedOrigin);
+    });
+}
+}  // namespace
+
+AsyncHttpServer::AsyncHttpServer(std::string const& _address, int _port,
+    std::shared_ptr<boost::asio::io_service> _ioService, RpcDispatcher::Ptr _dispatcher)
+  : m_address(_address), m_port(_port), m_ioService(_ioService), m_dispatcher(_dispatcher)
+{}
+
+bool AsyncHttpServer::StartListening()
+{
+    if (m_acceptor)
+    {
+        return true;
+    }
+    try
+    {
+        m_dispatcher->setHandler(GetHandler());
+        tcp::endpoint endpoint(boost::asio::ip::address::from_string(m_address), m_port);
+        auto acceptor = std::make_shared<tcp::acceptor>(*m_ioService);
+        acceptor->open(endpoint.protocol());
+        acceptor->set_option(boost::asio::socket_base::reuse_address(true));
+        acceptor->bind(endpoint);
+        acceptor->listen();
+        m_acceptor = acceptor;
+        accept(m_acceptor, m_dispatcher, m_allowedOrigin);
+    }
+    catch (std::exception& e)
+    {
+        RPC_LOG(ERROR) << "[#AsyncHttpServer] listen failed [address/port]: " << m_address << "/"
+                       << m_port << ", " << boost::diagnostic_information(e);
+        return false;
+    }
+    RPC_LOG(INFO) << "[#AsyncHttpServer] listening [address/port]: " << m_address << "/"
+                  << m_port;
+    return true;
+}
+
+bool AsyncHttpServer::StopListening()
+{
+    if (m_acceptor)
+    {
+        boost::system::error_code ignored;
+        m_acceptor->close(ignored);
+        m_acceptor.reset();
+    }
+    m_dispatcher->stop();
+    return true;
+}
@@ -0,0 +1,59 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @file AsyncHttpServer.h
+ */
+#pragma once
+
+#include "RpcDispatcher.h"
+#include <jsonrpccpp/server/abstractserverconnector.h>
+#include <boost/asio.hpp>
+#include <memory>
+#include <string>
+
+namespace dev
+{
+namespace rpc
+{
+/// JSON-RPC over HTTP/1.1 keep-alive on boost::beast. The sockets live on the io_service given
+/// by the node and never block on a method: the requests of a connection are read ahead
+/// (pipelining), run on the RpcDispatcher, and answered in order.
+class AsyncHttpServer : public jsonrpc::AbstractServerConnector
+{
+public:
+    AsyncHttpServer(std::string const& _address, int _port,
+        std::shared_ptr<boost::asio::io_service> _ioService, RpcDispatcher::Ptr _dispatcher);
+    virtual ~AsyncHttpServer() { StopListening(); }
+
+    virtual bool StartListening() override;
+    virtual bool StopListening() override;
+    /// the sessions write their responses, the connector callback is not used
+    virtual bool SendResponse(std::string const&, void* = nullptr) override { return false; }
+
+    RpcDispatcher::Ptr dispatcher() const { return m_dispatcher; }
+    void setAllowedOrigin(std::string const& _origin) { m_allowedOrigin = _origin; }
+
+private:
+    std::string m_address;
+    int m_port;
+    std::shared_ptr<boost::asio::io_service> m_ioService;
+    RpcDispatcher::Ptr m_dispatcher;
+    std::shared_ptr<boost::asio::ip::tcp::acceptor> m_acceptor;
+    std::string m_allowedOrigin;
+};
+
+}  // namespace rpc
+}  // namespace dev
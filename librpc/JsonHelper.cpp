@@ -22,9 +22,11 @@
 #include "JsonHelper.h"
 #include <jsonrpccpp/common/exception.h>
 #include <libdevcore/easylog.h>
+#include <libethcore/Block.h>
 #include <libethcore/CommonJS.h>
 #include <libethcore/SealEngine.h>
 #include <libethcore/Transaction.h>
+#include <libethcore/TransactionReceipt.h>
 
 using namespace std;
 using namespace dev::eth;
@@ -54,6 +56,113 @@ Json::Value toJson(
     return res;
 }
 
+// the keys are written in the order jsoncpp sorts them
+void writeJson(JsonWriter& _writer, Transaction const& _t, std::pair<h256, unsigned> _location,
+    BlockNumber _blockNumber)
+{
+    if (!_t)
+    {
+        _writer.null();
+        return;
+    }
+    _writer.beginObject();
+    _writer.key("blockHash").hex(_location.first);
+    _writer.key("blockNumber").quantity(uint64_t(_blockNumber));
+    _writer.key("from").hex(_t.safeSender());
+    _writer.key("gas").quantity(_t.gas());
+    _writer.key("gasPrice").quantity(_t.gasPrice());
+    _writer.key("hash").hex(_t.sha3());
+    _writer.key("input").hex(ref(_t.data()));
+    _writer.key("nonce").quantity(_t.nonce());
+    _writer.key("to");
+    if (_t.isCreation())
+        _writer.null();
+    else
+        _writer.hex(_t.receiveAddress());
+    _writer.key("transactionIndex").quantity(uint64_t(_location.second));
+    _writer.key("value").quantity(_t.value());
+    _writer.endObject();
+}
+
+void writeJson(JsonWriter& _writer, Block const& _block, bool _includeTransactions)
+{
+    auto const& header = _block.blockHeader();
+    h256 hash = header.hash();
+    _writer.beginObject();
+    _writer.key("extraData").beginArray();
+    for (auto const& data : header.extraData())
+        _writer.hex(ref(data));
+    _writer.endArray();
+    _writer.key("gasLimit").quantity(header.gasLimit());
+    _writer.key("gasUsed").quantity(header.gasUsed());
+    _writer.key("hash").hex(hash);
+    _writer.key("logsBloom").hex(header.logBloom());
+    _writer.key("number").quantity(uint64_t(header.number()));
+    _writer.key("parentHash").hex(header.parentHash());
+    _writer.key("sealer").quantity(header.sealer());
+    _writer.key("stateRoot").hex(header.stateRoot());
+    _writer.key("timestamp").quantity(header.timestamp());
+    _writer.key("transactions").beginArray();
+    auto const& transactions = _block.transactions();
+    for (unsigned i = 0; i < transactions.size(); i++)
+    {
+        if (_includeTransactions)
+            writeJson(_writer, transactions[i], std::make_pair(hash, i), header.number());
+        else
+            _writer.hex(transactions[i].sha3());
+    }
+    _writer.endArray();
+    _writer.key("transactionsRoot").hex(header.transactionsRoot());
+    _writer.endObject();
+}
+
+void writeJson(JsonWriter& _writer, LocalisedTransaction const& _t)
+{
+    _writer.beginObject();
+    _writer.key("blockHash").hex(_t.blockHash());
+    _writer.key("blockNumber").quantity(uint64_t(_t.blockNumber()));
+    _writer.key("from").hex(_t.from());
+    _writer.key("gas").quantity(_t.gas());
+    _writer.key("gasPrice").quantity(_t.gasPrice());
+    _writer.key("hash").hex(_t.sha3());
+    _writer.key("input").hex(ref(_t.data()));
+    _writer.key("nonce").quantity(_t.nonce());
+    _writer.key("to").hex(_t.to());
+    _writer.key("transactionIndex").quantity(uint64_t(_t.transactionIndex()));
+    _writer.key("value").quantity(_t.value());
+    _writer.endObject();
+}
+
+void writeJson(JsonWriter& _writer, LocalisedTransactionReceipt const& _receipt)
+{
+    _writer.beginObject();
+    _writer.key("blockHash").hex(_receipt.blockHash());
+    _writer.key("blockNumber").quantity(uint64_t(_receipt.blockNumber()));
+    _writer.key("contractAddress").hex(_receipt.contractAddress());
+    _writer.key("from").hex(_receipt.from());
+    _writer.key("gasUsed").quantity(_receipt.gasUsed());
+    _writer.key("logs").beginArray();
+    for (auto const& log : _receipt.log())
+    {
+        _writer.beginObject();
+        _writer.key("address").hex(log.address);
+        _writer.key("data").hex(ref(log.data));
+        _writer.key("topics").beginArray();
+        for (auto const& topic : log.topics)
+            _writer.hex(topic);
+        _writer.endArray();
+        _writer.endObject();
+    }
+    _writer.endArray();
+    _writer.key("logsBloom").hex(_receipt.bloom());
+    _writer.key("output").hex(ref(_receipt.outputBytes()));
+    _writer.key("status").quantity(_receipt.status());
+    _writer.key("to").hex(_receipt.to());
+    _writer.key("transactionHash").hex(_receipt.hash());
+    _writer.key("transactionIndex").quantity(uint64_t(_receipt.transactionIndex()));
+    _writer.endObject();
+}
+
 TransactionSkeleton toTransactionSkeleton(Json::Value const& _json)
 {
     TransactionSkeleton ret;
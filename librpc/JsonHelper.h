@@ -20,17 +20,33 @@
  */
 #pragma once
 
+#include "JsonWriter.h"
 #include <json/json.h>
 #include <libethcore/Common.h>
 
 namespace dev
 {
+namespace eth
+{
+class Block;
+class LocalisedTransaction;
+class LocalisedTransactionReceipt;
+}  // namespace eth
+
 namespace rpc
 {
 Json::Value toJson(dev::eth::Transaction const& _t, std::pair<h256, unsigned> _location,
     dev::eth::BlockNumber _blockNumber);
 dev::eth::TransactionSkeleton toTransactionSkeleton(Json::Value const& _json);
 
+/// the streaming counterparts of the Json::Value responses of the block and receipt methods
+void writeJson(JsonWriter& _writer, dev::eth::Transaction const& _t,
+    std::pair<h256, unsigned> _location, dev::eth::BlockNumber _blockNumber);
+void writeJson(JsonWriter& _writer, dev::eth::Block const& _block, bool _includeTransactions);
+/// the getTransactionByHash and getTransactionBy*AndIndex result
+void writeJson(JsonWriter& _writer, dev::eth::LocalisedTransaction const& _t);
+void writeJson(JsonWriter& _writer, dev::eth::LocalisedTransactionReceipt const& _receipt);
+
 }  // namespace rpc
 
 }  // namespace dev
@@ -0,0 +1,215 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @file JsonWriter.cpp
+ */
+
+#include "JsonWriter.h"
+#include <libdevcore/CommonData.h>
+#include <cstring>
+#include <limits>
+
+using namespace dev;
+using namespace dev::rpc;
+
+namespace
+{
+const char c_hexDigits[] = "0123456789abcdef";
+
+/// the two digits of every byte, the hex loop has no branch and no shift per nibble
+struct HexPairs
+{
+    HexPairs()
+    {
+        for (size_t i = 0; i < 256; ++i)
+        {
+            pairs[2 * i] = c_hexDigits[i >> 4];
+            pairs[2 * i + 1] = c_hexDigits[i & 0xf];
+        }
+    }
+    char pairs[512];
+};
+const HexPairs c_hexPairs;
+}  // namespace
+
+void JsonWriter::separate()
+{
+    if (m_out.empty())
+    {
+        return;
+    }
+    char last = m_out.back();
+    if (last != '{' && last != '[' && last != ':')
+    {
+        m_out.push_back(',');
+    }
+}
+
+JsonWriter& JsonWriter::beginObject()
+{
+    separate();
+    m_out.push_back('{');
+    return *this;
+}
+
+JsonWriter& JsonWriter::endObject()
+{
+    m_out.push_back('}');
+    return *this;
+}
+
+JsonWriter& JsonWriter::beginArray()
+{
+    separate();
+    m_out.push_back('[');
+    return *this;
+}
+
+JsonWriter& JsonWriter::endArray()
+{
+    m_out.push_back(']');
+    return *this;
+}
+
+JsonWriter& JsonWriter::key(char const* _key)
+{
+    separate();
+    m_out.push_back('"');
+    m_out.append(_key);
+    m_out.append("\":");
+    return *this;
+}
+
+JsonWriter& JsonWriter::null()
+{
+    separate();
+    m_out.append("null");
+    return *this;
+}
+
+JsonWriter& JsonWriter::string(std::string const& _value)
+{
+    separate();
+    m_out.push_back('"');
+    for (unsigned char c : _value)
+    {
+        switch (c)
+        {
+        case '"':
+            m_out.append("\\\"");
+            break;
+        case '\\':
+            m_out.append("\\\\");
+            break;
+        case '\b':
+            m_out.append("\\b");
+            break;
+        case '\f':
+            m_out.append("\\f");
+            break;
+        case '\n':
+            m_out.append("\\n");
+            break;
+        case '\r':
+            m_out.append("\\r");
+            break;
+        case '\t':
+            m_out.append("\\t");
+            break;
+        default:
+            if (c < 0x20)
+            {
+                m_out.append("\\u00");
+                m_out.push_back(c_hexDigits[c >> 4]);
+                m_out.push_back(c_hexDigits[c & 0xf]);
+            }
+            else
+            {
+                m_out.push_back(c);
+            }
+        }
+    }
+    m_out.push_back('"');
+    return *this;
+}
+
+JsonWriter& JsonWriter::hex(bytesConstRef _data)
+{
+    separate();
+    size_t offset = m_out.size();
+    m_out.resize(offset + 4 + 2 * _data.size());
+    char* out = &m_out[offset];
+    *out++ = '"';
+    *out++ = '0';
+    *out++ = 'x';
+    for (size_t i = 0; i < _data.size(); ++i, out += 2)
+    {
+        std::memcpy(out, c_hexPairs.pairs + 2 * _data[i], 2);
+    }
+    *out = '"';
+    return *this;
+}
+
+JsonWriter& JsonWriter::quantity(uint64_t _value)
+{
+    char digits[16];
+    size_t size = 0;
+    do
+    {
+        digits[size++] = c_hexDigits[_value & 0xf];
+        _value >>= 4;
+    } while (_value);
+
+    separate();
+    m_out.append("\"0x");
+    while (size)
+    {
+        m_out.push_back(digits[--size]);
+    }
+    m_out.push_back('"');
+    return *this;
+}
+
+JsonWriter& JsonWriter::quantity(u256 const& _value)
+{
+    if (_value <= std::numeric_limits<uint64_t>::max())
+    {
+        return quantity(_value.convert_to<uint64_t>());
+    }
+    bytes data = toCompactBigEndian(_value, 1);
+    separate();
+    m_out.append("\"0x");
+    // the first byte has no leading zero digit
+    if (data[0] >> 4)
+    {
+        m_out.push_back(c_hexDigits[data[0] >> 4]);
+    }
+    m_out.push_back(c_hexDigits[data[0] & 0xf]);
+    size_t offset = m_out.size();
+    m_out.resize(offset + 2 * (data.size() - 1));
+    for (size_t i = 1; i < data.size(); ++i)
+    {
+        std::memcpy(&m_out[offset + 2 * (i - 1)], c_hexPairs.pairs + 2 * data[i], 2);
+    }
+    m_out.push_back('"');
+    return *this;
+}
+
+JsonWriter& JsonWriter::raw(std::string const& _text)
+{
+    m_out.append(_text);
+    return *this;
+}
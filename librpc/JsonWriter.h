@@ -0,0 +1,69 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @file JsonWriter.h
+ */
+#pragma once
+
+#include <libdevcore/Common.h>
+#include <libdevcore/FixedHash.h>
+#include <string>
+
+namespace dev
+{
+namespace rpc
+{
+/// Streams JSON text into a buffer that is kept between documents. The values are written the
+/// way toJS formats them, so the text is the one jsoncpp renders from the Json::Value tree when
+/// the keys are written in sorted order.
+class JsonWriter
+{
+public:
+    /// starts a new document, the buffer keeps its capacity
+    void clear() { m_out.clear(); }
+    std::string const& str() const { return m_out; }
+
+    JsonWriter& beginObject();
+    JsonWriter& endObject();
+    JsonWriter& beginArray();
+    JsonWriter& endArray();
+    /// _key is not escaped
+    JsonWriter& key(char const* _key);
+
+    JsonWriter& null();
+    JsonWriter& string(std::string const& _value);
+    /// "0x" followed by two digits per byte, as toJS(bytes) and toJS(FixedHash)
+    JsonWriter& hex(bytesConstRef _data);
+    template <unsigned N>
+    JsonWriter& hex(FixedHash<N> const& _hash)
+    {
+        return hex(_hash.ref());
+    }
+    /// "0x" followed by the digits without leading zeros, as toJS of the integers
+    JsonWriter& quantity(u256 const& _value);
+    JsonWriter& quantity(uint64_t _value);
+    /// text appended as it is, without separator
+    JsonWriter& raw(std::string const& _text);
+
+private:
+    /// the comma before a value or key that follows another one
+    void separate();
+
+    std::string m_out;
+};
+
+}  // namespace rpc
+}  // namespace dev
@@ -133,6 +133,12 @@ public:
 
     /// server takes ownership of the connector
     unsigned addConnector(jsonrpc::AbstractServerConnector* _connector)
+    {
+        return addConnector(std::shared_ptr<jsonrpc::AbstractServerConnector>(_connector));
+    }
+
+    /// server shares the ownership of the connector
+    unsigned addConnector(std::shared_ptr<jsonrpc::AbstractServerConnector> _connector)
     {
         m_connectors.emplace_back(_connector);
         _connector->SetHandler(m_handler.get());
@@ -145,7 +151,7 @@ public:
     }
 
 protected:
-    std::vector<std::unique_ptr<jsonrpc::AbstractServerConnector>> m_connectors;
+    std::vector<std::shared_ptr<jsonrpc::AbstractServerConnector>> m_connectors;
     std::unique_ptr<jsonrpc::IProtocolHandler> m_handler;
     /// Mapping for implemented modules, to be filled by subclasses during construction.
     Json::Value m_implementedModules;
@@ -0,0 +1,76 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @file ResponseCache.cpp
+ */
+
+#include "ResponseCache.h"
+#include <algorithm>
+
+using namespace dev;
+using namespace dev::rpc;
+
+ResponseCache::ResponseCache(size_t _capacity, size_t _shards)
+{
+    _shards = std::max<size_t>(1, _shards);
+    for (size_t i = 0; i < _shards; ++i)
+    {
+        m_shards.emplace_back(new Shard(
+            _capacity / _shards, [](Response const& _response) { return _response->size(); }));
+    }
+}
+
+ResponseCache::Response ResponseCache::get(std::string const& _key)
+{
+    Response response;
+    shard(_key).get(_key, response);
+    return response;
+}
+
+void ResponseCache::put(std::string const& _key, std::string const& _response)
+{
+    shard(_key).put(_key, std::make_shared<std::string const>(_response));
+}
+
+uint64_t ResponseCache::hits() const
+{
+    uint64_t hits = 0;
+    for (auto const& shard : m_shards)
+    {
+        hits += shard->hits();
+    }
+    return hits;
+}
+
+uint64_t ResponseCache::misses() const
+{
+    uint64_t misses = 0;
+    for (auto const& shard : m_shards)
+    {
+        misses += shard->misses();
+    }
+    return misses;
+}
+
+size_t ResponseCache::size() const
+{
+    size_t size = 0;
+    for (auto const& shard : m_shards)
+    {
+        size += shard->cost();
+    }
+    return size;
+}
@@ -0,0 +1,59 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @file ResponseCache.h
+ */
+#pragma once
+
+#include <libdevcore/LRUCache.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace dev
+{
+namespace rpc
+{
+/// Rendered results of the queries whose answer never changes once the block is committed,
+/// e.g. a block by hash or a receipt. The entries are spread over shards with their own lock
+/// and the whole cache is bounded by the bytes of the results.
+class ResponseCache
+{
+public:
+    typedef std::shared_ptr<ResponseCache> Ptr;
+    typedef std::shared_ptr<std::string const> Response;
+
+    ResponseCache(size_t _capacity, size_t _shards = 16);
+
+    /// @return nullptr if _key is not cached
+    Response get(std::string const& _key);
+    void put(std::string const& _key, std::string const& _response);
+
+    uint64_t hits() const;
+    uint64_t misses() const;
+    /// bytes of the cached results
+    size_t size() const;
+
+private:
+    typedef LRUCache<std::string, Response> Shard;
+    Shard& shard(std::string const& _key) { return *m_shards[m_hash(_key) % m_shards.size()]; }
+
+    std::hash<std::string> m_hash;
+    std::vector<std::unique_ptr<Shard>> m_shards;
+};
+
+}  // namespace rpc
+}  // namespace dev
@@ -34,12 +34,17 @@
 #include <libtxpool/TxPoolInterface.h>
 #include <boost/algorithm/hex.hpp>
 #include <csignal>
+#include <future>
+#include <thread>
 
 using namespace jsonrpc;
 using namespace dev::rpc;
 using namespace dev::sync;
 using namespace dev::ledger;
 
+/// the response cache statistics are logged every c_responseCacheStatsInterval misses
+static const uint64_t c_responseCacheStatsInterval = 1000;
+
 Rpc::Rpc(std::shared_ptr<dev::ledger::LedgerManager> _ledgerManager,
     std::shared_ptr<dev::p2p::P2PInterface> _service)
   : m_ledgerManager(_ledgerManager), m_service(_service)
@@ -392,20 +397,19 @@ Json::Value Rpc::getBlockByHash(
                 JsonRpcException(RPCExceptionType::BlockHash, RPCMsg[RPCExceptionType::BlockHash]));
 
         response["number"] = toJS(block->header().number());
-        response["hash"] = _blockHash;
+        response["hash"] = toJS(hash);
         response["parentHash"] = toJS(block->header().parentHash());
         response["logsBloom"] = toJS(block->header().logBloom());
         response["transactionsRoot"] = toJS(block->header().transactionsRoot());
         response["stateRoot"] = toJS(block->header().stateRoot());
         response["sealer"] = toJS(block->header().sealer());
         response["extraData"] = Json::Value(Json::arrayValue);
-        auto datas = block->header().extraData();
-        for (auto data : datas)
+        for (auto const& data : block->header().extraData())
             response["extraData"].append(toJS(data));
         response["gasLimit"] = toJS(block->header().gasLimit());
         response["gasUsed"] = toJS(block->header().gasUsed());
         response["timestamp"] = toJS(block->header().timestamp());
-        auto transactions = block->transactions();
+        auto const& transactions = block->transactions();
         response["transactions"] = Json::Value(Json::arrayValue);
         for (unsigned i = 0; i < transactions.size(); i++)
         {
@@ -460,13 +464,12 @@ Json::Value Rpc::getBlockByNumber(
         response["stateRoot"] = toJS(block->header().stateRoot());
         response["sealer"] = toJS(block->header().sealer());
         response["extraData"] = Json::Value(Json::arrayValue);
-        auto datas = block->header().extraData();
-        for (auto data : datas)
+        for (auto const& data : block->header().extraData())
             response["extraData"].append(toJS(data));
         response["gasLimit"] = toJS(block->header().gasLimit());
         response["gasUsed"] = toJS(block->header().gasUsed());
         response["timestamp"] = toJS(block->header().timestamp());
-        auto transactions = block->transactions();
+        auto const& transactions = block->transactions();
         response["transactions"] = Json::Value(Json::arrayValue);
         for (unsigned i = 0; i < transactions.size(); i++)
         {
@@ -583,13 +586,13 @@ Json::Value Rpc::getTransactionByBlockHashAndIndex(
             BOOST_THROW_EXCEPTION(
                 JsonRpcException(RPCExceptionType::BlockHash, RPCMsg[RPCExceptionType::BlockHash]));
 
-        auto transactions = block->transactions();
+        auto const& transactions = block->transactions();
         unsigned int txIndex = jsToInt(_transactionIndex);
         if (txIndex >= transactions.size())
             BOOST_THROW_EXCEPTION(JsonRpcException(
                 RPCExceptionType::TransactionIndex, RPCMsg[RPCExceptionType::TransactionIndex]));
 
-        Transaction tx = transactions[txIndex];
+        Transaction const& tx = transactions[txIndex];
         response["blockHash"] = _blockHash;
         response["blockNumber"] = toJS(block->header().number());
         response["from"] = toJS(tx.from());
@@ -638,13 +641,13 @@ Json::Value Rpc::getTransactionByBlockNumberAndIndex(
             BOOST_THROW_EXCEPTION(JsonRpcException(
                 RPCExceptionType::BlockNumberT, RPCMsg[RPCExceptionType::BlockNumberT]));
 
-        Transactions transactions = block->transactions();
+        auto const& transactions = block->transactions();
         unsigned int txIndex = jsToInt(_transactionIndex);
         if (txIndex >= transactions.size())
             BOOST_THROW_EXCEPTION(JsonRpcException(
                 RPCExceptionType::TransactionIndex, RPCMsg[RPCExceptionType::TransactionIndex]));
 
-        Transaction tx = transactions[txIndex];
+        Transaction const& tx = transactions[txIndex];
         response["blockHash"] = toJS(block->header().hash());
         response["blockNumber"] = toJS(block->header().number());
         response["from"] = toJS(tx.from());
@@ -690,7 +693,7 @@ Json::Value Rpc::getTransactionReceipt(int _groupID, const std::string& _transac
         if (txReceipt.blockNumber() == INVALIDNUMBER)
             return Json::nullValue;
 
-        response["transactionHash"] = _transactionHash;
+        response["transactionHash"] = toJS(hash);
         response["transactionIndex"] = toJS(txReceipt.transactionIndex());
         response["blockNumber"] = toJS(txReceipt.blockNumber());
         response["blockHash"] = toJS(txReceipt.blockHash());
@@ -727,6 +730,54 @@ Json::Value Rpc::getTransactionReceipt(int _groupID, const std::string& _transac
 }
 
 
+/// a pending transaction as getPendingTransactions reports it
+static Json::Value pendingToJson(Transaction const& _tx)
+{
+    Json::Value txJson;
+    txJson["from"] = toJS(_tx.from());
+    txJson["gas"] = toJS(_tx.gas());
+    txJson["gasPrice"] = toJS(_tx.gasPrice());
+    txJson["hash"] = toJS(_tx.sha3());
+    txJson["input"] = toJS(_tx.data());
+    txJson["nonce"] = toJS(_tx.nonce());
+    txJson["to"] = toJS(_tx.to());
+    txJson["value"] = toJS(_tx.value());
+    return txJson;
+}
+
+/// the cursors handed to the clients are "<import time>:<import order>:<hash>" of the last
+/// transaction visited
+static std::string cursorToString(dev::txpool::PendingCursor const& _cursor)
+{
+    return toJS(_cursor.importTime) + ":" + toJS(_cursor.importSeq) + ":" + _cursor.hash.hex();
+}
+
+static dev::txpool::PendingCursor cursorFromString(std::string const& _cursor)
+{
+    dev::txpool::PendingCursor cursor;
+    if (_cursor.empty())
+    {
+        return cursor;
+    }
+    auto separatorPos = _cursor.find(':');
+    auto hashPos = _cursor.rfind(':');
+    if (separatorPos == std::string::npos || hashPos == separatorPos)
+    {
+        BOOST_THROW_EXCEPTION(JsonRpcException(Errors::ERROR_RPC_INVALID_PARAMS, "invalid cursor"));
+    }
+    cursor.importTime = jsToU256(_cursor.substr(0, separatorPos));
+    cursor.importSeq = static_cast<uint64_t>(
+        jsToU256(_cursor.substr(separatorPos + 1, hashPos - separatorPos - 1)));
+    cursor.hash = h256(_cursor.substr(hashPos + 1));
+    return cursor;
+}
+
+/// max transactions of a getPendingTransactionsPage answer, and the default
+static const size_t c_maxPendingPage = 1000;
+static const size_t c_defaultPendingPage = 100;
+/// senders reported by getPendingTransactionsStats
+static const size_t c_pendingTopSenders = 10;
+
 Json::Value Rpc::getPendingTransactions(int _groupID)
 {
     try
@@ -741,22 +792,118 @@ Json::Value Rpc::getPendingTransactions(int _groupID)
                 JsonRpcException(RPCExceptionType::GroupID, RPCMsg[RPCExceptionType::GroupID]));
 
         response = Json::Value(Json::arrayValue);
-        Transactions transactions = txPool->pendingList();
-        for (size_t i = 0; i < transactions.size(); ++i)
+        // read page by page, the pool is never locked nor copied as a whole
+        dev::txpool::PendingCursor cursor;
+        bool more = true;
+        while (more)
+        {
+            Transactions transactions;
+            more = txPool->pendingPage(cursor, c_maxPendingPage, transactions);
+            for (auto const& tx : transactions)
+                response.append(pendingToJson(tx));
+        }
+
+        return response;
+    }
+    catch (JsonRpcException& e)
+    {
+        throw e;
+    }
+    catch (std::exception& e)
+    {
+        BOOST_THROW_EXCEPTION(
+            JsonRpcException(Errors::ERROR_RPC_INTERNAL_ERROR, boost::diagnostic_information(e)));
+    }
+}
+
+Json::Value Rpc::getPendingTransactionsPage(int _groupID, const Json::Value& _options)
+{
+    try
+    {
+        RPC_LOG(INFO) << "[#getPendingTransactionsPage] [groupID/options]: " << _groupID << "/"
+                      << Json::FastWriter().write(_options);
+
+        auto txPool = ledgerManager()->txPool(_groupID);
+        if (!txPool)
+            BOOST_THROW_EXCEPTION(
+                JsonRpcException(RPCExceptionType::GroupID, RPCMsg[RPCExceptionType::GroupID]));
+
+        auto cursor = cursorFromString(_options.get("cursor", "").asString());
+        size_t limit = c_defaultPendingPage;
+        if (_options.isMember("limit"))
+            limit = std::min<size_t>(c_maxPendingPage, _options["limit"].asUInt());
+        std::function<bool(Transaction const&)> condition;
+        if (_options.isMember("from"))
         {
-            auto tx = transactions[i];
-            Json::Value txJson;
-            txJson["from"] = toJS(tx.from());
-            txJson["gas"] = toJS(tx.gas());
-            txJson["gasPrice"] = toJS(tx.gasPrice());
-            txJson["hash"] = toJS(tx.sha3());
-            txJson["input"] = toJS(tx.data());
-            txJson["nonce"] = toJS(tx.nonce());
-            txJson["to"] = toJS(tx.to());
-            txJson["value"] = toJS(tx.value());
-            response.append(txJson);
+            Address from = jsToAddress(_options["from"].asString());
+            condition = [from](Transaction const& _tx) { return _tx.safeSender() == from; };
+        }
+
+        Transactions transactions;
+        bool more = txPool->pendingPage(cursor, limit, transactions, condition);
+        Json::Value response;
+        response["transactions"] = Json::Value(Json::arrayValue);
+        for (auto const& tx : transactions)
+            response["transactions"].append(pendingToJson(tx));
+        response["cursor"] = cursorToString(cursor);
+        response["more"] = more;
+        return response;
+    }
+    catch (JsonRpcException& e)
+    {
+        throw e;
+    }
+    catch (std::exception& e)
+    {
+        BOOST_THROW_EXCEPTION(
+            JsonRpcException(Errors::ERROR_RPC_INTERNAL_ERROR, boost::diagnostic_information(e)));
+    }
+}
+
+Json::Value Rpc::getPendingTransactionsStats(int _groupID)
+{
+    try
+    {
+        RPC_LOG(INFO) << "[#getPendingTransactionsStats] [groupID]: " << _groupID;
+
+        auto txPool = ledgerManager()->txPool(_groupID);
+        if (!txPool)
+            BOOST_THROW_EXCEPTION(
+                JsonRpcException(RPCExceptionType::GroupID, RPCMsg[RPCExceptionType::GroupID]));
+
+        auto stats = txPool->pendingStats({1000, 10000, 60000, 600000});
+        Json::Value response;
+        response["count"] = toJS(stats.count);
+        response["inputBytes"] = toJS(stats.inputBytes);
+        response["ages"] = Json::Value(Json::arrayValue);
+        for (size_t i = 0; i < stats.ages.size(); ++i)
+        {
+            Json::Value age;
+            // the last bucket has no bound
+            if (i < stats.ageBoundsMs.size())
+                age["maxAgeMs"] = toJS(stats.ageBoundsMs[i]);
+            else
+                age["maxAgeMs"] = Json::Value();
+            age["count"] = toJS(stats.ages[i]);
+            response["ages"].append(age);
         }
 
+        std::vector<std::pair<Address, size_t>> senders(
+            stats.senders.begin(), stats.senders.end());
+        size_t top = std::min(c_pendingTopSenders, senders.size());
+        std::partial_sort(senders.begin(), senders.begin() + top, senders.end(),
+            [](std::pair<Address, size_t> const& _a, std::pair<Address, size_t> const& _b) {
+                return _a.second > _b.second;
+            });
+        response["senderCount"] = toJS(senders.size());
+        response["senders"] = Json::Value(Json::arrayValue);
+        for (size_t i = 0; i < top; ++i)
+        {
+            Json::Value sender;
+            sender["from"] = toJS(senders[i].first);
+            sender["count"] = toJS(senders[i].second);
+            response["senders"].append(sender);
+        }
         return response;
     }
     catch (JsonRpcException& e)
@@ -897,3 +1044,373 @@ std::string Rpc::sendRawTransaction(int _groupID, const std::string& _rlp)
             JsonRpcException(Errors::ERROR_RPC_INTERNAL_ERROR, boost::diagnostic_information(e)));
     }
 }
+
+/// the transactions of a sendRawTransactions call
+static const size_t c_maxRawTransactions = 10000;
+/// a decoding thread is started for every c_minTransactionsPerThread transactions of a batch
+static const size_t c_minTransactionsPerThread = 64;
+
+std::vector<ImportResult> Rpc::submitTransactions(int _groupID, Json::Value const& _rlps,
+    h256s& o_hashes, std::function<void(size_t, Transaction&)> const& _prepare)
+{
+    auto txPool = ledgerManager()->txPool(_groupID);
+    if (!txPool)
+        BOOST_THROW_EXCEPTION(
+            JsonRpcException(RPCExceptionType::GroupID, RPCMsg[RPCExceptionType::GroupID]));
+    if (!_rlps.isArray() || _rlps.size() > c_maxRawTransactions)
+        BOOST_THROW_EXCEPTION(JsonRpcException(Errors::ERROR_RPC_INVALID_PARAMS,
+            "expected an array of at most " + std::to_string(c_maxRawTransactions) +
+                " transactions"));
+
+    // every thread decodes a stride of the batch and recovers the senders, the caller takes the
+    // first one
+    size_t count = _rlps.size();
+    Transactions txs(count);
+    std::vector<char> decoded(count, 0);
+    o_hashes.assign(count, h256());
+    size_t threads = std::min<size_t>(std::max<size_t>(1, std::thread::hardware_concurrency()),
+        (count + c_minTransactionsPerThread - 1) / c_minTransactionsPerThread);
+    auto decodeStride = [&](size_t _first) {
+        for (size_t i = _first; i < count; i += threads)
+        {
+            Json::Value const& rlp = _rlps[Json::ArrayIndex(i)];
+            if (!rlp.isString())
+                continue;
+            try
+            {
+                bytes txBytes = jsToBytes(rlp.asString(), OnFailed::Throw);
+                txs[i].decode(ref(txBytes), CheckTransaction::Everything);
+                // the encoding must be canonical, as for the transactions of the peers
+                if (sha3(txBytes) != txs[i].sha3())
+                    continue;
+                o_hashes[i] = txs[i].sha3();
+                decoded[i] = 1;
+            }
+            catch (std::exception& e)
+            {
+                RPC_LOG(TRACE) << "[#sendRawTransactions] invalid transaction [index]: " << i
+                               << ", " << boost::diagnostic_information(e);
+            }
+        }
+    };
+    std::vector<std::future<void>> futures;
+    for (size_t t = 1; t < threads; ++t)
+    {
+        futures.push_back(std::async(std::launch::async, decodeStride, t));
+    }
+    decodeStride(0);
+    for (auto& future : futures)
+    {
+        future.get();
+    }
+
+    Transactions valid;
+    valid.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (!decoded[i])
+            continue;
+        if (_prepare)
+            _prepare(i, txs[i]);
+        valid.push_back(std::move(txs[i]));
+    }
+    auto validResults = txPool->batchImport(valid);
+    std::vector<ImportResult> results(count, ImportResult::Malformed);
+    for (size_t i = 0, j = 0; i < count; ++i)
+    {
+        if (decoded[i])
+            results[i] = validResults[j++];
+    }
+    return results;
+}
+
+Json::Value Rpc::sendRawTransactions(int _groupID, const Json::Value& _rlps)
+{
+    try
+    {
+        RPC_LOG(INFO) << "[#sendRawTransactions] [groupID/transactions]: " << _groupID << "/"
+                      << _rlps.size() << std::endl;
+
+        h256s hashes;
+        auto results = submitTransactions(_groupID, _rlps, hashes);
+        Json::Value response(Json::arrayValue);
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            Json::Value item;
+            item["transactionHash"] = hashes[i] ? Json::Value(toJS(hashes[i])) : Json::Value();
+            item["status"] = toJS(unsigned(results[i]));
+            response.append(item);
+        }
+        return response;
+    }
+    catch (JsonRpcException& e)
+    {
+        throw e;
+    }
+    catch (std::exception& e)
+    {
+        BOOST_THROW_EXCEPTION(
+            JsonRpcException(Errors::ERROR_RPC_INTERNAL_ERROR, boost::diagnostic_information(e)));
+    }
+}
+
+bool Rpc::sendRawTransactionsAsync(Json::Value const& _params, RpcDispatcher::Done const& _done)
+{
+    if (!_params.isArray() || _params.size() < 2 || _params.size() > 3 || !_params[0].isInt() ||
+        !_params[1].isArray() || (_params.size() == 3 && !_params[2].isBool()))
+        return false;
+    int groupID = _params[0].asInt();
+    bool waitForReceipts = _params.size() == 3 && _params[2].asBool();
+    RPC_LOG(INFO) << "[#sendRawTransactions] [groupID/transactions/waitForReceipts]: " << groupID
+                  << "/" << _params[1].size() << "/" << waitForReceipts << std::endl;
+
+    // the receipts come on the thread committing the block, under the lock of the pool, the
+    // last one hands the result over to the dispatcher. A transaction the pool drops comes
+    // with a null receipt and is answered with its import status only
+    struct Pending
+    {
+        Mutex x_receipts;
+        h256s hashes;
+        std::vector<ImportResult> results;
+        std::vector<LocalisedTransactionReceipt::Ptr> receipts;
+        // the receipts still expected, and one for the submission itself
+        size_t left;
+    };
+    auto pending = std::make_shared<Pending>();
+    pending->receipts.resize(_params[1].size());
+    pending->left = _params[1].size() + 1;
+    auto finish = [pending, _done]() {
+        _done([pending](JsonWriter& _writer) {
+            _writer.beginArray();
+            for (size_t i = 0; i < pending->results.size(); ++i)
+            {
+                _writer.beginObject().key("status").quantity(uint64_t(pending->results[i]));
+                _writer.key("transactionHash");
+                if (pending->hashes[i])
+                    _writer.hex(pending->hashes[i]);
+                else
+                    _writer.null();
+                if (pending->receipts[i])
+                {
+                    _writer.key("receipt");
+                    writeJson(_writer, *pending->receipts[i]);
+                }
+                _writer.endObject();
+            }
+            _writer.endArray();
+        });
+    };
+    std::function<void(size_t, Transaction&)> prepare;
+    if (waitForReceipts)
+    {
+        prepare = [pending, finish](size_t _index, Transaction& _tx) {
+            _tx.setRpcCallback([pending, finish, _index](LocalisedTransactionReceipt::Ptr _r) {
+                {
+                    Guard l(pending->x_receipts);
+                    pending->receipts[_index] = _r;
+                    if (--pending->left)
+                        return;
+                }
+                finish();
+            });
+        };
+    }
+    try
+    {
+        h256s hashes;
+        auto results = submitTransactions(groupID, _params[1], hashes, prepare);
+        {
+            Guard l(pending->x_receipts);
+            pending->hashes = std::move(hashes);
+            pending->results = std::move(results);
+            // no receipt comes for the transactions the pool refused
+            size_t refused = 1;
+            for (auto result : pending->results)
+            {
+                if (!waitForReceipts || result != ImportResult::Success)
+                    ++refused;
+            }
+            pending->left -= refused;
+            if (pending->left)
+                return true;
+        }
+        finish();
+        return true;
+    }
+    catch (std::exception& e)
+    {
+        // the handler reports the error
+        RPC_LOG(TRACE) << "[#sendRawTransactions] refused: " << boost::diagnostic_information(e);
+        return false;
+    }
+}
+
+bool Rpc::writeBlockByHash(Json::Value const& _params, JsonWriter& _writer)
+{
+    if (!_params.isArray() || _params.size() != 3 || !_params[0].isInt() ||
+        !_params[1].isString() || !_params[2].isBool())
+        return false;
+    int groupID = _params[0].asInt();
+    std::string blockHash = _params[1].asString();
+    bool includeTransactions = _params[2].asBool();
+    RPC_LOG(INFO) << "[#getBlockByHash] [groupID/blockHash/includeTransactions]: " << groupID
+                  << "/" << blockHash << "/" << includeTransactions << std::endl;
+
+    h256 hash = jsToFixed<32>(blockHash);
+    std::string key = std::to_string(groupID) + "/getBlockByHash/" + hash.hex() +
+                      (includeTransactions ? "/1" : "/0");
+    if (writeCached(key, _writer))
+        return true;
+    auto blockchain = ledgerManager()->blockChain(groupID);
+    if (!blockchain)
+        return false;
+    auto block = blockchain->getBlockByHash(hash);
+    if (!block)
+        return false;
+    size_t offset = _writer.str().size();
+    writeJson(_writer, *block, includeTransactions);
+    cacheResult(key, _writer, offset);
+    return true;
+}
+
+bool Rpc::writeBlockByNumber(Json::Value const& _params, JsonWriter& _writer)
+{
+    if (!_params.isArray() || _params.size() != 3 || !_params[0].isInt() ||
+        !_params[1].isString() || !_params[2].isBool())
+        return false;
+    int groupID = _params[0].asInt();
+    std::string blockNumber = _params[1].asString();
+    bool includeTransactions = _params[2].asBool();
+    RPC_LOG(INFO) << "[#getBlockByNumber] [groupID/blockNumber/includeTransactions]: " << groupID
+                  << "/" << blockNumber << "/" << includeTransactions << std::endl;
+
+    // a committed block is final, the number names it as well as the hash
+    BlockNumber number = jsToBlockNumber(blockNumber);
+    std::string key = std::to_string(groupID) + "/getBlockByNumber/" + std::to_string(number) +
+                      (includeTransactions ? "/1" : "/0");
+    if (writeCached(key, _writer))
+        return true;
+    auto blockchain = ledgerManager()->blockChain(groupID);
+    if (!blockchain)
+        return false;
+    auto block = blockchain->getBlockByNumber(number);
+    if (!block)
+        return false;
+    size_t offset = _writer.str().size();
+    writeJson(_writer, *block, includeTransactions);
+    cacheResult(key, _writer, offset);
+    return true;
+}
+
+bool Rpc::writeTransactionByHash(Json::Value const& _params, JsonWriter& _writer)
+{
+    if (!_params.isArray() || _params.size() != 2 || !_params[0].isInt() ||
+        !_params[1].isString())
+        return false;
+    int groupID = _params[0].asInt();
+    std::string transactionHash = _params[1].asString();
+    RPC_LOG(INFO) << "[#getTransactionByHash] [groupID/transactionHash]: " << groupID << "/"
+                  << transactionHash << std::endl;
+
+    h256 hash = jsToFixed<32>(transactionHash);
+    std::string key = std::to_string(groupID) + "/getTransactionByHash/" + hash.hex();
+    if (writeCached(key, _writer))
+        return true;
+    auto blockchain = ledgerManager()->blockChain(groupID);
+    if (!blockchain)
+        return false;
+    auto tx = blockchain->getLocalisedTxByHash(hash);
+    // not committed yet, the answer may change
+    if (tx.blockNumber() == INVALIDNUMBER)
+    {
+        _writer.null();
+        return true;
+    }
+    size_t offset = _writer.str().size();
+    writeJson(_writer, tx);
+    cacheResult(key, _writer, offset);
+    return true;
+}
+
+bool Rpc::writeTransactionByBlockNumberAndIndex(Json::Value const& _params, JsonWriter& _writer)
+{
+    if (!_params.isArray() || _params.size() != 3 || !_params[0].isInt() ||
+        !_params[1].isString() || !_params[2].isString())
+        return false;
+    int groupID = _params[0].asInt();
+    std::string blockNumber = _params[1].asString();
+    std::string transactionIndex = _params[2].asString();
+    RPC_LOG(INFO)
+        << "[#getTransactionByBlockNumberAndIndex] [groupID/blockNumber/transactionIndex]: "
+        << groupID << "/" << blockNumber << "/" << transactionIndex << std::endl;
+
+    BlockNumber number = jsToBlockNumber(blockNumber);
+    unsigned int txIndex = jsToInt(transactionIndex);
+    std::string key = std::to_string(groupID) + "/getTransactionByBlockNumberAndIndex/" +
+                      std::to_string(number) + "/" + std::to_string(txIndex);
+    if (writeCached(key, _writer))
+        return true;
+    auto blockchain = ledgerManager()->blockChain(groupID);
+    if (!blockchain)
+        return false;
+    auto block = blockchain->getBlockByNumber(number);
+    if (!block || txIndex >= block->transactions().size())
+        return false;
+    size_t offset = _writer.str().size();
+    writeJson(_writer, LocalisedTransaction(block->transactions()[txIndex],
+                           block->header().hash(), txIndex, block->header().number()));
+    cacheResult(key, _writer, offset);
+    return true;
+}
+
+bool Rpc::writeTransactionReceipt(Json::Value const& _params, JsonWriter& _writer)
+{
+    if (!_params.isArray() || _params.size() != 2 || !_params[0].isInt() ||
+        !_params[1].isString())
+        return false;
+    int groupID = _params[0].asInt();
+    std::string transactionHash = _params[1].asString();
+    RPC_LOG(INFO) << "[#getTransactionReceipt] [groupID/transactionHash]: " << groupID << "/"
+                  << transactionHash << "/" << std::endl;
+
+    h256 hash = jsToFixed<32>(transactionHash);
+    std::string key = std::to_string(groupID) + "/getTransactionReceipt/" + hash.hex();
+    if (writeCached(key, _writer))
+        return true;
+    auto blockchain = ledgerManager()->blockChain(groupID);
+    if (!blockchain)
+        return false;
+    auto txReceipt = blockchain->getLocalisedTxReceiptByHash(hash);
+    // not committed yet, the answer may change
+    if (txReceipt.blockNumber() == INVALIDNUMBER)
+    {
+        _writer.null();
+        return true;
+    }
+    size_t offset = _writer.str().size();
+    writeJson(_writer, txReceipt);
+    cacheResult(key, _writer, offset);
+    return true;
+}
+
+bool Rpc::writeCached(std::string const& _key, JsonWriter& _writer)
+{
+    if (!m_responseCache)
+        return false;
+    auto response = m_responseCache->get(_key);
+    if (!response)
+        return false;
+    _writer.raw(*response);
+    return true;
+}
+
+void Rpc::cacheResult(std::string const& _key, JsonWriter const& _writer, size_t _offset)
+{
+    if (!m_responseCache)
+        return;
+    m_responseCache->put(_key, _writer.str().substr(_offset));
+    uint64_t misses = m_responseCache->misses();
+    if (misses % c_responseCacheStatsInterval == 0)
+        RPC_LOG(DEBUG) << "[#ResponseCache] [hits/misses/bytes]: " << m_responseCache->hits()
+                       << "/" << misses << "/" << m_responseCache->size() << std::endl;
+}
@@ -21,6 +21,9 @@
 
 #pragma once
 
+#include "JsonWriter.h"
+#include "ResponseCache.h"
+#include "RpcDispatcher.h"
 #include "RpcFace.h"
 #include <jsonrpccpp/common/exception.h>
 #include <jsonrpccpp/server.h>
@@ -87,10 +90,28 @@ public:
     virtual Json::Value getTransactionReceipt(
         int _groupID, const std::string& _transactionHash) override;
     virtual Json::Value getPendingTransactions(int _groupID) override;
+    virtual Json::Value getPendingTransactionsPage(
+        int _groupID, const Json::Value& _options) override;
+    virtual Json::Value getPendingTransactionsStats(int _groupID) override;
     virtual std::string getCode(int _groupID, const std::string& address) override;
     virtual Json::Value getTotalTransactionCount(int _groupID) override;
     virtual Json::Value call(int _groupID, const Json::Value& request) override;
     virtual std::string sendRawTransaction(int _groupID, const std::string& _rlp) override;
+    virtual Json::Value sendRawTransactions(int _groupID, const Json::Value& _rlps) override;
+    /// sendRawTransactions [groupID, [rlp, ...], waitForReceipts] on the dispatcher: with
+    /// waitForReceipts the result is sent when the admitted transactions are committed, with
+    /// their receipts, or dropped by the pool, without receipt, and no worker waits for it
+    bool sendRawTransactionsAsync(Json::Value const& _params, RpcDispatcher::Done const& _done);
+
+    // streaming part: the results of the large responses are written as JSON text, false when
+    // the params are invalid or nothing was found and the call must report its error
+    bool writeBlockByHash(Json::Value const& _params, JsonWriter& _writer);
+    bool writeBlockByNumber(Json::Value const& _params, JsonWriter& _writer);
+    bool writeTransactionByHash(Json::Value const& _params, JsonWriter& _writer);
+    bool writeTransactionByBlockNumberAndIndex(Json::Value const& _params, JsonWriter& _writer);
+    bool writeTransactionReceipt(Json::Value const& _params, JsonWriter& _writer);
+    /// the streamed results of the committed blocks are kept in _cache
+    void setResponseCache(ResponseCache::Ptr _cache) { m_responseCache = _cache; }
 
 protected:
     std::shared_ptr<dev::ledger::LedgerManager> ledgerManager() { return m_ledgerManager; }
@@ -99,6 +120,20 @@ protected:
     std::shared_ptr<dev::p2p::P2PInterface> m_service;
 
 private:
+    /// writes the cached result of _key, false if there is none
+    bool writeCached(std::string const& _key, JsonWriter& _writer);
+    /// caches the result written by _writer from _offset on
+    void cacheResult(std::string const& _key, JsonWriter const& _writer, size_t _offset);
+    /// decodes _rlps and recovers their senders in parallel, then admits them to the pool of
+    /// _groupID in one operation; o_hashes and the results follow the order of _rlps, null
+    /// hashes and Malformed for the ones that can not be decoded. _prepare is called on every
+    /// decoded transaction before its import
+    std::vector<dev::eth::ImportResult> submitTransactions(int _groupID, Json::Value const& _rlps,
+        h256s& o_hashes,
+        std::function<void(size_t, dev::eth::Transaction&)> const& _prepare = nullptr);
+
+    ResponseCache::Ptr m_responseCache;
+
     bool isValidNodeId(dev::bytes const& precompileData,
         std::shared_ptr<dev::ledger::LedgerParamInterface> ledgerParam);
 };
@@ -0,0 +1,294 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @file RpcDispatcher.cpp
+ */
+
+#include "RpcDispatcher.h"
+#include "Common.h"
+#include <algorithm>
+
+using namespace dev;
+using namespace dev::rpc;
+
+/// JSON-RPC server error returned when maxPending calls are queued
+static const int c_busyCode = -32000;
+
+static std::string methodOf(Json::Value const& _call)
+{
+    if (_call.isObject() && _call["method"].isString())
+    {
+        return _call["method"].asString();
+    }
+    return std::string();
+}
+
+/// the ids a raw or async method can echo, the other calls go to the handler
+static bool writableCall(Json::Value const& _call)
+{
+    return _call["jsonrpc"] == "2.0" && (_call["id"].isString() || _call["id"].isIntegral());
+}
+
+/// writes {"id":<id>,"jsonrpc":"2.0","result": the result and "}" follow
+static void beginResult(JsonWriter& _writer, Json::Value const& _id)
+{
+    _writer.beginObject().key("id");
+    if (_id.isString())
+        _writer.string(_id.asString());
+    else
+        _writer.raw(_id.isUInt64() ? std::to_string(_id.asUInt64()) :
+                                     std::to_string(_id.asInt64()));
+    _writer.key("jsonrpc").string("2.0").key("result");
+}
+
+RpcDispatcher::RpcDispatcher(size_t _workers, size_t _maxPending)
+  : m_pool(std::make_shared<ThreadPool>("RpcWorker", std::max<size_t>(1, _workers))),
+    m_maxPending(_maxPending)
+{}
+
+void RpcDispatcher::setMethodLimit(std::string const& _method, size_t _limit)
+{
+    Guard l(x_methods);
+    auto it = m_methods.find(_method);
+    if (it == m_methods.end())
+    {
+        if (_limit)
+        {
+            m_methods[_method] = MethodQueue{_limit, 0, {}};
+        }
+        return;
+    }
+    // 0 only lifts the limit, the entry keeps counting the running calls
+    it->second.limit = _limit ? _limit : size_t(-1);
+}
+
+void RpcDispatcher::dispatch(std::string const& _request, Callback const& _callback)
+{
+    Json::Value request;
+    Json::Reader reader;
+    if (!reader.parse(_request, request, false) || !request.isArray() || request.empty())
+    {
+        // a single call, the handler reports the parse and protocol errors
+        auto task = [this, request, _request, _callback]() {
+            handle(request, _request, _callback);
+        };
+        if (!schedule(methodOf(request), task))
+        {
+            _callback(busy(request));
+        }
+        return;
+    }
+
+    // a batch is answered when its last call is done, the notifications have no response
+    struct Batch
+    {
+        Mutex x_responses;
+        std::vector<std::string> responses;
+        size_t left;
+        Callback callback;
+    };
+    auto batch = std::make_shared<Batch>();
+    batch->responses.resize(request.size());
+    batch->left = request.size();
+    batch->callback = _callback;
+    Json::FastWriter writer;
+    for (Json::ArrayIndex i = 0; i < request.size(); ++i)
+    {
+        auto done = [batch, i](std::string const& _response) {
+            {
+                Guard l(batch->x_responses);
+                batch->responses[i] = _response;
+                if (--batch->left)
+                {
+                    return;
+                }
+            }
+            std::string response;
+            for (auto& call : batch->responses)
+            {
+                auto end = call.find_last_not_of(" \r\n\t");
+                if (end == std::string::npos)
+                {
+                    continue;
+                }
+                response += response.empty() ? "[" : ",";
+                response.append(call, 0, end + 1);
+            }
+            batch->callback(response.empty() ? response : response + "]");
+        };
+        Json::Value const& call = request[i];
+        std::string callRequest = writer.write(call);
+        auto task = [this, call, callRequest, done]() { handle(call, callRequest, done); };
+        if (!schedule(methodOf(call), task))
+        {
+            done(busy(call));
+        }
+    }
+}
+
+bool RpcDispatcher::schedule(std::string const& _method, std::function<void()> const& _task)
+{
+    Guard l(x_methods);
+    if (m_stopped || m_pending >= m_maxPending)
+    {
+        return false;
+    }
+    ++m_pending;
+    auto it = m_methods.find(_method);
+    if (it != m_methods.end())
+    {
+        if (it->second.running >= it->second.limit)
+        {
+            it->second.waiting.push_back(_task);
+            return true;
+        }
+        ++it->second.running;
+    }
+    run(_method, _task);
+    return true;
+}
+
+void RpcDispatcher::run(std::string const& _method, std::function<void()> const& _task)
+{
+    m_pool->enqueue([this, _method, _task]() {
+        _task();
+        finish(_method);
+    });
+}
+
+void RpcDispatcher::finish(std::string const& _method)
+{
+    Guard l(x_methods);
+    --m_pending;
+    auto it = m_methods.find(_method);
+    if (it == m_methods.end())
+    {
+        return;
+    }
+    if (!it->second.waiting.empty() && it->second.running <= it->second.limit)
+    {
+        run(_method, it->second.waiting.front());
+        it->second.waiting.pop_front();
+        return;
+    }
+    --it->second.running;
+}
+
+void RpcDispatcher::handle(
+    Json::Value const& _call, std::string const& _request, Callback const& _callback)
+{
+    auto it = m_asyncMethods.find(methodOf(_call));
+    if (it == m_asyncMethods.end() || !writableCall(_call))
+    {
+        _callback(handle(_call, _request));
+        return;
+    }
+    try
+    {
+        // the worker is released, the result is written on a worker when it is ready
+        Json::Value id = _call["id"];
+        auto pool = m_pool;
+        auto done = [pool, id, _callback](ResultWriter const& _result) {
+            pool->enqueue([id, _callback, _result]() {
+                JsonWriter writer;
+                beginResult(writer, id);
+                _result(writer);
+                writer.endObject().raw("\n");
+                _callback(writer.str());
+            });
+        };
+        if (it->second(_call["params"], done))
+        {
+            return;
+        }
+    }
+    catch (std::exception& e)
+    {
+        RPC_LOG(TRACE) << "[#RpcDispatcher] async method failed [method]: " << it->first << ", "
+                       << boost::diagnostic_information(e);
+    }
+    _callback(handle(_request));
+}
+
+std::string RpcDispatcher::handle(Json::Value const& _call, std::string const& _request)
+{
+    auto it = m_rawMethods.find(methodOf(_call));
+    // the notifications and the ids the writer can not echo go to the handler
+    if (it == m_rawMethods.end() || !writableCall(_call))
+    {
+        return handle(_request);
+    }
+    try
+    {
+        // the buffer of a worker grows to the largest response once
+        static thread_local JsonWriter writer;
+        writer.clear();
+        beginResult(writer, _call["id"]);
+        if (it->second(_call["params"], writer))
+        {
+            writer.endObject().raw("\n");
+            return writer.str();
+        }
+    }
+    catch (std::exception& e)
+    {
+        RPC_LOG(TRACE) << "[#RpcDispatcher] raw method failed [method]: " << it->first << ", "
+                       << boost::diagnostic_information(e);
+    }
+    return handle(_request);
+}
+
+std::string RpcDispatcher::handle(std::string const& _request)
+{
+    std::string response;
+    if (!m_handler)
+    {
+        return response;
+    }
+    try
+    {
+        m_handler->HandleRequest(_request, response);
+    }
+    catch (std::exception& e)
+    {
+        RPC_LOG(ERROR) << "[#RpcDispatcher] handle request failed: "
+                       << boost::diagnostic_information(e);
+    }
+    return response;
+}
+
+std::string RpcDispatcher::busy(Json::Value const& _request)
+{
+    if (_request.isObject() && !_request.isMember("id"))
+    {
+        return std::string();
+    }
+    Json::Value response;
+    response["jsonrpc"] = "2.0";
+    response["id"] = _request.isObject() ? _request["id"] : Json::Value();
+    response["error"]["code"] = c_busyCode;
+    response["error"]["message"] = "Server busy";
+    return Json::FastWriter().write(response);
+}
+
+void RpcDispatcher::stop()
+{
+    {
+        Guard l(x_methods);
+        m_stopped = true;
+    }
+    m_pool->stop();
+}
@@ -0,0 +1,113 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @file RpcDispatcher.h
+ */
+#pragma once
+
+#include "JsonWriter.h"
+#include <jsonrpccpp/server/iclientconnectionhandler.h>
+#include <libdevcore/Guards.h>
+#include <libdevcore/ThreadPool.h>
+#include <json/json.h>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace dev
+{
+namespace rpc
+{
+/// Runs the JSON-RPC requests of the asynchronous connectors on a worker pool. The calls of a
+/// batch array are scheduled one by one, a call waits for a slot when its method has a
+/// concurrency limit, and the calls beyond maxPending are answered with "server busy".
+class RpcDispatcher
+{
+public:
+    typedef std::shared_ptr<RpcDispatcher> Ptr;
+    /// gets the response on a worker thread, empty when only notifications were sent
+    typedef std::function<void(std::string const& _response)> Callback;
+    /// writes the result of a call straight from the node objects, false hands the call over to
+    /// the handler, which also reports the errors
+    typedef std::function<bool(Json::Value const& _params, JsonWriter& _writer)> RawMethod;
+    /// the result of an async method, written on a worker thread
+    typedef std::function<void(JsonWriter& _writer)> ResultWriter;
+    typedef std::function<void(ResultWriter const& _result)> Done;
+    /// answers later without holding a worker: true if _done will be called, once and from any
+    /// thread, false hands the call over to the handler
+    typedef std::function<bool(Json::Value const& _params, Done const& _done)> AsyncMethod;
+
+    RpcDispatcher(size_t _workers, size_t _maxPending);
+    ~RpcDispatcher() { stop(); }
+
+    void setHandler(jsonrpc::IClientConnectionHandler* _handler) { m_handler = _handler; }
+    /// at most _limit calls of _method run at the same time, 0 removes the limit
+    void setMethodLimit(std::string const& _method, size_t _limit);
+    /// serve _method without building its Json::Value response, set before the requests come
+    void setRawMethod(std::string const& _method, RawMethod const& _rawMethod)
+    {
+        m_rawMethods[_method] = _rawMethod;
+    }
+    /// serve _method asynchronously, set before the requests come
+    void setAsyncMethod(std::string const& _method, AsyncMethod const& _asyncMethod)
+    {
+        m_asyncMethods[_method] = _asyncMethod;
+    }
+
+    /// handle a request or a batch array
+    void dispatch(std::string const& _request, Callback const& _callback);
+    void stop();
+
+    /// calls accepted and not finished yet
+    size_t pending() const
+    {
+        Guard l(x_methods);
+        return m_pending;
+    }
+
+private:
+    struct MethodQueue
+    {
+        size_t limit;
+        size_t running;
+        std::deque<std::function<void()>> waiting;
+    };
+
+    bool schedule(std::string const& _method, std::function<void()> const& _task);
+    /// x_methods must be held
+    void run(std::string const& _method, std::function<void()> const& _task);
+    void finish(std::string const& _method);
+    void handle(Json::Value const& _call, std::string const& _request, Callback const& _callback);
+    std::string handle(Json::Value const& _call, std::string const& _request);
+    std::string handle(std::string const& _request);
+    static std::string busy(Json::Value const& _request);
+
+    jsonrpc::IClientConnectionHandler* m_handler = nullptr;
+    std::map<std::string, RawMethod> m_rawMethods;
+    std::map<std::string, AsyncMethod> m_asyncMethods;
+    ThreadPool::Ptr m_pool;
+    size_t m_maxPending;
+
+    mutable Mutex x_methods;
+    std::map<std::string, MethodQueue> m_methods;
+    size_t m_pending = 0;
+    bool m_stopped = false;
+};
+
+}  // namespace rpc
+}  // namespace dev
@@ -103,6 +103,15 @@ public:
             jsonrpc::Procedure("getPendingTransactions", jsonrpc::PARAMS_BY_POSITION,
                 jsonrpc::JSON_OBJECT, "param1", jsonrpc::JSON_INTEGER, NULL),
             &dev::rpc::RpcFace::getPendingTransactionsI);
+        this->bindAndAddMethod(
+            jsonrpc::Procedure("getPendingTransactionsPage", jsonrpc::PARAMS_BY_POSITION,
+                jsonrpc::JSON_OBJECT, "param1", jsonrpc::JSON_INTEGER, "param2",
+                jsonrpc::JSON_OBJECT, NULL),
+            &dev::rpc::RpcFace::getPendingTransactionsPageI);
+        this->bindAndAddMethod(
+            jsonrpc::Procedure("getPendingTransactionsStats", jsonrpc::PARAMS_BY_POSITION,
+                jsonrpc::JSON_OBJECT, "param1", jsonrpc::JSON_INTEGER, NULL),
+            &dev::rpc::RpcFace::getPendingTransactionsStatsI);
         this->bindAndAddMethod(
             jsonrpc::Procedure("call", jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_OBJECT, "param1",
                 jsonrpc::JSON_INTEGER, "param2", jsonrpc::JSON_OBJECT, NULL),
@@ -112,6 +121,11 @@ public:
                                    jsonrpc::JSON_OBJECT, "param1", jsonrpc::JSON_INTEGER, "param2",
                                    jsonrpc::JSON_STRING, NULL),
             &dev::rpc::RpcFace::sendRawTransactionI);
+        this->bindAndAddMethod(
+            jsonrpc::Procedure("sendRawTransactions", jsonrpc::PARAMS_BY_POSITION,
+                jsonrpc::JSON_ARRAY, "param1", jsonrpc::JSON_INTEGER, "param2",
+                jsonrpc::JSON_ARRAY, NULL),
+            &dev::rpc::RpcFace::sendRawTransactionsI);
 
         this->bindAndAddMethod(
             jsonrpc::Procedure("getCode", jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_OBJECT,
@@ -209,6 +223,16 @@ public:
     {
         response = this->getPendingTransactions(request[0u].asInt());
     }
+    inline virtual void getPendingTransactionsPageI(
+        const Json::Value& request, Json::Value& response)
+    {
+        response = this->getPendingTransactionsPage(request[0u].asInt(), request[1u]);
+    }
+    inline virtual void getPendingTransactionsStatsI(
+        const Json::Value& request, Json::Value& response)
+    {
+        response = this->getPendingTransactionsStats(request[0u].asInt());
+    }
     inline virtual void getCodeI(const Json::Value& request, Json::Value& response)
     {
         response = this->getCode(request[0u].asInt(), request[1u].asString());
@@ -225,6 +249,10 @@ public:
     {
         response = this->sendRawTransaction(request[0u].asInt(), request[1u].asString());
     }
+    inline virtual void sendRawTransactionsI(const Json::Value& request, Json::Value& response)
+    {
+        response = this->sendRawTransactions(request[0u].asInt(), request[1u]);
+    }
 
     // system config part
     virtual std::string getSystemConfigByKey(int param1, const std::string& param2) = 0;
@@ -264,6 +292,10 @@ public:
     virtual Json::Value getTransactionReceipt(int param1, const std::string& param2) = 0;
     /// @return information about getPendingTransactions.
     virtual Json::Value getPendingTransactions(int param1) = 0;
+    /// @return up to "limit" pending transactions after "cursor", sent by "from" if it is set.
+    virtual Json::Value getPendingTransactionsPage(int param1, const Json::Value& param2) = 0;
+    /// @return count, input bytes, ages and top senders of the pending transactions.
+    virtual Json::Value getPendingTransactionsStats(int param1) = 0;
     /// Returns code at a given address.
     virtual std::string getCode(int param1, const std::string& param2) = 0;
     /// Returns the count of transactions and blocknumber.
@@ -272,6 +304,8 @@ public:
     virtual Json::Value call(int param1, const Json::Value& param2) = 0;
     /// Creates new message call transaction or a contract creation for signed transactions.
     virtual std::string sendRawTransaction(int param1, const std::string& param2) = 0;
+    /// @return the hash and the import status of every signed transaction of the batch.
+    virtual Json::Value sendRawTransactions(int param1, const Json::Value& param2) = 0;
 };
 
 }  // namespace rpc
@@ -0,0 +1,503 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @file WebSocketServer.cpp
+ */
+
+#include "WebSocketServer.h"
+#include "Common.h"
+#include "JsonHelper.h"
+#include <libdevcore/CommonJS.h>
+#include <libdevcore/FixedHash.h>
+#include <boost/beast.hpp>
+#include <boost/beast/websocket.hpp>
+#include <atomic>
+#include <deque>
+
+using namespace dev;
+using namespace dev::rpc;
+
+namespace websocket = boost::beast::websocket;
+using tcp = boost::asio::ip::tcp;
+
+namespace
+{
+/// sendRawTransaction batches are large, as for the http port
+const size_t c_maxMessageSize = 16 * 1024 * 1024;
+/// requests of a connection running at the same time, the next ones wait in the socket
+const size_t c_maxPipelined = 64;
+/// responses and notifications waiting for a slow client, the notifications beyond are dropped
+const size_t c_maxQueuedBytes = 32 * 1024 * 1024;
+
+std::string errorResponse(Json::Value const& _id, int _code, std::string const& _message)
+{
+    Json::Value response;
+    response["jsonrpc"] = "2.0";
+    response["id"] = _id;
+    response["error"]["code"] = _code;
+    response["error"]["message"] = _message;
+    return Json::FastWriter().write(response);
+}
+}  // namespace
+
+namespace dev
+{
+namespace rpc
+{
+class WebSocketSession : public std::enable_shared_from_this<WebSocketSession>
+{
+public:
+    WebSocketSession(tcp::socket&& _socket, std::weak_ptr<WebSocketServer> _server)
+      : m_ws(std::move(_socket)), m_strand(m_ws.next_layer().get_io_service()), m_server(_server)
+    {}
+
+    void start()
+    {
+        websocket::permessage_deflate deflate;
+        deflate.server_enable = true;
+        m_ws.set_option(deflate);
+        m_ws.read_message_max(c_maxMessageSize);
+        auto self = shared_from_this();
+        m_ws.async_accept(
+            m_strand.wrap([self](boost::system::error_code const& _error) {
+                if (_error)
+                {
+                    RPC_LOG(TRACE) << "[#WebSocketSession] handshake failed: " << _error.message();
+                    self->close();
+                    return;
+                }
+                self->read();
+            }));
+    }
+
+    /// queues a notification, false if the client is too far behind to take it
+    bool push(std::shared_ptr<const std::string> _message)
+    {
+        if (m_queuedBytes > c_maxQueuedBytes)
+        {
+            return false;
+        }
+        auto self = shared_from_this();
+        m_strand.post([self, _message]() { self->queue(_message); });
+        return true;
+    }
+
+private:
+    void read()
+    {
+        if (m_reading || m_closed || m_running >= c_maxPipelined)
+        {
+            return;
+        }
+        m_reading = true;
+        auto self = shared_from_this();
+        m_ws.async_read(
+            m_buffer, m_strand.wrap([self](boost::system::error_code const& _error, size_t) {
+                self->onRead(_error);
+            }));
+    }
+
+    void onRead(boost::system::error_code const& _error)
+    {
+        m_reading = false;
+        if (_error)
+        {
+            if (_error != websocket::error::closed)
+            {
+                RPC_LOG(TRACE) << "[#WebSocketSession] read failed: " << _error.message();
+            }
+            close();
+            return;
+        }
+
+        // the connections left on the io_service after the server is gone are closed
+        auto server = m_server.lock();
+        if (!server)
+        {
+            close();
+            return;
+        }
+        std::string request = boost::beast::buffers_to_string(m_buffer.data());
+        m_buffer.consume(m_buffer.size());
+        if (!handleSubscription(*server, request))
+        {
+            ++m_running;
+            auto self = shared_from_this();
+            server->dispatcher()->dispatch(request, [self](std::string const& _response) {
+                auto response = std::make_shared<const std::string>(_response);
+                self->m_strand.post([self, response]() {
+                    --self->m_running;
+                    if (!response->empty())
+                    {
+                        self->queue(response);
+                    }
+                    self->read();
+                });
+            });
+        }
+        read();
+    }
+
+    /// answers "subscribe" and "unsubscribe", false for the other requests
+    bool handleSubscription(WebSocketServer& _server, std::string const& _request)
+    {
+        if (_request.find("subscribe") == std::string::npos)
+        {
+            return false;
+        }
+        Json::Value request;
+        if (!Json::Reader().parse(_request, request, false) || !request.isObject())
+        {
+            return false;
+        }
+        std::string method = request["method"].asString();
+        if (method != "subscribe" && method != "unsubscribe")
+        {
+            return false;
+        }
+
+        std::string response;
+        Json::Value const& params = request["params"];
+        if (method == "subscribe")
+        {
+            std::string id;
+            if (params.isArray() && params.size() == 2 && params[0u].isInt() &&
+                params[1u].isString())
+            {
+                id = _server.subscribe(
+                    shared_from_this(), params[0u].asInt(), params[1u].asString());
+            }
+            if (id.empty())
+            {
+                response = errorResponse(request["id"], -32602,
+                    "INVALID_PARAMS: expected [groupID, \"newBlocks\"|\"newReceipts\"]");
+            }
+            else
+            {
+                Json::Value result;
+                result["jsonrpc"] = "2.0";
+                result["id"] = request["id"];
+                result["result"] = id;
+                response = Json::FastWriter().write(result);
+            }
+        }
+        else
+        {
+            Json::Value result;
+            result["jsonrpc"] = "2.0";
+            result["id"] = request["id"];
+            result["result"] = params.isArray() && params.size() == 1 &&
+                               _server.unsubscribe(this, params[0u].asString());
+            response = Json::FastWriter().write(result);
+        }
+        if (request.isMember("id"))
+        {
+            queue(std::make_shared<const std::string>(response));
+        }
+        return true;
+    }
+
+    void queue(std::shared_ptr<const std::string> _message)
+    {
+        m_queuedBytes += _message->size();
+        m_queue.push_back(_message);
+        write();
+    }
+
+    void write()
+    {
+        if (m_writing || m_closed || m_queue.empty())
+        {
+            return;
+        }
+        m_writing = true;
+        m_ws.text(true);
+        auto self = shared_from_this();
+        m_ws.async_write(boost::asio::buffer(*m_queue.front()),
+            m_strand.wrap([self](boost::system::error_code const& _error, size_t) {
+                self->onWrite(_error);
+            }));
+    }
+
+    void onWrite(boost::system::error_code const& _error)
+    {
+        m_writing = false;
+        m_queuedBytes -= m_queue.front()->size();
+        m_queue.pop_front();
+        if (_error)
+        {
+            RPC_LOG(TRACE) << "[#WebSocketSession] write failed: " << _error.message();
+            close();
+            return;
+        }
+        write();
+    }
+
+    void close()
+    {
+        if (m_closed)
+        {
+            return;
+        }
+        m_closed = true;
+        if (auto server = m_server.lock())
+        {
+            server->removeSession(this);
+        }
+        boost::system::error_code ignored;
+        m_ws.next_layer().shutdown(tcp::socket::shutdown_both, ignored);
+        m_ws.next_layer().close(ignored);
+    }
+
+    websocket::stream<tcp::socket> m_ws;
+    boost::asio::io_service::strand m_strand;
+    std::weak_ptr<WebSocketServer> m_server;
+
+    boost::beast::multi_buffer m_buffer;
+    std::deque<std::shared_ptr<const std::string>> m_queue;
+    std::atomic<size_t> m_queuedBytes{0};
+    size_t m_running = 0;
+    bool m_reading = false;
+    bool m_writing = false;
+    bool m_closed = false;
+};
+}  // namespace rpc
+}  // namespace dev
+
+namespace
+{
+void accept(std::shared_ptr<tcp::acceptor> _acceptor, std::weak_ptr<WebSocketServer> _server)
+{
+    auto socket = std::make_shared<tcp::socket>(_acceptor->get_io_service());
+    _acceptor->async_accept(
+        *socket, [_acceptor, _server, socket](boost::system::error_code const& _error) {
+            if (!_acceptor->is_open())
+            {
+                return;
+            }
+            if (_error)
+            {
+                RPC_LOG(ERROR) << "[#WebSocketServer] accept failed: " << _error.message();
+            }
+            else
+            {
+                std::make_shared<WebSocketSession>(std::move(*socket), _server)->start();
+            }
+            accept(_acceptor, _server);
+        });
+}
+}  // namespace
+
+WebSocketServer::WebSocketServer(std::string const& _address, int _port,
+    std::shared_ptr<boost::asio::io_service> _ioService, RpcDispatcher::Ptr _dispatcher)
+  : m_address(_address),
+    m_port(_port),
+    m_ioService(_ioService),
+    m_dispatcher(_dispatcher),
+    m_pushPool(std::make_shared<ThreadPool>("WebSocketPush", 1))
+{}
+
+bool WebSocketServer::StartListening()
+{
+    if (m_acceptor)
+    {
+        return true;
+    }
+    try
+    {
+        m_dispatcher->setHandler(GetHandler());
+        tcp::endpoint endpoint(boost::asio::ip::address::from_string(m_address), m_port);
+        auto acceptor = std::make_shared<tcp::acceptor>(*m_ioService);
+        acceptor->open(endpoint.protocol());
+        acceptor->set_option(boost::asio::socket_base::reuse_address(true));
+        acceptor->bind(endpoint);
+        acceptor->listen();
+        m_acceptor = acceptor;
+        accept(m_acceptor, shared_from_this());
+    }
+    catch (std::exception& e)
+    {
+        RPC_LOG(ERROR) << "[#WebSocketServer] listen failed [address/port]: " << m_address << "/"
+                       << m_port << ", " << boost::diagnostic_information(e);
+        return false;
+    }
+    RPC_LOG(INFO) << "[#WebSocketServer] listening [address/port]: " << m_address << "/"
+                  << m_port;
+    return true;
+}
+
+bool WebSocketServer::StopListening()
+{
+    if (m_acceptor)
+    {
+        boost::system::error_code ignored;
+        m_acceptor->close(ignored);
+        m_acceptor.reset();
+    }
+    m_blockHandlers.clear();
+    m_pushPool->stop();
+    m_dispatcher->stop();
+    return true;
+}
+
+void WebSocketServer::addGroup(
+    GROUP_ID _groupID, std::shared_ptr<dev::blockchain::BlockChainInterface> _blockChain)
+{
+    m_blockChains[_groupID] = _blockChain;
+    {
+        Guard l(x_blocks);
+        m_queuedNumbers[_groupID] = _blockChain->number();
+    }
+    // called by commitBlock, the block is read back and serialized on m_pushPool
+    m_blockHandlers.push_back(_blockChain->onReady(
+        [this, _groupID, _blockChain]() { noteBlocks(_groupID, _blockChain->number()); }));
+}
+
+void WebSocketServer::noteBlocks(GROUP_ID _groupID, int64_t _number)
+{
+    bool subscribed = hasSubscribers(_groupID);
+    // queued under the lock so that the blocks of concurrent signals keep their order
+    Guard l(x_blocks);
+    auto& queued = m_queuedNumbers[_groupID];
+    while (queued < _number)
+    {
+        int64_t number = ++queued;
+        if (subscribed)
+        {
+            m_pushPool->enqueue([this, _groupID, number]() { onBlock(_groupID, number); });
+        }
+    }
+}
+
+bool WebSocketServer::hasSubscribers(GROUP_ID _groupID) const
+{
+    Guard l(x_subscriptions);
+    for (auto const& it : m_subscriptions)
+    {
+        if (it.second.groupID == _groupID)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void WebSocketServer::onBlock(GROUP_ID _groupID, int64_t _number)
+{
+    try
+    {
+        auto block = m_blockChains[_groupID]->getBlockByNumber(_number);
+        if (!block)
+        {
+            return;
+        }
+        JsonWriter writer;
+        writeJson(writer, *block, false);
+        notify(_groupID, "newBlocks", writer.str());
+
+        writer.clear();
+        writer.beginArray();
+        auto const& header = block->blockHeader();
+        auto const& transactions = block->transactions();
+        auto const& receipts = block->transactionReceipts();
+        for (size_t i = 0; i < receipts.size() && i < transactions.size(); ++i)
+        {
+            writeJson(writer, dev::eth::LocalisedTransactionReceipt(receipts[i],
+                                  transactions[i].sha3(), header.hash(), header.number(),
+                                  transactions[i].from(), transactions[i].to(), i,
+                                  receipts[i].gasUsed(), receipts[i].contractAddress()));
+        }
+        writer.endArray();
+        notify(_groupID, "newReceipts", writer.str());
+    }
+    catch (std::exception& e)
+    {
+        RPC_LOG(ERROR) << "[#WebSocketServer] push block failed [groupID/number]: "
+                       << std::to_string(_groupID) << "/" << _number << ", "
+                       << boost::diagnostic_information(e);
+    }
+}
+
+void WebSocketServer::notify(
+    GROUP_ID _groupID, std::string const& _kind, std::string const& _result)
+{
+    std::vector<std::pair<std::string, std::shared_ptr<WebSocketSession>>> sessions;
+    {
+        Guard l(x_subscriptions);
+        for (auto const& it : m_subscriptions)
+        {
+            auto session = it.second.session.lock();
+            if (session && it.second.groupID == _groupID && it.second.kind == _kind)
+            {
+                sessions.push_back(std::make_pair(it.first, session));
+            }
+        }
+    }
+    for (auto const& it : sessions)
+    {
+        auto message = std::make_shared<const std::string>(
+            "{\"jsonrpc\":\"2.0\",\"method\":\"subscription\",\"params\":{\"result\":" + _result +
+            ",\"subscription\":\"" + it.first + "\"}}");
+        if (!it.second->push(message))
+        {
+            RPC_LOG(WARNING) << "[#WebSocketServer] client too slow, notification dropped "
+                                "[subscription/kind]: "
+                             << it.first << "/" << _kind;
+        }
+    }
+}
+
+std::string WebSocketServer::subscribe(
+    std::shared_ptr<WebSocketSession> _session, GROUP_ID _groupID, std::string const& _kind)
+{
+    if (_kind != "newBlocks" && _kind != "newReceipts")
+    {
+        return std::string();
+    }
+    std::string id = toJS(h128::random());
+    Guard l(x_subscriptions);
+    m_subscriptions[id] = Subscription{_groupID, _kind, _session};
+    return id;
+}
+
+bool WebSocketServer::unsubscribe(WebSocketSession* _session, std::string const& _id)
+{
+    Guard l(x_subscriptions);
+    auto it = m_subscriptions.find(_id);
+    if (it == m_subscriptions.end() || it->second.session.lock().get() != _session)
+    {
+        return false;
+    }
+    m_subscriptions.erase(it);
+    return true;
+}
+
+void WebSocketServer::removeSession(WebSocketSession* _session)
+{
+    Guard l(x_subscriptions);
+    for (auto it = m_subscriptions.begin(); it != m_subscriptions.end();)
+    {
+        auto session = it->second.session.lock();
+        if (!session || session.get() == _session)
+        {
+            it = m_subscriptions.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
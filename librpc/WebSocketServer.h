@@ -0,0 +1,105 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @file WebSocketServer.h
+ */
+#pragma once
+
+#include "RpcDispatcher.h"
+#include <jsonrpccpp/server/abstractserverconnector.h>
+#include <libblockchain/BlockChainInterface.h>
+#include <libdevcore/ThreadPool.h>
+#include <boost/asio.hpp>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace dev
+{
+namespace rpc
+{
+class WebSocketSession;
+
+/// JSON-RPC over WebSocket on boost::beast, with permessage-deflate. The connections live on the
+/// io_service given by the node and keep reading while their requests run on the RpcDispatcher
+/// (pipelining), the responses are written as they complete and matched by their id.
+/// "subscribe" [groupID, "newBlocks"|"newReceipts"] returns a subscription id, every block then
+/// committed by the group is pushed as {"jsonrpc":"2.0","method":"subscription","params":
+/// {"result":<block or receipts>,"subscription":<id>}} until "unsubscribe" [id].
+/// The server must be owned by a shared_ptr, the connections only hold a weak_ptr to it.
+class WebSocketServer : public jsonrpc::AbstractServerConnector,
+                        public std::enable_shared_from_this<WebSocketServer>
+{
+public:
+    WebSocketServer(std::string const& _address, int _port,
+        std::shared_ptr<boost::asio::io_service> _ioService, RpcDispatcher::Ptr _dispatcher);
+    virtual ~WebSocketServer() { StopListening(); }
+
+    virtual bool StartListening() override;
+    virtual bool StopListening() override;
+    /// the sessions write their responses, the connector callback is not used
+    virtual bool SendResponse(std::string const&, void* = nullptr) override { return false; }
+
+    RpcDispatcher::Ptr dispatcher() const { return m_dispatcher; }
+
+    /// the blocks committed by _blockChain are pushed to the subscribers of _groupID
+    void addGroup(
+        dev::GROUP_ID _groupID, std::shared_ptr<dev::blockchain::BlockChainInterface> _blockChain);
+    /// sends _result, JSON text, to the _kind subscribers of _groupID
+    void notify(dev::GROUP_ID _groupID, std::string const& _kind, std::string const& _result);
+
+    /// @returns the subscription id, empty if _kind is unknown
+    std::string subscribe(std::shared_ptr<WebSocketSession> _session, dev::GROUP_ID _groupID,
+        std::string const& _kind);
+    bool unsubscribe(WebSocketSession* _session, std::string const& _id);
+    /// drops the subscriptions of a closed session
+    void removeSession(WebSocketSession* _session);
+
+private:
+    struct Subscription
+    {
+        dev::GROUP_ID groupID;
+        std::string kind;
+        std::weak_ptr<WebSocketSession> session;
+    };
+
+    /// queues the blocks of _groupID after the last queued one up to _number, the signals of
+    /// the commits can be coalesced or observe the number of a later commit
+    void noteBlocks(dev::GROUP_ID _groupID, int64_t _number);
+    /// reads the block back and builds the notifications, on m_pushPool
+    void onBlock(dev::GROUP_ID _groupID, int64_t _number);
+    bool hasSubscribers(dev::GROUP_ID _groupID) const;
+
+    std::string m_address;
+    int m_port;
+    std::shared_ptr<boost::asio::io_service> m_ioService;
+    RpcDispatcher::Ptr m_dispatcher;
+    std::shared_ptr<boost::asio::ip::tcp::acceptor> m_acceptor;
+
+    mutable Mutex x_subscriptions;
+    std::map<std::string, Subscription> m_subscriptions;
+
+    std::map<dev::GROUP_ID, std::shared_ptr<dev::blockchain::BlockChainInterface>> m_blockChains;
+    std::vector<dev::eth::Handler<>> m_blockHandlers;
+    /// the last number queued to m_pushPool of every group
+    Mutex x_blocks;
+    std::map<dev::GROUP_ID, int64_t> m_queuedNumbers;
+    ThreadPool::Ptr m_pushPool;
+};
+
+}  // namespace rpc
+}  // namespace dev
@@ -75,7 +75,7 @@ bytes AuthorityPrecompiled::call(
     bytes out;
 
 
-    if (func == name2Selector[AUP_METHOD_INS])
+    if (func == name2Selector.at(AUP_METHOD_INS))
     {
         // insert(string tableName,string addr)
         std::string tableName, addr;
@@ -116,7 +116,7 @@ bytes AuthorityPrecompiled::call(
             out = abi.abiIn("", count);
         }
     }
-    else if (func == name2Selector[AUP_METHOD_REM])
+    else if (func == name2Selector.at(AUP_METHOD_REM))
     {
         // remove(string tableName,string addr)
         std::string tableName, addr;
@@ -153,7 +153,7 @@ bytes AuthorityPrecompiled::call(
             out = abi.abiIn("", count);
         }
     }
-    else if (func == name2Selector[AUP_METHOD_QUE])
+    else if (func == name2Selector.at(AUP_METHOD_QUE))
     {
         // queryByName(string table_name)
         std::string tableName;
@@ -69,7 +69,7 @@ bytes CNSPrecompiled::call(
     dev::eth::ContractABI abi;
     bytes out;
 
-    if (func == name2Selector[CNS_METHOD_INS_STR4])
+    if (func == name2Selector.at(CNS_METHOD_INS_STR4))
     {
         // insert(string,string,string,string)
         // insert(name, version, address, abi), 4 fields in table, the key of table is name field
@@ -111,7 +111,7 @@ bytes CNSPrecompiled::call(
             out = abi.abiIn("", count);
         }
     }
-    else if (func == name2Selector[CNS_METHOD_SLT_STR])
+    else if (func == name2Selector.at(CNS_METHOD_SLT_STR))
     {
         // selectByName(string) returns(string)
         // Cursor is not considered.
@@ -143,7 +143,7 @@ bytes CNSPrecompiled::call(
         std::string str = json_spirit::write_string(value, true);
         out = abi.abiIn("", str);
     }
-    else if (func == name2Selector[CNS_METHOD_SLT_STR2])
+    else if (func == name2Selector.at(CNS_METHOD_SLT_STR2))
     {
         // selectByNameAndVersion(string,string) returns(string)
         std::string contractName, contractVersion;
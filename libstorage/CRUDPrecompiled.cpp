@@ -65,7 +65,7 @@ bytes CRUDPrecompiled::call(
     dev::eth::ContractABI abi;
     bytes out;
 
-    if (func == name2Selector[CRUD_METHOD_SLT_STR_STR])
+    if (func == name2Selector.at(CRUD_METHOD_SLT_STR_STR))
     {  // select(string,string)
         std::string tableName, key;
         abi.abiOut(data, tableName, key);
@@ -27,6 +27,7 @@ namespace storage
 {
 #define STORAGE_LOG(LEVEL) LOG(LEVEL) << "[#STORAGE] "
 #define STORAGE_LEVELDB_LOG(LEVEL) LOG(LEVEL) << "[#STORAGE] [LEVELDB]"
+#define STORAGE_ROCKSDB_LOG(LEVEL) LOG(LEVEL) << "[#STORAGE] [ROCKSDB]"
 
 /// \brief Sign of the DB key is valid or not
 const std::string STATUS = "_status_";
@@ -37,11 +38,20 @@ const std::string SYS_KEY_CURRENT_NUMBER = "current_number";
 const std::string SYS_KEY_TOTAL_TRANSACTION_COUNT = "total_current_transaction_count";
 const std::string SYS_VALUE = "value";
 const std::string SYS_TX_HASH_2_BLOCK = "_sys_tx_hash_2_block_";
+/// fields of _sys_tx_hash_2_block_ besides the block number in "value", the ranges are the
+/// "offset:size" of the transaction and of its receipt in the encoded block
+const std::string SYS_TX_INDEX = "index";
+const std::string SYS_TX_BLOCK_HASH = "block_hash";
+const std::string SYS_TX_RANGE = "tx_range";
+const std::string SYS_TX_RECEIPT_RANGE = "receipt_range";
+const std::string SYS_TX_FROM = "from";
 const std::string SYS_NUMBER_2_HASH = "_sys_number_2_hash_";
 const std::string SYS_HASH_2_BLOCK = "_sys_hash_2_block_";
 const std::string SYS_CNS = "_sys_cns_";
 const std::string SYS_CONFIG = "_sys_config_";
 const std::string SYS_ACCESS_TABLE = "_sys_table_access_";
+/// contract code shared by all accounts, keyed by code hash
+const std::string SYS_CODE = "_sys_code_";
 const std::string USER_TABLE_PREFIX = "_user_";
 }  // namespace storage
 }  // namespace dev
\ No newline at end of file
@@ -68,7 +68,7 @@ bytes ConsensusPrecompiled::call(
     showConsensusTable(context);
 
 
-    if (func == name2Selector[CSS_METHOD_ADD_MINER])
+    if (func == name2Selector.at(CSS_METHOD_ADD_MINER))
     {
         // addMiner(string)
         std::string nodeID;
@@ -131,7 +131,7 @@ bytes ConsensusPrecompiled::call(
             out = abi.abiIn("", count);
         }
     }
-    else if (func == name2Selector[CSS_METHOD_ADD_SER])
+    else if (func == name2Selector.at(CSS_METHOD_ADD_SER))
     {
         // addObserver(string)
         std::string nodeID;
@@ -194,7 +194,7 @@ bytes ConsensusPrecompiled::call(
             out = abi.abiIn("", count);
         }
     }
-    else if (func == name2Selector[CSS_METHOD_REMOVE])
+    else if (func == name2Selector.at(CSS_METHOD_REMOVE))
     {
         // remove(string)
         std::string nodeID;
@@ -36,8 +36,12 @@ Entries::Ptr LevelDBStorage::select(
     {
         std::string entryKey = table + "_" + key;
         std::string value;
-        ReadGuard l(m_remoteDBMutex);
-        auto s = m_db->Get(leveldb::ReadOptions(), leveldb::Slice(entryKey), &value);
+        // unlike the former m_remoteDBMutex, the block being written does not stall the reads,
+        // they see the last committed block
+        auto readSnapshot = snapshot();
+        leveldb::ReadOptions readOptions;
+        readOptions.snapshot = readSnapshot.get();
+        auto s = m_db->Get(readOptions, leveldb::Slice(entryKey), &value);
         if (!s.ok() && !s.IsNotFound())
         {
             STORAGE_LEVELDB_LOG(ERROR) << "Query leveldb failed:" + s.ToString();
@@ -131,8 +135,10 @@ size_t LevelDBStorage::commit(
         }
 
         leveldb::WriteOptions writeOptions;
-        writeOptions.sync = false;
-        WriteGuard l(m_remoteDBMutex);
+        writeOptions.sync = m_syncWrite;
+        // blocks of a group are committed one at a time by BlockChainImp::commitBlock, so this
+        // is a single sequential writer per db and each block costs one log write (and one
+        // fsync with syncWrite)
         auto s = m_db->Write(writeOptions, &(batch->writeBatch()));
         if (!s.ok())
         {
@@ -140,7 +146,12 @@ size_t LevelDBStorage::commit(
 
             BOOST_THROW_EXCEPTION(StorageException(-1, "Commit leveldb exception:" + s.ToString()));
         }
+        takeSnapshot();
 
+        if (m_statsInterval > 0 && num % m_statsInterval == 0)
+        {
+            logStats(num);
+        }
         return total;
     }
     catch (std::exception& e)
@@ -159,7 +170,44 @@ bool LevelDBStorage::onlyDirty()
     return false;
 }
 
+void LevelDBStorage::logStats(int64_t _num)
+{
+    std::string stats;
+    m_db->GetProperty(leveldb::Slice("leveldb.stats"), &stats);
+    // all table keys start with '_', so this range covers the whole db
+    leveldb::Range range(leveldb::Slice(""), leveldb::Slice("\xff"));
+    uint64_t size = 0;
+    m_db->GetApproximateSizes(&range, 1, &size);
+    STORAGE_LEVELDB_LOG(INFO) << "leveldb stats at block " << _num
+                              << " approximate size:" << size << "\n"
+                              << stats;
+}
+
 void LevelDBStorage::setDB(std::shared_ptr<dev::db::BasicLevelDB> db)
 {
     m_db = db;
+    Guard l(x_snapshot);
+    m_snapshot.reset();
+}
+
+std::shared_ptr<const leveldb::Snapshot> LevelDBStorage::snapshot()
+{
+    // taken under the lock, a commit running meanwhile replaces it afterwards
+    Guard l(x_snapshot);
+    if (!m_snapshot)
+    {
+        auto db = m_db;
+        m_snapshot.reset(db->GetSnapshot(),
+            [db](const leveldb::Snapshot* _snapshot) { db->ReleaseSnapshot(_snapshot); });
+    }
+    return m_snapshot;
+}
+
+void LevelDBStorage::takeSnapshot()
+{
+    {
+        Guard l(x_snapshot);
+        m_snapshot.reset();
+    }
+    snapshot();
 }
@@ -33,6 +33,12 @@ namespace dev
 {
 namespace storage
 {
+/// select and commit take no lock around the db: the selects read the leveldb snapshot taken
+/// after the last committed block, so while block N+1 is written they keep seeing block N, and
+/// commit replaces the snapshot once the WriteBatch of the block is applied. The snapshot is
+/// released when the last select reading it is done.
+/// Each group owns its db and commits its blocks one by one, batches of consecutive blocks or
+/// of different groups are not merged.
 class LevelDBStorage : public Storage
 {
 public:
@@ -47,10 +53,22 @@ public:
     virtual bool onlyDirty() override;
 
     void setDB(std::shared_ptr<dev::db::BasicLevelDB> db);
+    /// fsync the write-ahead log on every block commit
+    void setSyncWrite(bool _syncWrite) { m_syncWrite = _syncWrite; }
+    /// log leveldb.stats and the approximate db size every _blocks committed blocks, 0 disables
+    void setStatsInterval(int64_t _blocks) { m_statsInterval = _blocks; }
 
 private:
+    void logStats(int64_t _num);
+    /// the snapshot of the last committed block, taken on the first select after setDB
+    std::shared_ptr<const leveldb::Snapshot> snapshot();
+    void takeSnapshot();
+
     std::shared_ptr<dev::db::BasicLevelDB> m_db;
-    dev::SharedMutex m_remoteDBMutex;
+    Mutex x_snapshot;
+    std::shared_ptr<const leveldb::Snapshot> m_snapshot;
+    bool m_syncWrite = false;
+    int64_t m_statsInterval = 0;
 };
 
 }  // namespace storage
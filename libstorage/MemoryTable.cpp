@@ -175,7 +175,7 @@ int dev::storage::MemoryTable::insert(
             entries = it->second;
         }
         checkFiled(entry);
-        Change::Record record(entries->size() + 1u);
+        Change::Record record(entries->size());
         std::vector<Change::Record> value{record};
         m_recorder(shared_from_this(), Change::Insert, key, value);
         if (entries->size() == 0)
@@ -245,6 +245,69 @@ int dev::storage::MemoryTable::remove(
     return indexes.size();
 }
 
+int dev::storage::MemoryTable::upsert(
+    const std::string& key, Entry::Ptr entry, AccessOptions::Ptr options)
+{
+    try
+    {
+        if (!checkAuthority(options->origin))
+        {
+            STORAGE_LOG(WARNING) << m_tableInfo->name << " checkAuthority of "
+                                 << options->origin.hex() << " failed! key:" << key;
+            return -1;
+        }
+
+        Entries::Ptr entries = std::make_shared<Entries>();
+
+        auto it = m_cache.find(key);
+        if (it == m_cache.end())
+        {
+            if (m_remoteDB)
+            {
+                entries = m_remoteDB->select(m_blockHash, m_blockNum, m_tableInfo->name, key);
+                m_cache.insert(std::make_pair(key, entries));
+            }
+        }
+        else
+        {
+            entries = it->second;
+        }
+        checkFiled(entry);
+
+        // one lookup instead of select followed by insert or update
+        for (size_t i = 0; i < entries->size(); ++i)
+        {
+            Entry::Ptr updateEntry = entries->get(i);
+            if (updateEntry->getStatus() != Entry::Status::NORMAL)
+            {
+                continue;
+            }
+            std::vector<Change::Record> records;
+            for (auto fieldIt : *(entry->fields()))
+            {
+                records.emplace_back(i, fieldIt.first, updateEntry->getField(fieldIt.first));
+                updateEntry->setField(fieldIt.first, fieldIt.second);
+            }
+            m_recorder(shared_from_this(), Change::Update, key, records);
+            entries->setDirty(true);
+            return 1;
+        }
+
+        Change::Record record(entries->size());
+        std::vector<Change::Record> value{record};
+        m_recorder(shared_from_this(), Change::Insert, key, value);
+        entries->addEntry(entry);
+        m_cache.insert(std::make_pair(key, entries));
+        return 1;
+    }
+    catch (std::exception& e)
+    {
+        STORAGE_LOG(ERROR) << "Access MemoryTable failed for:" << boost::diagnostic_information(e);
+    }
+
+    return 0;
+}
+
 h256 dev::storage::MemoryTable::hash()
 {
     bytes data;
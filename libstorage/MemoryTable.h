@@ -42,6 +42,8 @@ public:
         AccessOptions::Ptr options = std::make_shared<AccessOptions>()) override;
     virtual int remove(const std::string& key, Condition::Ptr condition,
         AccessOptions::Ptr options = std::make_shared<AccessOptions>()) override;
+    virtual int upsert(const std::string& key, Entry::Ptr entry,
+        AccessOptions::Ptr options = std::make_shared<AccessOptions>()) override;
 
     virtual h256 hash();
     virtual void clear();
@@ -44,6 +44,7 @@ MemoryTableFactory::MemoryTableFactory() : m_blockHash(h256(0)), m_blockNum(0)
     m_sysTables.push_back(SYS_HASH_2_BLOCK);
     m_sysTables.push_back(SYS_CNS);
     m_sysTables.push_back(SYS_CONFIG);
+    m_sysTables.push_back(SYS_CODE);
 }
 
 Table::Ptr MemoryTableFactory::openTable(const string& tableName, bool authorityFlag)
@@ -313,7 +314,8 @@ storage::TableInfo::Ptr MemoryTableFactory::getSysTableInfo(const std::string& t
     else if (tableName == SYS_TX_HASH_2_BLOCK)
     {
         tableInfo->key = "hash";
-        tableInfo->fields = std::vector<std::string>{"value", "index"};
+        tableInfo->fields = std::vector<std::string>{SYS_VALUE, SYS_TX_INDEX, SYS_TX_BLOCK_HASH,
+            SYS_TX_RANGE, SYS_TX_RECEIPT_RANGE, SYS_TX_FROM};
     }
     else if (tableName == SYS_HASH_2_BLOCK)
     {
@@ -332,6 +334,11 @@ storage::TableInfo::Ptr MemoryTableFactory::getSysTableInfo(const std::string& t
         tableInfo->fields = std::vector<std::string>{
             dev::blockverifier::SYSTEM_CONFIG_VALUE, dev::blockverifier::SYSTEM_CONFIG_ENABLENUM};
     }
+    else if (tableName == SYS_CODE)
+    {
+        tableInfo->key = "hash";
+        tableInfo->fields = std::vector<std::string>{"value"};
+    }
     return tableInfo;
 }
 
@@ -0,0 +1,267 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/** @file RocksDBStorage.cpp
+ */
+
+#include "RocksDBStorage.h"
+#include "Common.h"
+#include "Table.h"
+#include <json/json.h>
+#include <libdevcore/easylog.h>
+#include <rocksdb/cache.h>
+#include <rocksdb/filter_policy.h>
+#include <rocksdb/slice_transform.h>
+#include <rocksdb/table.h>
+#include <rocksdb/write_batch.h>
+#include <algorithm>
+#include <memory>
+
+using namespace dev;
+using namespace dev::storage;
+
+/// length of "_contract_data_" + 40 hex address + "_", the prefix of contract table keys
+static const size_t c_contractTablePrefixLength = 56;
+
+static std::vector<std::string> systemTables()
+{
+    return {SYS_HASH_2_BLOCK, SYS_TX_HASH_2_BLOCK, SYS_NUMBER_2_HASH, SYS_CURRENT_STATE,
+        SYS_CONFIG, SYS_MINERS, SYS_TABLES, SYS_ACCESS_TABLE, SYS_CNS, SYS_CODE};
+}
+
+RocksDBStorage::~RocksDBStorage()
+{
+    if (m_db)
+    {
+        for (auto handle : m_handles)
+        {
+            m_db->DestroyColumnFamilyHandle(handle);
+        }
+    }
+}
+
+void RocksDBStorage::open(std::string const& _path, RocksDBOptions const& _options)
+{
+    rocksdb::BlockBasedTableOptions tableOptions;
+    tableOptions.block_cache = rocksdb::NewLRUCache(_options.blockCacheMB << 20);
+    tableOptions.filter_policy.reset(
+        rocksdb::NewBloomFilterPolicy(_options.bloomBitsPerKey, false));
+
+    rocksdb::ColumnFamilyOptions systemOptions;
+    systemOptions.table_factory.reset(rocksdb::NewBlockBasedTableFactory(tableOptions));
+    systemOptions.compression = rocksdb::kSnappyCompression;
+
+    // contract tables share the default column family, keyed by table name first
+    rocksdb::ColumnFamilyOptions defaultOptions = systemOptions;
+    defaultOptions.prefix_extractor.reset(
+        rocksdb::NewCappedPrefixTransform(c_contractTablePrefixLength));
+    defaultOptions.memtable_prefix_bloom_size_ratio = 0.1;
+
+    rocksdb::DBOptions dbOptions;
+    dbOptions.create_if_missing = true;
+    dbOptions.create_missing_column_families = true;
+    dbOptions.max_open_files = _options.maxOpenFiles;
+    // multi-threaded flush/compaction
+    dbOptions.IncreaseParallelism(_options.maxBackgroundJobs);
+    dbOptions.max_background_jobs = _options.maxBackgroundJobs;
+    dbOptions.max_subcompactions = std::max(1, _options.maxBackgroundJobs / 2);
+
+    std::vector<rocksdb::ColumnFamilyDescriptor> descriptors;
+    descriptors.emplace_back(rocksdb::kDefaultColumnFamilyName, defaultOptions);
+    auto tables = systemTables();
+    for (auto const& table : tables)
+    {
+        descriptors.emplace_back(table, systemOptions);
+    }
+
+    rocksdb::DB* db = nullptr;
+    auto s = rocksdb::DB::Open(dbOptions, _path, descriptors, &m_handles, &db);
+    if (!s.ok())
+    {
+        STORAGE_ROCKSDB_LOG(ERROR) << "Open rocksdb failed: " << s.ToString();
+        BOOST_THROW_EXCEPTION(StorageException(-1, "Open rocksdb exception:" + s.ToString()));
+    }
+    m_db.reset(db);
+
+    // m_handles[0] is the default column family, the rest follow the order of systemTables()
+    for (size_t i = 0; i < tables.size(); ++i)
+    {
+        m_columnFamilies[tables[i]] = m_handles[i + 1];
+    }
+    STORAGE_ROCKSDB_LOG(INFO) << "Open rocksdb [path/blockCacheMB/backgroundJobs]: " << _path
+                              << "/" << _options.blockCacheMB << "/"
+                              << _options.maxBackgroundJobs;
+}
+
+rocksdb::ColumnFamilyHandle* RocksDBStorage::columnFamily(std::string const& _table) const
+{
+    auto it = m_columnFamilies.find(_table);
+    if (it != m_columnFamilies.end())
+    {
+        return it->second;
+    }
+    return m_db->DefaultColumnFamily();
+}
+
+std::string RocksDBStorage::entryKey(std::string const& _table, std::string const& _key) const
+{
+    // system tables own their column family, no need to prefix the key with the table name
+    if (m_columnFamilies.count(_table))
+    {
+        return _key;
+    }
+    return _table + "_" + _key;
+}
+
+Entries::Ptr RocksDBStorage::select(
+    h256 hash, int num, const std::string& table, const std::string& key)
+{
+    try
+    {
+        std::string value;
+        auto s = m_db->Get(rocksdb::ReadOptions(), columnFamily(table),
+            rocksdb::Slice(entryKey(table, key)), &value);
+        if (!s.ok() && !s.IsNotFound())
+        {
+            STORAGE_ROCKSDB_LOG(ERROR) << "Query rocksdb failed:" + s.ToString();
+
+            BOOST_THROW_EXCEPTION(StorageException(-1, "Query rocksdb exception:" + s.ToString()));
+        }
+
+        Entries::Ptr entries = std::make_shared<Entries>();
+        if (!s.IsNotFound())
+        {
+            // parse json
+            std::stringstream ssIn;
+            ssIn << value;
+
+            Json::Value valueJson;
+            ssIn >> valueJson;
+
+            Json::Value values = valueJson["values"];
+            for (auto it = values.begin(); it != values.end(); ++it)
+            {
+                Entry::Ptr entry = std::make_shared<Entry>();
+
+                for (auto valueIt = it->begin(); valueIt != it->end(); ++valueIt)
+                {
+                    entry->setField(valueIt.key().asString(), valueIt->asString());
+                }
+
+                if (entry->getStatus() == Entry::Status::NORMAL)
+                {
+                    entry->setDirty(false);
+                    entries->addEntry(entry);
+                }
+            }
+        }
+
+        return entries;
+    }
+    catch (std::exception& e)
+    {
+        STORAGE_ROCKSDB_LOG(ERROR)
+            << "Query rocksdb exception:" << boost::diagnostic_information(e);
+
+        BOOST_THROW_EXCEPTION(e);
+    }
+
+    return Entries::Ptr();
+}
+
+size_t RocksDBStorage::commit(
+    h256 hash, int64_t num, const std::vector<TableData::Ptr>& datas, h256 blockHash)
+{
+    try
+    {
+        STORAGE_ROCKSDB_LOG(INFO) << "rocksdb commit data. blockHash:" << blockHash
+                                  << " num:" << num;
+
+        rocksdb::WriteBatch batch;
+        size_t total = 0;
+        for (auto it : datas)
+        {
+            auto handle = columnFamily(it->tableName);
+            for (auto dataIt : it->data)
+            {
+                if (dataIt.second->size() == 0u)
+                {
+                    continue;
+                }
+                Json::Value entry;
+
+                for (size_t i = 0; i < dataIt.second->size(); ++i)
+                {
+                    Json::Value value;
+                    for (auto fieldIt : *(dataIt.second->get(i)->fields()))
+                    {
+                        value[fieldIt.first] = fieldIt.second;
+                    }
+                    value["_hash_"] = hash.hex();
+                    value["_num_"] = num;
+                    entry["values"].append(value);
+                }
+
+                std::stringstream ssOut;
+                ssOut << entry;
+
+                batch.Put(handle, rocksdb::Slice(entryKey(it->tableName, dataIt.first)),
+                    rocksdb::Slice(ssOut.str()));
+                ++total;
+            }
+        }
+
+        rocksdb::WriteOptions writeOptions;
+        writeOptions.sync = m_syncWrite;
+        auto s = m_db->Write(writeOptions, &batch);
+        if (!s.ok())
+        {
+            STORAGE_ROCKSDB_LOG(ERROR) << "Commit rocksdb failed: " << s.ToString();
+
+            BOOST_THROW_EXCEPTION(StorageException(-1, "Commit rocksdb exception:" + s.ToString()));
+        }
+
+        return total;
+    }
+    catch (std::exception& e)
+    {
+        STORAGE_ROCKSDB_LOG(ERROR)
+            << "Commit rocksdb exception" << boost::diagnostic_information(e);
+
+        BOOST_THROW_EXCEPTION(e);
+    }
+
+    return 0;
+}
+
+bool RocksDBStorage::onlyDirty()
+{
+    return false;
+}
+
+std::string RocksDBStorage::property(std::string const& _name)
+{
+    std::string ret;
+    for (auto handle : m_handles)
+    {
+        std::string value;
+        if (m_db->GetProperty(handle, _name, &value))
+        {
+            ret += "[" + handle->GetName() + "]\n" + value;
+        }
+    }
+    return ret;
+}
@@ -0,0 +1,78 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/** @file RocksDBStorage.h
+ */
+#pragma once
+
+#include "Storage.h"
+#include "StorageException.h"
+#include "Table.h"
+#include <libdevcore/FixedHash.h>
+#include <rocksdb/db.h>
+#include <map>
+
+namespace dev
+{
+namespace storage
+{
+struct RocksDBOptions
+{
+    /// LRU block cache shared by all column families, in MB
+    size_t blockCacheMB = 128;
+    /// bits per key of the bloom filters
+    int bloomBitsPerKey = 10;
+    /// background flush/compaction jobs
+    int maxBackgroundJobs = 4;
+    int maxOpenFiles = 1000;
+};
+
+/// Storage on rocksdb, one column family per system table and a prefix-bloomed default
+/// column family for contract/user tables. Values use the same json format as LevelDBStorage.
+class RocksDBStorage : public Storage
+{
+public:
+    typedef std::shared_ptr<RocksDBStorage> Ptr;
+
+    virtual ~RocksDBStorage();
+
+    virtual Entries::Ptr select(
+        h256 hash, int num, const std::string& table, const std::string& key) override;
+    virtual size_t commit(
+        h256 hash, int64_t num, const std::vector<TableData::Ptr>& datas, h256 blockHash) override;
+    virtual bool onlyDirty() override;
+
+    /// open (or create) the db at _path, throws StorageException on failure
+    void open(std::string const& _path, RocksDBOptions const& _options);
+    void setSyncWrite(bool _syncWrite) { m_syncWrite = _syncWrite; }
+
+    /// value of a rocksdb property (e.g. "rocksdb.stats") summed over all column families
+    std::string property(std::string const& _name);
+
+private:
+    rocksdb::ColumnFamilyHandle* columnFamily(std::string const& _table) const;
+    std::string entryKey(std::string const& _table, std::string const& _key) const;
+
+    std::unique_ptr<rocksdb::DB> m_db;
+    /// system table name => column family, the default column family holds all other tables
+    std::map<std::string, rocksdb::ColumnFamilyHandle*> m_columnFamilies;
+    std::vector<rocksdb::ColumnFamilyHandle*> m_handles;
+    bool m_syncWrite = false;
+};
+
+}  // namespace storage
+
+}  // namespace dev
@@ -53,7 +53,7 @@ bytes SystemConfigPrecompiled::call(
     bytes out;
     u256 count = 0;
 
-    if (func == name2Selector[SYSCONFIG_METHOD_SET_STR])
+    if (func == name2Selector.at(SYSCONFIG_METHOD_SET_STR))
     {
         // setValueByKey(string,string)
         std::string configKey, configValue;
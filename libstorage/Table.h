@@ -181,6 +181,9 @@ public:
         AccessOptions::Ptr options = std::make_shared<AccessOptions>()) = 0;
     virtual int remove(const std::string& key, Condition::Ptr condition,
         AccessOptions::Ptr options = std::make_shared<AccessOptions>()) = 0;
+    /// update the fields of the first live entry of key, or insert entry if there is none
+    virtual int upsert(const std::string& key, Entry::Ptr entry,
+        AccessOptions::Ptr options = std::make_shared<AccessOptions>()) = 0;
 
     virtual Entry::Ptr newEntry();
     virtual Condition::Ptr newCondition();
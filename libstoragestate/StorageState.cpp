@@ -23,9 +23,12 @@
  */
 
 #include "StorageState.h"
+#include "libdevcore/LRUCache.h"
 #include "libdevcrypto/Hash.h"
 #include "libethcore/Exceptions.h"
+#include "libstorage/Common.h"
 #include "libstorage/MemoryTableFactory.h"
+#include "libstorage/StorageException.h"
 
 using namespace dev;
 using namespace dev::eth;
@@ -33,6 +36,51 @@ using namespace dev::storagestate;
 using namespace dev::storage;
 using namespace dev::executive;
 
+/// memory limit of the decoded code shared by all StorageState
+static const size_t c_codeCacheSize = 64 * 1024 * 1024;
+
+/// code is immutable for a given hash, so the decoded code is shared across blocks and groups
+static LRUCache<h256, std::shared_ptr<bytes const>>& codeCache()
+{
+    static LRUCache<h256, std::shared_ptr<bytes const>> s_codeCache(
+        c_codeCacheSize, [](std::shared_ptr<bytes const> const& _code) { return _code->size(); });
+    return s_codeCache;
+}
+
+/// balance, nonce and code hash of 32 bytes each and the flags
+static const size_t c_accountHeaderSize = 97;
+static const byte c_aliveFlag = 1;
+
+std::string AccountHeader::encode() const
+{
+    bytes data = toBigEndian(balance) + toBigEndian(nonce) + codeHash.asBytes();
+    data.push_back(alive ? c_aliveFlag : 0);
+    return toHex(data);
+}
+
+/// the 0x prefixed big-endian hex of the slot, which is far cheaper to build than the decimal
+/// string
+static inline std::string slotKey(u256 const& _slot)
+{
+    return toHexPrefixed(toBigEndian(_slot));
+}
+
+AccountHeader AccountHeader::decode(std::string const& _data)
+{
+    bytes data = fromHex(_data);
+    if (data.size() != c_accountHeaderSize)
+    {
+        BOOST_THROW_EXCEPTION(StorageException(-1, "Invalid account header: " + _data));
+    }
+    bytesConstRef ref(&data);
+    AccountHeader header;
+    header.balance = fromBigEndian<u256>(ref.cropped(0, 32));
+    header.nonce = fromBigEndian<u256>(ref.cropped(32, 32));
+    header.codeHash = h256(ref.cropped(64, 32));
+    header.alive = data[96] & c_aliveFlag;
+    return header;
+}
+
 bool StorageState::addressInUse(Address const& _address) const
 {
     auto table = getTable(_address);
@@ -45,11 +93,11 @@ bool StorageState::addressInUse(Address const& _address) const
 
 bool StorageState::accountNonemptyAndExisting(Address const& _address) const
 {
-    auto table = getTable(_address);
-    if (table)
+    auto header = account(_address);
+    if (header)
     {
-        if (balance(_address) > u256(0) || codeHash(_address) != EmptySHA3 ||
-            getNonce(_address) != m_accountStartNonce)
+        if (header->balance > u256(0) || header->codeHash != EmptySHA3 ||
+            header->nonce != m_accountStartNonce)
             return true;
     }
     return false;
@@ -57,48 +105,28 @@ bool StorageState::accountNonemptyAndExisting(Address const& _address) const
 
 bool StorageState::addressHasCode(Address const& _address) const
 {
-    auto table = getTable(_address);
-    if (table)
-    {
-        auto entries = table->select(ACCOUNT_CODE_HASH, table->newCondition());
-        if (entries->size() != 0u)
-        {
-            auto codeHash = h256(fromHex(entries->get(0)->getField(STORAGE_VALUE)));
-            return codeHash != EmptySHA3;
-        }
-    }
-    return false;
+    auto header = account(_address);
+    return header && header->codeHash != EmptySHA3;
 }
 
 u256 StorageState::balance(Address const& _address) const
 {
-    auto table = getTable(_address);
-    if (table)
+    auto header = account(_address);
+    if (header)
     {
-        auto entries = table->select(ACCOUNT_BALANCE, table->newCondition());
-        if (entries->size() != 0u)
-        {
-            return u256(entries->get(0)->getField(STORAGE_VALUE));
-        }
+        return header->balance;
     }
     return 0;
 }
 
 void StorageState::addBalance(Address const& _address, u256 const& _amount)
 {
-    auto table = getTable(_address);
-    if (table)
+    auto header = account(_address);
+    if (header)
     {
-        auto entries = table->select(ACCOUNT_BALANCE, table->newCondition());
-        if (entries->size() != 0u)
-        {
-            auto entry = entries->get(0);
-            auto balance = u256(entry->getField(STORAGE_VALUE));
-            balance += _amount;
-            entry = table->newEntry();
-            entry->setField(STORAGE_VALUE, balance.str());
-            table->update(ACCOUNT_BALANCE, entry, table->newCondition());
-        }
+        auto newHeader = *header;
+        newHeader.balance += _amount;
+        updateAccount(_address, newHeader, ACCOUNT_BALANCE);
     }
     else
     {
@@ -108,21 +136,14 @@ void StorageState::addBalance(Address const& _address, u256 const& _amount)
 
 void StorageState::subBalance(Address const& _address, u256 const& _amount)
 {
-    auto table = getTable(_address);
-    if (table)
+    auto header = account(_address);
+    if (header)
     {
-        auto entries = table->select(ACCOUNT_BALANCE, table->newCondition());
-        if (entries->size() != 0u)
-        {
-            auto entry = entries->get(0);
-            auto balance = u256(entry->getField(STORAGE_VALUE));
-            if (balance < _amount)
-                BOOST_THROW_EXCEPTION(NotEnoughCash());
-            balance -= _amount;
-            entry = table->newEntry();
-            entry->setField(STORAGE_VALUE, balance.str());
-            table->update(ACCOUNT_BALANCE, entry, table->newCondition());
-        }
+        if (header->balance < _amount)
+            BOOST_THROW_EXCEPTION(NotEnoughCash());
+        auto newHeader = *header;
+        newHeader.balance -= _amount;
+        updateAccount(_address, newHeader, ACCOUNT_BALANCE);
     }
     else
     {
@@ -132,19 +153,12 @@ void StorageState::subBalance(Address const& _address, u256 const& _amount)
 
 void StorageState::setBalance(Address const& _address, u256 const& _amount)
 {
-    auto table = getTable(_address);
-    if (table)
+    auto header = account(_address);
+    if (header)
     {
-        auto entries = table->select(ACCOUNT_BALANCE, table->newCondition());
-        if (entries->size() != 0u)
-        {
-            auto entry = entries->get(0);
-            auto balance = u256(entry->getField(STORAGE_VALUE));
-            balance = _amount;
-            entry = table->newEntry();
-            entry->setField(STORAGE_VALUE, balance.str());
-            table->update(ACCOUNT_BALANCE, entry, table->newCondition());
-        }
+        auto newHeader = *header;
+        newHeader.balance = _amount;
+        updateAccount(_address, newHeader, ACCOUNT_BALANCE);
     }
     else
     {
@@ -173,6 +187,16 @@ u256 StorageState::storage(Address const& _address, u256 const& _key) const
     auto table = getTable(_address);
     if (table)
     {
+        if (m_layout.fixedWidthSlots)
+        {
+            auto entries = table->select(slotKey(_key), table->newCondition());
+            if (entries->size() != 0u)
+            {
+                return fromBigEndian<u256>(fromHex(entries->get(0)->getField(STORAGE_VALUE)));
+            }
+            /// slots written before state.fixedWidthSlots was enabled are keyed by the decimal
+            /// string until their next write
+        }
         auto entries = table->select(_key.str(), table->newCondition());
         if (entries->size() != 0u)
         {
@@ -187,21 +211,28 @@ void StorageState::setStorage(Address const& _address, u256 const& _location, u2
     auto table = getTable(_address);
     if (table)
     {
-        auto entries = table->select(_location.str(), table->newCondition());
-        if (entries->size() == 0u)
+        if (m_layout.fixedWidthSlots)
         {
+            auto key = slotKey(_location);
             auto entry = table->newEntry();
-            entry->setField(STORAGE_KEY, _location.str());
-            entry->setField(STORAGE_VALUE, _value.str());
-            table->insert(_location.str(), entry);
+            entry->setField(STORAGE_KEY, key);
+            entry->setField(STORAGE_VALUE, toHex(toBigEndian(_value)));
+            table->upsert(key, entry);
+            /// migrate a slot written before state.fixedWidthSlots was enabled
+            auto legacyKey = _location.str();
+            auto legacy = table->select(legacyKey, table->newCondition());
+            if (legacy->size() != 0u && legacy->get(0)->getStatus() == Entry::Status::NORMAL)
+                table->remove(legacyKey, table->newCondition());
+            return;
         }
+        auto entries = table->select(_location.str(), table->newCondition());
+        auto entry = table->newEntry();
+        entry->setField(STORAGE_KEY, _location.str());
+        entry->setField(STORAGE_VALUE, _value.str());
+        if (entries->size() == 0u)
+            table->insert(_location.str(), entry);
         else
-        {
-            auto entry = table->newEntry();
-            entry->setField(STORAGE_KEY, _location.str());
-            entry->setField(STORAGE_VALUE, _value.str());
             table->update(_location.str(), entry, table->newCondition());
-        }
     }
 }
 
@@ -209,39 +240,65 @@ void StorageState::clearStorage(Address const& _address) {}
 
 void StorageState::setCode(Address const& _address, bytes&& _code)
 {
+    auto code = std::make_shared<bytes const>(std::move(_code));
     auto table = getTable(_address);
     if (table)
     {
-        auto entry = table->newEntry();
-        entry->setField(STORAGE_VALUE, toHex(_code));
-        table->update(ACCOUNT_CODE, entry, table->newCondition());
-        entry = table->newEntry();
-        entry->setField(STORAGE_VALUE, toHex(sha3(_code)));
-        table->update(ACCOUNT_CODE_HASH, entry, table->newCondition());
+        auto hash = sha3(*code);
+        if (m_layout.codeTable)
+        {
+            // the same code deployed by many accounts is stored once
+            auto codeTable = m_memoryTableFactory->openTable(SYS_CODE, false);
+            if (codeTable->select(hash.hex(), codeTable->newCondition())->size() == 0u)
+            {
+                auto entry = codeTable->newEntry();
+                entry->setField(CODE_HASH, hash.hex());
+                entry->setField(STORAGE_VALUE, toHex(*code));
+                codeTable->insert(hash.hex(), entry);
+            }
+        }
+        else
+        {
+            auto entry = table->newEntry();
+            entry->setField(STORAGE_VALUE, toHex(*code));
+            if (table->select(ACCOUNT_CODE, table->newCondition())->size() == 0u)
+            {
+                entry->setField(STORAGE_KEY, ACCOUNT_CODE);
+                table->insert(ACCOUNT_CODE, entry);
+            }
+            else
+                table->update(ACCOUNT_CODE, entry, table->newCondition());
+        }
+        auto header = *account(_address);
+        header.codeHash = hash;
+        updateAccount(_address, header, ACCOUNT_CODE_HASH);
+        codeCache().put(hash, code);
     }
-    m_cache[_address] = _code;
+    m_cache[_address] = code;
 }
 
 void StorageState::kill(Address _address)
 {
-    auto table = getTable(_address);
-    if (table)
+    auto header = account(_address);
+    if (header)
     {
-        auto entry = table->newEntry();
-        entry->setField(STORAGE_VALUE, m_accountStartNonce.str());
-        table->update(ACCOUNT_NONCE, entry, table->newCondition());
-        entry = table->newEntry();
-        entry->setField(STORAGE_VALUE, u256(0).str());
-        table->update(ACCOUNT_BALANCE, entry, table->newCondition());
-        entry = table->newEntry();
-        entry->setField(STORAGE_VALUE, "");
-        table->update(ACCOUNT_CODE, entry, table->newCondition());
-        entry = table->newEntry();
-        entry->setField(STORAGE_VALUE, toHex(EmptySHA3));
-        table->update(ACCOUNT_CODE_HASH, entry, table->newCondition());
-        entry = table->newEntry();
-        entry->setField(STORAGE_VALUE, "false");
-        table->update(ACCOUNT_ALIVE, entry, table->newCondition());
+        AccountHeader newHeader;
+        newHeader.nonce = m_accountStartNonce;
+        newHeader.alive = false;
+        if (m_layout.accountHeader)
+            updateAccount(_address, newHeader, ACCOUNT_HEADER);
+        else
+        {
+            for (auto field : {ACCOUNT_NONCE, ACCOUNT_BALANCE, ACCOUNT_CODE_HASH, ACCOUNT_ALIVE})
+                updateAccount(_address, newHeader, field);
+        }
+        if (!m_layout.codeTable)
+        {
+            auto table = getTable(_address);
+            auto entry = table->newEntry();
+            entry->setField(STORAGE_VALUE, "");
+            table->update(ACCOUNT_CODE, entry, table->newCondition());
+        }
     }
     clear();
 }
@@ -250,32 +307,55 @@ bytes const& StorageState::code(Address const& _address) const
 {
     auto it = m_cache.find(_address);
     if (it != m_cache.end())
-        return it->second;
-    if (codeHash(_address) == EmptySHA3)
+        return *it->second;
+    auto hash = codeHash(_address);
+    if (hash == EmptySHA3)
         return NullBytes;
+    std::shared_ptr<bytes const> code;
+    if (!codeCache().get(hash, code))
+    {
+        code = loadCode(_address, hash);
+        if (!code)
+            return NullBytes;
+        codeCache().put(hash, code);
+    }
+    m_cache[_address] = code;
+    return *code;
+}
+
+std::shared_ptr<bytes const> StorageState::loadCode(
+    Address const& _address, h256 const& _codeHash) const
+{
+    if (m_layout.codeTable)
+    {
+        auto codeTable = m_memoryTableFactory->openTable(SYS_CODE, false);
+        auto entries = codeTable->select(_codeHash.hex(), codeTable->newCondition());
+        if (entries->size() != 0u)
+        {
+            return std::make_shared<bytes const>(
+                fromHex(entries->get(0)->getField(STORAGE_VALUE)));
+        }
+        return nullptr;
+    }
     auto table = getTable(_address);
     if (table)
     {
         auto entries = table->select(ACCOUNT_CODE, table->newCondition());
         if (entries->size() != 0u)
         {
-            m_cache[_address] = fromHex(entries->get(0)->getField(STORAGE_VALUE));
-            return m_cache[_address];
+            return std::make_shared<bytes const>(
+                fromHex(entries->get(0)->getField(STORAGE_VALUE)));
         }
     }
-    return NullBytes;
+    return nullptr;
 }
 
 h256 StorageState::codeHash(Address const& _address) const
 {
-    auto table = getTable(_address);
-    if (table)
+    auto header = account(_address);
+    if (header)
     {
-        auto entries = table->select(ACCOUNT_CODE_HASH, table->newCondition());
-        if (entries->size() != 0u)
-        {
-            return h256(fromHex(entries->get(0)->getField(STORAGE_VALUE)));
-        }
+        return header->codeHash;
     }
     return EmptySHA3;
 }
@@ -292,19 +372,12 @@ void StorageState::createContract(Address const& _address)
 
 void StorageState::incNonce(Address const& _address)
 {
-    auto table = getTable(_address);
-    if (table)
+    auto header = account(_address);
+    if (header)
     {
-        auto entries = table->select(ACCOUNT_NONCE, table->newCondition());
-        if (entries->size() != 0u)
-        {
-            auto entry = entries->get(0);
-            auto nonce = u256(entry->getField(STORAGE_VALUE));
-            ++nonce;
-            entry = table->newEntry();
-            entry->setField(STORAGE_VALUE, nonce.str());
-            table->update(ACCOUNT_NONCE, entry, table->newCondition());
-        }
+        auto newHeader = *header;
+        ++newHeader.nonce;
+        updateAccount(_address, newHeader, ACCOUNT_NONCE);
     }
     else
         createAccount(_address, requireAccountStartNonce() + 1);
@@ -312,12 +385,12 @@ void StorageState::incNonce(Address const& _address)
 
 void StorageState::setNonce(Address const& _address, u256 const& _newNonce)
 {
-    auto table = getTable(_address);
-    if (table)
+    auto header = account(_address);
+    if (header)
     {
-        auto entry = table->newEntry();
-        entry->setField(STORAGE_VALUE, _newNonce.str());
-        table->update(ACCOUNT_NONCE, entry, table->newCondition());
+        auto newHeader = *header;
+        newHeader.nonce = _newNonce;
+        updateAccount(_address, newHeader, ACCOUNT_NONCE);
     }
     else
         createAccount(_address, _newNonce);
@@ -325,15 +398,10 @@ void StorageState::setNonce(Address const& _address, u256 const& _newNonce)
 
 u256 StorageState::getNonce(Address const& _address) const
 {
-    auto table = getTable(_address);
-    if (table)
+    auto header = account(_address);
+    if (header)
     {
-        auto entries = table->select(ACCOUNT_NONCE, table->newCondition());
-        if (entries->size() != 0u)
-        {
-            auto entry = entries->get(0);
-            return u256(entry->getField(STORAGE_VALUE));
-        }
+        return header->nonce;
     }
     return m_accountStartNonce;
 }
@@ -384,11 +452,14 @@ size_t StorageState::savepoint() const
 void StorageState::rollback(size_t _savepoint)
 {
     m_memoryTableFactory->rollback(_savepoint);
+    m_accounts.clear();
+    m_cache.clear();
 }
 
 void StorageState::clear()
 {
     m_cache.clear();
+    m_accounts.clear();
 }
 
 bool StorageState::checkAuthority(Address const& _origin, Address const& _contract) const
@@ -408,26 +479,93 @@ void StorageState::createAccount(Address const& _address, u256 const& _nonce, u2
     {
         return;
     }
+    AccountHeader header;
+    header.balance = _amount;
+    header.nonce = _nonce;
+    auto insertRow = [&table](const char* _key, std::string const& _value) {
+        auto entry = table->newEntry();
+        entry->setField(STORAGE_KEY, _key);
+        entry->setField(STORAGE_VALUE, _value);
+        table->insert(_key, entry);
+    };
+    if (m_layout.accountHeader)
+    {
+        insertRow(ACCOUNT_HEADER, header.encode());
+    }
+    else
+    {
+        insertRow(ACCOUNT_BALANCE, _amount.str());
+        insertRow(ACCOUNT_CODE_HASH, toHex(EmptySHA3));
+        if (!m_layout.codeTable)
+            insertRow(ACCOUNT_CODE, "");
+        insertRow(ACCOUNT_NONCE, _nonce.str());
+        insertRow(ACCOUNT_ALIVE, "true");
+    }
+    m_accounts[_address] = header;
+}
+
+AccountHeader* StorageState::account(Address const& _address) const
+{
+    auto it = m_accounts.find(_address);
+    if (it != m_accounts.end())
+        return &it->second;
+    auto table = getTable(_address);
+    if (!table)
+        return nullptr;
+    AccountHeader header;
+    if (m_layout.accountHeader)
+    {
+        auto entries = table->select(ACCOUNT_HEADER, table->newCondition());
+        if (entries->size() != 0u)
+        {
+            header = AccountHeader::decode(entries->get(0)->getField(STORAGE_VALUE));
+        }
+    }
+    else
+    {
+        auto field = [&table](const char* _key) {
+            auto rows = table->select(_key, table->newCondition());
+            return rows->size() != 0u ? rows->get(0)->getField(STORAGE_VALUE) : "";
+        };
+        auto value = field(ACCOUNT_BALANCE);
+        header.balance = value.empty() ? u256(0) : u256(value);
+        value = field(ACCOUNT_NONCE);
+        header.nonce = value.empty() ? m_accountStartNonce : u256(value);
+        value = field(ACCOUNT_CODE_HASH);
+        header.codeHash = value.empty() ? EmptySHA3 : h256(fromHex(value));
+        header.alive = field(ACCOUNT_ALIVE) != "false";
+    }
+    return &(m_accounts[_address] = header);
+}
+
+void StorageState::updateAccount(
+    Address const& _address, AccountHeader const& _header, const char* _field)
+{
+    auto table = getTable(_address);
+    if (!table)
+        return;
     auto entry = table->newEntry();
-    entry->setField(STORAGE_KEY, ACCOUNT_BALANCE);
-    entry->setField(STORAGE_VALUE, _amount.str());
-    table->insert(ACCOUNT_BALANCE, entry);
-    entry = table->newEntry();
-    entry->setField(STORAGE_KEY, ACCOUNT_CODE_HASH);
-    entry->setField(STORAGE_VALUE, toHex(EmptySHA3));
-    table->insert(ACCOUNT_CODE_HASH, entry);
-    entry = table->newEntry();
-    entry->setField(STORAGE_KEY, ACCOUNT_CODE);
-    entry->setField(STORAGE_VALUE, "");
-    table->insert(ACCOUNT_CODE, entry);
-    entry = table->newEntry();
-    entry->setField(STORAGE_KEY, ACCOUNT_NONCE);
-    entry->setField(STORAGE_VALUE, _nonce.str());
-    table->insert(ACCOUNT_NONCE, entry);
-    entry = table->newEntry();
-    entry->setField(STORAGE_KEY, ACCOUNT_ALIVE);
-    entry->setField(STORAGE_VALUE, "true");
-    table->insert(ACCOUNT_ALIVE, entry);
+    if (m_layout.accountHeader)
+    {
+        entry->setField(STORAGE_VALUE, _header.encode());
+        table->update(ACCOUNT_HEADER, entry, table->newCondition());
+    }
+    else
+    {
+        // an update marks the row dirty even if the value is the same, so exactly the rows the
+        // operation is about are written to keep the state root of the per-field layout
+        std::string field(_field);
+        if (field == ACCOUNT_BALANCE)
+            entry->setField(STORAGE_VALUE, _header.balance.str());
+        else if (field == ACCOUNT_NONCE)
+            entry->setField(STORAGE_VALUE, _header.nonce.str());
+        else if (field == ACCOUNT_CODE_HASH)
+            entry->setField(STORAGE_VALUE, toHex(_header.codeHash));
+        else if (field == ACCOUNT_ALIVE)
+            entry->setField(STORAGE_VALUE, _header.alive ? "true" : "false");
+        table->update(field, entry, table->newCondition());
+    }
+    m_accounts[_address] = _header;
 }
 
 inline storage::Table::Ptr StorageState::getTable(Address const& _address) const
@@ -23,6 +23,7 @@
  */
 
 #pragma once
+#include "libdevcrypto/Hash.h"
 #include "libexecutive/StateFace.h"
 
 namespace dev
@@ -41,11 +42,46 @@ const char* const ACCOUNT_CODE_HASH = "codeHash";
 const char* const ACCOUNT_CODE = "code";
 const char* const ACCOUNT_NONCE = "nonce";
 const char* const ACCOUNT_ALIVE = "alive";
+const char* const ACCOUNT_HEADER = "account";
+const char* const CODE_HASH = "hash";
+
+/// how accounts are laid out in the tables; every option changes the state root, so they are
+/// fixed in the genesis of a group and all off is the original layout
+struct StorageLayout
+{
+    /// contract code is stored once per code hash in _sys_code_ instead of in the code row of
+    /// every account
+    bool codeTable = false;
+    /// balance, nonce, code hash and alive flag are packed in one AccountHeader row instead of
+    /// one row per field
+    bool accountHeader = false;
+    /// storage slots are keyed by the fixed-width hex of the slot and written with a single
+    /// upsert, instead of the decimal string with select then insert or update; slots keyed by
+    /// the decimal string are still read and are moved to the hex key on their next write
+    bool fixedWidthSlots = false;
+};
+
+/// balance, nonce, code hash and alive flag of an account; with StorageLayout::accountHeader it
+/// is stored packed in the ACCOUNT_HEADER row as fixed-width big-endian fields
+struct AccountHeader
+{
+    u256 balance;
+    u256 nonce;
+    h256 codeHash = EmptySHA3;
+    bool alive = true;
+
+    std::string encode() const;
+    /// @throws StorageException if _data is not an encoded header
+    static AccountHeader decode(std::string const& _data);
+};
+
 class StorageState : public dev::executive::StateFace
 {
 public:
-    explicit StorageState(u256 const& _accountStartNonce)
-      : m_accountStartNonce(_accountStartNonce), m_memoryTableFactory(nullptr){};
+    explicit StorageState(
+        u256 const& _accountStartNonce, StorageLayout const& _layout = StorageLayout())
+      : m_accountStartNonce(_accountStartNonce), m_layout(_layout), m_memoryTableFactory(nullptr)
+    {}
 
     /// Check if the address is in use.
     virtual bool addressInUse(Address const& _address) const override;
@@ -176,11 +212,22 @@ public:
     }
 
 private:
-    mutable std::unordered_map<Address, bytes> m_cache;
+    /// keeps the code returned by code() alive, the bytes are shared with the global code cache
+    mutable std::unordered_map<Address, std::shared_ptr<bytes const>> m_cache;
+    /// read code from _sys_code_ or from the code row of the account, as the layout says
+    std::shared_ptr<bytes const> loadCode(Address const& _address, h256 const& _codeHash) const;
+    /// @returns the decoded header or nullptr if the account does not exist
+    AccountHeader* account(Address const& _address) const;
+    /// write the header of an existing account, or only the _field row of it in the per-field
+    /// layout
+    void updateAccount(Address const& _address, AccountHeader const& _header, const char* _field);
+    /// decoded account headers, dropped on rollback
+    mutable std::unordered_map<Address, AccountHeader> m_accounts;
     void createAccount(Address const& _address, u256 const& _nonce, u256 const& _amount = u256());
     std::shared_ptr<dev::storage::Table> getTable(Address const& _address) const;
     /// check authority by caller
     u256 m_accountStartNonce;
+    StorageLayout m_layout;
     std::shared_ptr<dev::storage::MemoryTableFactory> m_memoryTableFactory;
 };
 }  // namespace storagestate
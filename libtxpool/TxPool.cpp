@@ -133,6 +133,36 @@ ImportResult TxPool::import(Transaction& _tx, IfDropped _ik)
     return verify_ret;
 }
 
+/**
+ * @brief : Verify and add transactions to the queue, the lock is taken once for the batch
+ *          and the sealer notified once
+ *
+ * @param _txs : decoded transactions with their senders recovered
+ * @return std::vector<ImportResult> : the import result of every transaction
+ */
+std::vector<ImportResult> TxPool::batchImport(Transactions& _txs)
+{
+    std::vector<ImportResult> results(_txs.size(), ImportResult::TransactionPoolIsFull);
+    u256 importTime(utcTime());
+    size_t imported = 0;
+    {
+        WriteGuard l(m_lock);
+        for (size_t i = 0; i < _txs.size() && m_txsQueue.size() < m_limit; ++i)
+        {
+            _txs[i].setImportTime(importTime);
+            results[i] = verify(_txs[i]);
+            if (results[i] == ImportResult::Success && insert(_txs[i]))
+            {
+                m_commonNonceCheck->insertCache(_txs[i]);
+                ++imported;
+            }
+        }
+    }
+    if (imported)
+        m_onReady();
+    return results;
+}
+
 /**
  * @brief : verify specified transaction, including:
  *  1. whether the transaction is known (refuse repeated transaction)
@@ -197,11 +227,9 @@ bool TxPool::removeTrans(h256 const& _txHash, bool needTriggerCallback,
     {
         return false;
     }
-    /// trigger callback from RPC
-    if (needTriggerCallback && pReceipt)
-    {
-        p_tx->second->tiggerRpcCallback(pReceipt);
-    }
+    /// trigger callback from RPC, without a receipt if the transaction is dropped so that the
+    /// callers waiting for it are answered
+    p_tx->second->tiggerRpcCallback(needTriggerCallback ? pReceipt : nullptr);
     m_txsQueue.erase(p_tx->second);
     m_txsHash.erase(p_tx);
     if (m_known.count(_txHash))
@@ -214,7 +242,7 @@ bool TxPool::removeTrans(h256 const& _txHash, bool needTriggerCallback,
  * @brief : insert the newest transaction into the transaction queue
  * @param _tx: the give transaction queue can be inserted to the transaction queue
  */
-bool TxPool::insert(Transaction const& _tx)
+bool TxPool::insert(Transaction& _tx)
 {
     h256 tx_hash = _tx.sha3();
     if (m_txsHash.count(tx_hash))
@@ -223,6 +251,8 @@ bool TxPool::insert(Transaction const& _tx)
         return false;
     }
     m_known.insert(tx_hash);
+    /// keeps the order of the transactions imported within the same millisecond
+    _tx.setImportSeq(m_importSeq++);
     TransactionQueue::iterator p_tx = m_txsQueue.emplace(_tx).first;
     m_txsHash[tx_hash] = p_tx;
     return true;
@@ -381,6 +411,91 @@ Transactions TxPool::pendingList() const
     return ret;
 }
 
+/// transactions of the queue visited under one hold of the lock by the paged reads
+static const size_t c_pendingSlice = 1024;
+
+bool TxPool::visitPending(
+    PendingCursor& io_cursor, std::function<bool(Transaction const&)> const& _visit) const
+{
+    while (true)
+    {
+        ReadGuard l(m_lock);
+        auto it = m_txsQueue.begin();
+        if (io_cursor.hash)
+        {
+            auto p_tx = m_txsHash.find(io_cursor.hash);
+            if (p_tx != m_txsHash.end())
+            {
+                it = std::next(p_tx->second);
+            }
+            else
+            {
+                /// the transaction left the pool, go on with the ones imported after it
+                Transaction key;
+                key.setImportTime(io_cursor.importTime);
+                key.setImportSeq(io_cursor.importSeq);
+                it = m_txsQueue.lower_bound(key);
+            }
+        }
+        for (size_t visited = 0; visited < c_pendingSlice && it != m_txsQueue.end(); ++visited)
+        {
+            io_cursor.importTime = it->importTime();
+            io_cursor.importSeq = it->importSeq();
+            io_cursor.hash = it->sha3();
+            if (!_visit(*it))
+            {
+                return ++it != m_txsQueue.end();
+            }
+            ++it;
+        }
+        if (it == m_txsQueue.end())
+        {
+            return false;
+        }
+    }
+}
+
+bool TxPool::pendingPage(PendingCursor& io_cursor, size_t _limit, Transactions& o_txs,
+    std::function<bool(Transaction const&)> const& _condition)
+{
+    if (_limit == 0)
+    {
+        return true;
+    }
+    size_t count = 0;
+    return visitPending(io_cursor, [&](Transaction const& _tx) {
+        if (!_condition || _condition(_tx))
+        {
+            o_txs.push_back(_tx);
+            ++count;
+        }
+        return count < _limit;
+    });
+}
+
+PendingStats TxPool::pendingStats(std::vector<uint64_t> const& _ageBoundsMs)
+{
+    PendingStats stats;
+    stats.ageBoundsMs = _ageBoundsMs;
+    stats.ages.resize(_ageBoundsMs.size() + 1);
+    u256 now = u256(utcTime());
+    PendingCursor cursor;
+    visitPending(cursor, [&](Transaction const& _tx) {
+        ++stats.count;
+        stats.inputBytes += _tx.data().size();
+        u256 age = now > _tx.importTime() ? now - _tx.importTime() : u256(0);
+        size_t bucket = 0;
+        while (bucket < _ageBoundsMs.size() && age >= _ageBoundsMs[bucket])
+        {
+            ++bucket;
+        }
+        ++stats.ages[bucket];
+        ++stats.senders[_tx.safeSender()];
+        return true;
+    });
+    return stats;
+}
+
 /// get current transaction num
 size_t TxPool::pendingSize()
 {
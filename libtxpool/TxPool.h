@@ -59,7 +59,9 @@ struct transactionCompare
 {
     bool operator()(Transaction const& _first, Transaction const& _second) const
     {
-        return _first.importTime() <= _second.importTime();
+        if (_first.importTime() != _second.importTime())
+            return _first.importTime() < _second.importTime();
+        return _first.importSeq() < _second.importSeq();
     }
 };
 class TxPool : public TxPoolInterface, public std::enable_shared_from_this<TxPool>
@@ -91,6 +93,8 @@ public:
      * @return std::pair<h256, Address> : maps from transaction hash to contract address
      */
     std::pair<h256, Address> submit(Transaction& _tx) override;
+    /// the batch is verified and inserted under one hold of the lock
+    std::vector<ImportResult> batchImport(Transactions& _txs) override;
 
     /**
      * @brief Remove transaction from the queue
@@ -117,6 +121,10 @@ public:
     Transactions pendingList() const override;
     /// get current transaction num
     size_t pendingSize() override;
+    /// the lock is held for a slice of the list at a time, only the page is copied
+    bool pendingPage(PendingCursor& io_cursor, size_t _limit, Transactions& o_txs,
+        std::function<bool(Transaction const&)> const& _condition = nullptr) override;
+    PendingStats pendingStats(std::vector<uint64_t> const& _ageBoundsMs) override;
 
     /// @returns the status of the transaction queue.
     TxPoolStatus status() const override;
@@ -159,9 +167,13 @@ private:
     dev::eth::LocalisedTransactionReceipt::Ptr constructTransactionReceipt(Transaction const& tx,
         dev::eth::TransactionReceipt const& receipt, Block const& block, unsigned index);
 
+    /// visit the pending list after io_cursor until _visit returns false, in slices of
+    /// c_pendingSlice transactions per hold of the lock; @returns true if the list goes on
+    bool visitPending(
+        PendingCursor& io_cursor, std::function<bool(Transaction const&)> const& _visit) const;
     bool removeTrans(h256 const& _txHash, bool needTriggerCallback = false,
         dev::eth::LocalisedTransactionReceipt::Ptr pReceipt = nullptr);
-    bool insert(Transaction const& _tx);
+    bool insert(Transaction& _tx);
     void removeTransactionKnowBy(h256 const& _txHash);
     bool inline txPoolNonceCheck(dev::eth::Transaction const& tx)
     {
@@ -189,6 +201,8 @@ private:
     /// transaction queue
     using TransactionQueue = std::set<dev::eth::Transaction, transactionCompare>;
     TransactionQueue m_txsQueue;
+    /// import order of the next transaction inserted into m_txsQueue
+    uint64_t m_importSeq = 0;
     std::unordered_map<h256, TransactionQueue::iterator> m_txsHash;
     /// hash of imported transactions
     h256Hash m_known;
@@ -26,11 +26,32 @@
 #include <libethcore/Common.h>
 #include <libethcore/Protocol.h>
 #include <libethcore/Transaction.h>
+#include <unordered_map>
 namespace dev
 {
 namespace txpool
 {
 struct TxPoolStatus;
+
+/// position in the pending list: the import time, import order and hash of the last transaction
+/// visited, the default cursor is the head of the list
+struct PendingCursor
+{
+    dev::u256 importTime;
+    uint64_t importSeq = 0;
+    dev::h256 hash;
+};
+
+/// a pass over the pending list, ages[i] counts the transactions younger than ageBoundsMs[i]
+/// (and older than the bound before), the last one the transactions older than all bounds
+struct PendingStats
+{
+    size_t count = 0;
+    size_t inputBytes = 0;
+    std::vector<uint64_t> ageBoundsMs;
+    std::vector<size_t> ages;
+    std::unordered_map<dev::Address, size_t> senders;
+};
 class TxPoolInterface
 {
 public:
@@ -66,6 +87,63 @@ public:
     /// get current transaction num
     virtual size_t pendingSize() = 0;
 
+    /**
+     * @brief Get a page of the pending transactions in import order
+     *
+     * @param io_cursor : where the page starts, set to where the next page starts
+     * @param _limit : max number of transactions to return
+     * @param o_txs : the transactions of the page are appended to it
+     * @param _condition : The function return false to avoid transaction to return.
+     * @return bool : true if the list goes on after the page
+     */
+    virtual bool pendingPage(PendingCursor& io_cursor, size_t _limit, dev::eth::Transactions& o_txs,
+        std::function<bool(dev::eth::Transaction const&)> const& _condition = nullptr)
+    {
+        /// on a copy of the pending list, the pool implements it without one
+        auto transactions = pendingList();
+        size_t i = 0;
+        if (io_cursor.hash)
+        {
+            while (i < transactions.size() && transactions[i].sha3() != io_cursor.hash)
+                ++i;
+            if (i < transactions.size())
+            {
+                ++i;
+            }
+            else
+            {
+                /// the transaction left the pool, go on with the ones imported after it
+                i = 0;
+                while (i < transactions.size() &&
+                       (transactions[i].importTime() < io_cursor.importTime ||
+                           (transactions[i].importTime() == io_cursor.importTime &&
+                               transactions[i].importSeq() <= io_cursor.importSeq)))
+                    ++i;
+            }
+        }
+        for (size_t count = 0; i < transactions.size() && count < _limit; ++i)
+        {
+            io_cursor.importTime = transactions[i].importTime();
+            io_cursor.importSeq = transactions[i].importSeq();
+            io_cursor.hash = transactions[i].sha3();
+            if (!_condition || _condition(transactions[i]))
+            {
+                o_txs.push_back(transactions[i]);
+                ++count;
+            }
+        }
+        return i < transactions.size();
+    }
+    /// count, input bytes, ages and senders of the pending transactions
+    virtual PendingStats pendingStats(std::vector<uint64_t> const& _ageBoundsMs)
+    {
+        PendingStats stats;
+        stats.count = pendingSize();
+        stats.ageBoundsMs = _ageBoundsMs;
+        stats.ages.resize(_ageBoundsMs.size() + 1);
+        return stats;
+    }
+
     /**
      * @brief submit a transaction through RPC
      * @param _t : transaction
@@ -84,6 +162,18 @@ public:
         dev::eth::Transaction& _tx, dev::eth::IfDropped _ik = dev::eth::IfDropped::Ignore) = 0;
     virtual dev::eth::ImportResult import(
         bytesConstRef _txBytes, dev::eth::IfDropped _ik = dev::eth::IfDropped::Ignore) = 0;
+    /**
+     * @brief : verify and add decoded transactions to the queue in one operation
+     * @param _txs : transactions with their senders recovered
+     * @return std::vector<ImportResult> : the import result of every transaction of _txs
+     */
+    virtual std::vector<dev::eth::ImportResult> batchImport(dev::eth::Transactions& _txs)
+    {
+        std::vector<dev::eth::ImportResult> results;
+        for (auto& tx : _txs)
+            results.push_back(import(tx));
+        return results;
+    }
     /// @returns the status of the transaction queue.
     virtual TxPoolStatus status() const = 0;
 
@@ -316,6 +316,36 @@ BOOST_AUTO_TEST_CASE(commitBlock)
     BOOST_CHECK_EQUAL(m_blockChainImp->totalTransactionCount().second, 2);
 }
 
+BOOST_AUTO_TEST_CASE(txRange)
+{
+    auto fakeBlock2 = std::make_shared<FakeBlock>(3);
+    fakeBlock2->getBlock().header().setNumber(m_blockChainImp->number() + 1);
+    fakeBlock2->getBlock().header().setParentHash(
+        m_blockChainImp->numberHash(m_blockChainImp->number()));
+    auto commitResult = m_blockChainImp->commitBlock(fakeBlock2->getBlock(), m_executiveContext);
+    BOOST_CHECK(commitResult == CommitResult::OK);
+
+    // the decoded block is not cached, the lookups read the ranges of the block data
+    m_blockChainImp->setBlockCacheCapacity(0);
+    auto const& tx = fakeBlock2->m_transaction[0];
+    auto entry = m_mockTable->m_fakeStorage[SYS_TX_HASH_2_BLOCK][tx.sha3().hex()];
+    BOOST_REQUIRE(entry);
+    BOOST_CHECK(entry->fields()->count(SYS_TX_RANGE));
+    BOOST_CHECK(entry->fields()->count(SYS_TX_RECEIPT_RANGE));
+
+    BOOST_CHECK_EQUAL(m_blockChainImp->getTxByHash(tx.sha3()).sha3(), tx.sha3());
+    BOOST_CHECK_EQUAL(m_blockChainImp->getTxByHash(tx.sha3()).sender(), tx.sender());
+    auto localisedTx = m_blockChainImp->getLocalisedTxByHash(tx.sha3());
+    BOOST_CHECK_EQUAL(localisedTx.blockNumber(), 1);
+    BOOST_CHECK_EQUAL(localisedTx.blockHash(), fakeBlock2->getBlock().header().hash());
+    BOOST_CHECK_EQUAL(sha3(m_blockChainImp->getTransactionReceiptByHash(tx.sha3()).rlp()),
+        sha3(fakeBlock2->m_transactionReceipt[0].rlp()));
+    auto localisedReceipt = m_blockChainImp->getLocalisedTxReceiptByHash(tx.sha3());
+    BOOST_CHECK_EQUAL(localisedReceipt.hash(), tx.sha3());
+    BOOST_CHECK_EQUAL(localisedReceipt.blockNumber(), 1);
+    BOOST_CHECK_EQUAL(localisedReceipt.from(), tx.sender());
+}
+
 BOOST_AUTO_TEST_CASE(query)
 {
     dev::h512s minerList = m_blockChainImp->minerList();
@@ -0,0 +1,140 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @brief unit test for ExecutiveContextFactory
+ *
+ * @file ExecutiveContextFactoryTest.cpp
+ */
+#include <libblockverifier/ExecutiveContextFactory.h>
+#include <libstoragestate/StorageStateFactory.h>
+#include <test/tools/libutils/TestOutputHelper.h>
+#include <test/unittests/libstorage/MemoryStorage.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace dev;
+using namespace dev::blockverifier;
+using namespace dev::storage;
+using namespace dev::storagestate;
+
+namespace dev
+{
+namespace test
+{
+struct ExecutiveContextFactoryFixture : public TestOutputHelperFixture
+{
+    ExecutiveContextFactoryFixture()
+    {
+        blockInfo.hash = h256(0);
+        blockInfo.number = 0;
+        factory = std::make_shared<ExecutiveContextFactory>();
+        factory->setStateStorage(std::make_shared<MemoryStorage>());
+        factory->setStateFactory(std::make_shared<StorageStateFactory>(h256(0)));
+    }
+
+    ExecutiveContext::Ptr createContext()
+    {
+        auto context = std::make_shared<ExecutiveContext>();
+        factory->initExecutiveContext(blockInfo, h256(0), context);
+        return context;
+    }
+
+    ExecutiveContextFactory::Ptr factory;
+    BlockInfo blockInfo;
+};
+
+BOOST_FIXTURE_TEST_SUITE(ExecutiveContextFactoryTest, ExecutiveContextFactoryFixture)
+
+BOOST_AUTO_TEST_CASE(sharedSystemPrecompiled)
+{
+    auto context1 = createContext();
+    auto context2 = createContext();
+
+    for (int addr = 0x1000; addr <= 0x1005; ++addr)
+    {
+        BOOST_CHECK(context1->isPrecompiled(Address(addr)));
+        BOOST_CHECK(context2->isPrecompiled(Address(addr)));
+    }
+    // stateless system precompiled contracts are shared
+    BOOST_CHECK(context1->getPrecompiled(Address(0x1002)) ==
+                context2->getPrecompiled(Address(0x1002)));
+    // the table factory precompiled holds per-block tables
+    BOOST_CHECK(context1->getPrecompiled(Address(0x1001)) !=
+                context2->getPrecompiled(Address(0x1001)));
+    BOOST_CHECK(context1->getMemoryTableFactory() != context2->getMemoryTableFactory());
+
+    BOOST_CHECK(context1->isOrginPrecompiled(Address(1)));
+    BOOST_CHECK(!context1->isOrginPrecompiled(Address(0x1000)));
+}
+
+BOOST_AUTO_TEST_CASE(registerPrecompiledIsPerContext)
+{
+    auto context1 = createContext();
+    auto context2 = createContext();
+    auto address = context1->registerPrecompiled(context1->getPrecompiled(Address(0x1002)));
+    BOOST_CHECK(context1->isPrecompiled(address));
+    BOOST_CHECK(!context2->isPrecompiled(address));
+}
+
+BOOST_AUTO_TEST_CASE(temporaryPrecompiledLifetime)
+{
+    auto context = createContext();
+    context->setReleaseTemporaryPrecompiled(true);
+    auto precompiled = context->getPrecompiled(Address(0x1002));
+
+    auto address1 = context->registerPrecompiled(precompiled);
+    auto savepoint = context->temporaryPrecompiledSavepoint();
+    auto address2 = context->registerPrecompiled(precompiled);
+    BOOST_CHECK(address1 != address2);
+    BOOST_CHECK(context->isPrecompiled(address2));
+
+    // revert of a call frame drops only what it registered
+    context->rollbackTemporaryPrecompiled(savepoint);
+    BOOST_CHECK(context->isPrecompiled(address1));
+    BOOST_CHECK(!context->isPrecompiled(address2));
+    auto address3 = context->registerPrecompiled(precompiled);
+    BOOST_CHECK(address3 != address2);
+    BOOST_CHECK(context->isPrecompiled(address3));
+
+    // end of transaction drops everything, new addresses are never reused
+    context->releaseTemporaryPrecompiled();
+    BOOST_CHECK(!context->isPrecompiled(address1));
+    BOOST_CHECK(!context->isPrecompiled(address3));
+    auto address4 = context->registerPrecompiled(precompiled);
+    BOOST_CHECK(address4 != address1 && address4 != address3);
+    BOOST_CHECK(context->isPrecompiled(address4));
+    BOOST_CHECK(context->isPrecompiled(Address(0x1001)));
+}
+
+BOOST_AUTO_TEST_CASE(temporaryPrecompiledKeptForBlock)
+{
+    // without tx.releaseTemporaryPrecompiled an address stays valid for the whole block
+    auto context = createContext();
+    auto precompiled = context->getPrecompiled(Address(0x1002));
+    auto savepoint = context->temporaryPrecompiledSavepoint();
+    auto address = context->registerPrecompiled(precompiled);
+    context->rollbackTemporaryPrecompiled(savepoint);
+    BOOST_CHECK(context->isPrecompiled(address));
+    context->releaseTemporaryPrecompiled();
+    BOOST_CHECK(context->isPrecompiled(address));
+    auto nextAddress = context->registerPrecompiled(precompiled);
+    BOOST_CHECK(nextAddress != address);
+    BOOST_CHECK(context->isPrecompiled(nextAddress));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace test
+}  // namespace dev
@@ -0,0 +1,90 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @file ChannelMessageTest.cpp
+ */
+#include <libchannelserver/ChannelMessage.h>
+#include <test/tools/libutils/TestOutputHelper.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace dev;
+using namespace dev::channel;
+
+namespace dev
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(ChannelMessageTest, TestOutputHelperFixture)
+
+BOOST_AUTO_TEST_CASE(decodeInPlace)
+{
+    auto chunk = std::make_shared<bytes>();
+    std::string bodies[] = {"{\"method\":\"a\"}", "{\"method\":\"sendRawTransaction\"}"};
+    for (auto const& body : bodies)
+    {
+        ChannelMessage message;
+        message.setType(0x12);
+        message.setSeq(std::string(31, '0') + body.substr(11, 1));
+        message.setData((const byte*)body.data(), body.size());
+        message.encode(*chunk);
+    }
+    /// the second frame is incomplete
+    size_t size = chunk->size() - 1;
+
+    ChannelMessage first;
+    ssize_t length = first.decodeInPlace(chunk, 0, size);
+    BOOST_REQUIRE(length > 0);
+    BOOST_CHECK_EQUAL(first.type(), 0x12);
+    BOOST_CHECK_EQUAL(std::string((char*)first.data(), first.dataSize()), bodies[0]);
+    BOOST_CHECK(first.data() >= chunk->data() && first.data() < chunk->data() + size);
+    BOOST_CHECK_EQUAL(chunk.use_count(), 2);
+
+    ChannelMessage second;
+    BOOST_CHECK_EQUAL(second.decodeInPlace(chunk, length, size - length), 0);
+    BOOST_CHECK_EQUAL(second.decodeInPlace(chunk, length, size + 1 - length),
+        ssize_t(chunk->size() - length));
+    BOOST_CHECK_EQUAL(std::string((char*)second.data(), second.dataSize()), bodies[1]);
+
+    /// a view encodes as the frame it was decoded from
+    bytes encoded;
+    first.encode(encoded);
+    BOOST_CHECK(encoded == bytes(chunk->begin(), chunk->begin() + length));
+
+    /// new data detaches the message from the chunk
+    first.setData((const byte*)"1", 1);
+    second.clearData();
+    BOOST_CHECK_EQUAL(chunk.use_count(), 1);
+    BOOST_CHECK_EQUAL(std::string((char*)first.data(), first.dataSize()), "1");
+    BOOST_CHECK_EQUAL(second.dataSize(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(invalidLength)
+{
+    ChannelMessage message;
+    message.setType(0x13);
+    bytes buffer;
+    message.encode(buffer);
+    /// a frame shorter than its header
+    buffer[3] = 1;
+    auto chunk = std::make_shared<bytes>(buffer);
+    BOOST_CHECK_EQUAL(message.decodeInPlace(chunk, 0, chunk->size()), -1);
+    BOOST_CHECK_EQUAL(message.decode(buffer.data(), buffer.size()), -1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace test
+}  // namespace dev
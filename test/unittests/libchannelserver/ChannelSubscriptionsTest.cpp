@@ -0,0 +1,166 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @file ChannelSubscriptionsTest.cpp
+ */
+#include <libchannelserver/ChannelException.h>
+#include <libchannelserver/ChannelSubscriptions.h>
+#include <test/tools/libutils/TestOutputHelper.h>
+#include <test/unittests/libethcore/FakeBlock.h>
+#include <test/unittests/librpc/FakeModule.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace dev;
+using namespace dev::eth;
+using namespace dev::channel;
+
+namespace dev
+{
+namespace test
+{
+/// the worker is not started, the queued blocks stay in m_blocks
+class FakeChannelSubscriptions : public ChannelSubscriptions
+{
+public:
+    using ChannelSubscriptions::noteBlocks;
+    std::vector<int64_t> takeBlocks()
+    {
+        std::vector<int64_t> numbers;
+        Guard l(x_blocks);
+        for (auto const& block : m_blocks)
+        {
+            numbers.push_back(block.second);
+        }
+        m_blocks.clear();
+        return numbers;
+    }
+};
+
+struct ChannelSubscriptionsFixture : public TestOutputHelperFixture
+{
+    ChannelSubscriptionsFixture() : fakeBlock(2)
+    {
+        /// the first transaction emits a log of contract, the second one of other
+        LogEntries first{LogEntry(contract, h256s{transfer, h256(1)}, bytes{1})};
+        LogEntries second{LogEntry(other, h256s{transfer}, bytes{2}),
+            LogEntry(contract, h256s{approve}, bytes{3})};
+        TransactionReceipts receipts{
+            TransactionReceipt(h256(), u256(1), first, u256(0), bytes(), Address()),
+            TransactionReceipt(h256(), u256(1), second, u256(0), bytes(), Address())};
+        fakeBlock.getBlock().setTransactionReceipts(receipts);
+    }
+
+    Json::Value request(std::string const& _json)
+    {
+        Json::Value value;
+        Json::Reader().parse(_json, value);
+        return value;
+    }
+
+    Address contract = Address(0x100);
+    Address other = Address(0x200);
+    h256 transfer = h256(0x10);
+    h256 approve = h256(0x20);
+    FakeBlock fakeBlock;
+    FakeChannelSubscriptions subscriptions;
+};
+
+BOOST_FIXTURE_TEST_SUITE(ChannelSubscriptionsTest, ChannelSubscriptionsFixture)
+
+BOOST_AUTO_TEST_CASE(matchLogsAndBlocks)
+{
+    auto session = std::make_shared<ChannelSession>();
+    auto blockSession = std::make_shared<ChannelSession>();
+    std::string byAddress = subscriptions.subscribe(session,
+        request("{\"groupID\":1,\"addresses\":[\"" + toJS(contract) + "\"],\"topics\":[\"" +
+                toJS(transfer) + "\"]}"));
+    std::string anyAddress = subscriptions.subscribe(session,
+        request("{\"groupID\":1,\"topics\":[[\"" + toJS(transfer) + "\",\"" + toJS(approve) +
+                "\"]]}"));
+    subscriptions.subscribe(blockSession, request("{\"groupID\":1,\"type\":\"blocks\"}"));
+    /// another group
+    subscriptions.subscribe(session, request("{\"groupID\":2}"));
+
+    auto notifications = subscriptions.match(1, fakeBlock.getBlock());
+    BOOST_REQUIRE_EQUAL(notifications.size(), 2u);
+
+    auto const& blockNotification = notifications[blockSession];
+    BOOST_CHECK_EQUAL(blockNotification["groupID"].asInt(), 1);
+    BOOST_CHECK_EQUAL(blockNotification["blockHash"].asString(),
+        toJS(fakeBlock.getBlock().blockHeader().hash()));
+    BOOST_REQUIRE_EQUAL(blockNotification["filters"].size(), 1u);
+    BOOST_CHECK(!blockNotification["filters"][0u].isMember("logs"));
+
+    std::map<std::string, Json::Value> filters;
+    for (auto const& filter : notifications[session]["filters"])
+    {
+        filters[filter["filterID"].asString()] = filter["logs"];
+    }
+    BOOST_REQUIRE_EQUAL(filters.size(), 2u);
+    BOOST_REQUIRE_EQUAL(filters[byAddress].size(), 1u);
+    BOOST_CHECK_EQUAL(filters[byAddress][0u]["transactionIndex"].asString(), "0x0");
+    BOOST_CHECK_EQUAL(filters[byAddress][0u]["data"].asString(), "0x01");
+    /// every log in the order of the block
+    BOOST_REQUIRE_EQUAL(filters[anyAddress].size(), 3u);
+    BOOST_CHECK_EQUAL(filters[anyAddress][1u]["address"].asString(), toJS(other));
+    BOOST_CHECK_EQUAL(filters[anyAddress][2u]["logIndex"].asString(), "0x1");
+    BOOST_CHECK_EQUAL(filters[anyAddress][2u]["transactionHash"].asString(),
+        toJS(fakeBlock.getBlock().transactions()[1].sha3()));
+
+    BOOST_CHECK(subscriptions.unsubscribe(session, anyAddress));
+    BOOST_CHECK(!subscriptions.unsubscribe(blockSession, byAddress));
+    notifications = subscriptions.match(1, fakeBlock.getBlock());
+    BOOST_CHECK_EQUAL(notifications[session]["filters"].size(), 1u);
+
+    subscriptions.removeSession(session);
+    subscriptions.removeSession(blockSession);
+    BOOST_CHECK(subscriptions.match(1, fakeBlock.getBlock()).empty());
+}
+
+BOOST_AUTO_TEST_CASE(invalidFilter)
+{
+    auto session = std::make_shared<ChannelSession>();
+    BOOST_CHECK_THROW(subscriptions.subscribe(session, request("{\"groupID\":1,\"type\":\"x\"}")),
+        ChannelException);
+    BOOST_CHECK_THROW(
+        subscriptions.subscribe(session, request("{\"groupID\":1,\"addresses\":[\"0xzz\"]}")),
+        ChannelException);
+}
+
+BOOST_AUTO_TEST_CASE(queuedBlocks)
+{
+    auto blockChain = std::make_shared<MockBlockChain>();
+    subscriptions.addGroup(1, blockChain);
+
+    /// a commit observed at the number of a later one queues both
+    BlockHeader header = blockChain->blockHeader;
+    header.setNumber(1);
+    Block block = blockChain->block;
+    block.setBlockHeader(header);
+    blockChain->commitBlock(block, nullptr);
+    BOOST_CHECK(subscriptions.takeBlocks() == std::vector<int64_t>({1, 2}));
+    /// the signal of the later commit, and a stale number, queue nothing
+    subscriptions.noteBlocks(1, 2);
+    subscriptions.noteBlocks(1, 1);
+    BOOST_CHECK(subscriptions.takeBlocks().empty());
+    subscriptions.noteBlocks(1, 3);
+    BOOST_CHECK(subscriptions.takeBlocks() == std::vector<int64_t>({3}));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace test
+}  // namespace dev
@@ -0,0 +1,90 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+
+/**
+ * @brief: unit test for libconsensus/pbft/SignatureCache.h
+ * @file: SignatureCacheTest.cpp
+ */
+#include <libconsensus/pbft/SignatureCache.h>
+#include <libdevcrypto/Hash.h>
+#include <test/tools/libutils/TestOutputHelper.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace dev::consensus;
+namespace dev
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(SignatureCacheTest, TestOutputHelperFixture)
+
+/// only the successful checks are cached
+BOOST_AUTO_TEST_CASE(testVerify)
+{
+    auto& cache = SignatureCache::instance();
+    cache.clear();
+    KeyPair key_pair = KeyPair::create();
+    h256 hash = sha3("signature cache");
+    Signature sig = dev::sign(key_pair.secret(), hash);
+
+    BOOST_CHECK(cache.verify(key_pair.pub(), sig, hash));
+    BOOST_CHECK_EQUAL(cache.size(), 1u);
+    uint64_t hits = cache.hits();
+    BOOST_CHECK(cache.verify(key_pair.pub(), sig, hash));
+    BOOST_CHECK_EQUAL(cache.hits(), hits + 1);
+
+    /// the same signature for another hash is rejected and not cached
+    BOOST_CHECK(!cache.verify(key_pair.pub(), sig, sha3("another hash")));
+    BOOST_CHECK(!cache.verify(KeyPair::create().pub(), sig, hash));
+    BOOST_CHECK_EQUAL(cache.size(), 1u);
+    cache.clear();
+}
+
+/// the first invalid item of a batch is reported, the valid ones are cached
+BOOST_AUTO_TEST_CASE(testVerifyBatch)
+{
+    auto& cache = SignatureCache::instance();
+    cache.clear();
+    h256 hash = sha3("block hash");
+    std::vector<SignatureCache::Item> items;
+    for (size_t i = 0; i < 32; ++i)
+    {
+        KeyPair key_pair = KeyPair::create();
+        items.push_back(SignatureCache::Item{key_pair.pub(), dev::sign(key_pair.secret(), hash),
+            hash});
+    }
+    size_t invalid = items.size();
+    BOOST_CHECK(cache.verifyBatch(items, invalid));
+    BOOST_CHECK_EQUAL(invalid, items.size());
+    BOOST_CHECK_EQUAL(cache.size(), items.size());
+
+    /// verified again from the cache
+    uint64_t hits = cache.hits();
+    BOOST_CHECK(cache.verifyBatch(items, invalid));
+    BOOST_CHECK_EQUAL(cache.hits(), hits + items.size());
+
+    cache.clear();
+    items[21].hash = sha3("forged hash");
+    items[27].pub = items[3].pub;
+    BOOST_CHECK(!cache.verifyBatch(items, invalid));
+    BOOST_CHECK_EQUAL(invalid, 21u);
+    BOOST_CHECK_EQUAL(cache.size(), items.size() - 2);
+    cache.clear();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace dev
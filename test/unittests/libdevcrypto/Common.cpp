@@ -25,6 +25,7 @@
 #include <libdevcrypto/Common.h>
 #include <test/tools/libutils/TestOutputHelper.h>
 #include <boost/test/unit_test.hpp>
+#include <future>
 using namespace dev;
 namespace dev
 {
@@ -150,6 +151,37 @@ BOOST_AUTO_TEST_CASE(GM_testSigAndVerify)
     SignatureStruct constructed_sig(r, s, v);
     BOOST_CHECK(constructed_sig.isValid() == true);
 }
+/// the SM2 contexts are per thread, the public key of the last secret is cached for sign
+BOOST_AUTO_TEST_CASE(GM_testSigAndVerifyConcurrently)
+{
+    std::vector<KeyPair> key_pairs;
+    for (size_t i = 0; i < 4; ++i)
+    {
+        key_pairs.push_back(KeyPair::create());
+    }
+    std::vector<std::future<bool>> results;
+    for (size_t t = 0; t < key_pairs.size(); ++t)
+    {
+        results.push_back(std::async(std::launch::async, [&key_pairs, t]() {
+            bool ret = true;
+            for (size_t i = 0; i < 16; ++i)
+            {
+                /// alternate the keys so that the cached public key is replaced
+                KeyPair const& key_pair = key_pairs[(t + i) % key_pairs.size()];
+                h256 hash = sha3(std::to_string(t * 100 + i));
+                Signature sig = sign(key_pair.secret(), hash);
+                ret = ret && verify(key_pair.pub(), sig, hash) &&
+                      Public(bytesConstRef(sig.data() + 64, 64)) == key_pair.pub() &&
+                      !verify(key_pair.pub(), sig, sha3(hash));
+            }
+            return ret;
+        }));
+    }
+    for (auto& result : results)
+    {
+        BOOST_CHECK(result.get());
+    }
+}
 /// test ecRocer
 BOOST_AUTO_TEST_CASE(GM_testSigecRocer)
 {
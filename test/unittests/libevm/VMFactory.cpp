@@ -69,6 +69,16 @@ BOOST_AUTO_TEST_CASE(testVMOptionParser)
     delete[] argv;
 }
 
+BOOST_AUTO_TEST_CASE(testSetDefaultVM)
+{
+    BOOST_CHECK(VMFactory::setDefaultVM("interpreter"));
+    BOOST_CHECK_EQUAL(VMFactory::defaultVM(), "interpreter");
+    // a module that can't be loaded falls back to the interpreter
+    BOOST_CHECK(!VMFactory::setDefaultVM("./not-exist-evmc-module.so"));
+    BOOST_CHECK_EQUAL(VMFactory::defaultVM(), "interpreter");
+    BOOST_CHECK(VMFactory::create() != nullptr);
+}
+
 BOOST_AUTO_TEST_CASE(testToRevision)
 {
     EVMSchedule schedule;
@@ -206,6 +206,32 @@ BOOST_AUTO_TEST_CASE(DeployGetSetContractTest)
     BOOST_CHECK(getExeRes.output == compareName);
 }
 
+BOOST_AUTO_TEST_CASE(SlotCacheTest)
+{
+    Address contract("2000000000000000000000000000000000000000");
+    Address origin("1000000000000000000000000000000000000000");
+    m_mptStates->addBalance(contract, u256(1));
+    m_mptStates->setStorage(contract, u256(1), u256(11));
+    EnvInfo envInfo = initEnvInfo();
+    ExtVM ext(m_mptStates, envInfo, contract, origin, origin, 0, 0, bytesConstRef(),
+        bytesConstRef(), h256(), 0, false, false);
+
+    BOOST_CHECK_EQUAL(ext.store(u256(1)), u256(11));
+    ext.setStore(u256(1), u256(12));
+    ext.setStore(u256(2), u256(22));
+    // writes go through to the state, reads are served from the cache
+    BOOST_CHECK_EQUAL(ext.store(u256(1)), u256(12));
+    BOOST_CHECK_EQUAL(ext.store(u256(2)), u256(22));
+    BOOST_CHECK_EQUAL(m_mptStates->storage(contract, u256(1)), u256(12));
+    BOOST_CHECK_EQUAL(m_mptStates->storage(contract, u256(2)), u256(22));
+
+    // another frame changes the slot, the cache must be emptied before it runs
+    m_mptStates->setStorage(contract, u256(1), u256(13));
+    BOOST_CHECK_EQUAL(ext.store(u256(1)), u256(12));
+    ext.clearStorageCache();
+    BOOST_CHECK_EQUAL(ext.store(u256(1)), u256(13));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace test
 }  // namespace dev
\ No newline at end of file
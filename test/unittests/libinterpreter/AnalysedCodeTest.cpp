@@ -0,0 +1,227 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @brief unit test for the analysed code cache of the interpreter
+ *
+ * @file AnalysedCodeTest.cpp
+ */
+
+#include <evmc/evmc.h>
+#include <libdevcrypto/Common.h>
+#include <libdevcrypto/Hash.h>
+#include <libethcore/EVMSchedule.h>
+#include <libinterpreter/AnalysedCode.h>
+#include <libinterpreter/interpreter.h>
+#include <test/tools/libutils/FakeEvmc.h>
+#include <test/tools/libutils/TestOutputHelper.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace dev;
+using namespace dev::eth;
+
+namespace dev
+{
+namespace test
+{
+struct AnalysedCodeFixture : public TestOutputHelperFixture
+{
+    AnalysedCodeFixture() : evmc(evmc_create_interpreter())
+    {
+        AnalysedCodeCache::instance().clear();
+    }
+    ~AnalysedCodeFixture()
+    {
+        AnalysedCodeCache::instance().setCapacity(capacity);
+        AnalysedCodeCache::instance().clear();
+    }
+
+    AnalysedCode::Ptr makeCode(size_t _size)
+    {
+        auto code = std::make_shared<AnalysedCode>();
+        code->codeSize = _size;
+        code->code.resize(_size);
+        return code;
+    }
+
+    evmc_result execute(bytes const& _code)
+    {
+        Address destination{KeyPair::create().address()};
+        return evmc.execute(
+            DefaultSchedule, _code, bytes(), destination, destination, 0, gas, 0, false, false);
+    }
+
+    u256 call(bytes const& _code, int64_t* o_gasUsed = nullptr)
+    {
+        evmc_result result = execute(_code);
+        BOOST_CHECK_EQUAL(result.status_code, EVMC_SUCCESS);
+        BOOST_REQUIRE_EQUAL(result.output_size, 32u);
+        u256 ret = fromBigEndian<u256>(bytesConstRef(result.output_data, result.output_size));
+        if (o_gasUsed)
+            *o_gasUsed = gas - result.gas_left;
+        if (result.release)
+            result.release(&result);
+        return ret;
+    }
+
+    evmc_status_code status(bytes const& _code)
+    {
+        evmc_result result = execute(_code);
+        if (result.release)
+            result.release(&result);
+        return result.status_code;
+    }
+
+    FakeEvmc evmc;
+    int64_t gas = 100000;
+    size_t capacity = AnalysedCodeCache::instance().capacity();
+};
+
+BOOST_FIXTURE_TEST_SUITE(AnalysedCodeTest, AnalysedCodeFixture)
+
+BOOST_AUTO_TEST_CASE(reuseAcrossCalls)
+{
+    // PUSH1 04 JUMP INVALID JUMPDEST PUSH1 20 PUSH1 00 PUSH1 2a PUSH1 00 MSTORE RETURN
+    bytes code = fromHex("600456fe5b60206000602a600052f3");
+    auto& cache = AnalysedCodeCache::instance();
+    auto hits = cache.hits();
+
+    BOOST_CHECK_EQUAL(call(code), u256(42));
+    BOOST_CHECK_EQUAL(cache.size(), 1u);
+    BOOST_CHECK_EQUAL(cache.hits(), hits);
+
+    BOOST_CHECK_EQUAL(call(code), u256(42));
+    BOOST_CHECK_EQUAL(cache.size(), 1u);
+    BOOST_CHECK_EQUAL(cache.hits(), hits + 1);
+
+    auto analysed = cache.get(sha3(code), code.size());
+    BOOST_REQUIRE(analysed);
+    BOOST_CHECK_EQUAL(analysed->jumpDests.size(), 1u);
+    BOOST_CHECK_EQUAL(analysed->jumpDests[0], 4u);
+}
+
+BOOST_AUTO_TEST_CASE(lruEviction)
+{
+    auto& cache = AnalysedCodeCache::instance();
+    auto code1 = makeCode(1000);
+    auto code2 = makeCode(1000);
+    auto code3 = makeCode(1000);
+    cache.setCapacity(code1->memorySize() * 2);
+
+    cache.put(h256(1), code1);
+    cache.put(h256(2), code2);
+    // touch code1, code2 becomes the least recently used
+    BOOST_CHECK(cache.get(h256(1), 1000) == code1);
+    cache.put(h256(3), code3);
+
+    BOOST_CHECK_EQUAL(cache.size(), 2u);
+    BOOST_CHECK(cache.get(h256(1), 1000) == code1);
+    BOOST_CHECK(!cache.get(h256(2), 1000));
+    BOOST_CHECK(cache.get(h256(3), 1000) == code3);
+    BOOST_CHECK(cache.memorySize() <= cache.capacity());
+
+    // an entry with a different size is never returned
+    BOOST_CHECK(!cache.get(h256(1), 999));
+}
+
+BOOST_AUTO_TEST_CASE(fusedInstructions)
+{
+    // 0:  PUSH1 01 PUSH2 0007 JUMPI INVALID
+    // 7:  JUMPDEST PUSH1 2a PUSH1 05 SWAP1 POP PUSH1 00 MSTORE PUSH2 0015 JUMP
+    // 21: JUMPDEST PUSH1 20 PUSH1 00 RETURN
+    bytes code = fromHex("600161000757fe5b602a60059050600052610015565b60206000f3");
+    int64_t gasUsed = 0;
+    BOOST_CHECK_EQUAL(call(code, &gasUsed), u256(5));
+    // the same gas as the instructions executed one by one
+    BOOST_CHECK_EQUAL(gasUsed, 55);
+
+    auto analysed = AnalysedCodeCache::instance().get(sha3(code), code.size());
+    BOOST_REQUIRE(analysed);
+    BOOST_CHECK(Instruction(analysed->code[2]) == Instruction::PUSH2JUMPI);
+    BOOST_CHECK(Instruction(analysed->code[12]) == Instruction::SWAP1POP);
+    BOOST_CHECK(Instruction(analysed->code[14]) == Instruction::PUSH1MSTORE);
+    BOOST_CHECK(Instruction(analysed->code[17]) == Instruction::PUSH2JUMP);
+
+    // PUSH2 0005 JUMP to a non JUMPDEST is not fused and still fails
+    BOOST_CHECK_EQUAL(status(fromHex("6100055600")), EVMC_BAD_JUMP_DESTINATION);
+    // fused opcodes in user code are invalid
+    BOOST_CHECK(status(fromHex("a5000000")) != EVMC_SUCCESS);
+}
+
+BOOST_AUTO_TEST_CASE(fusedInstructionStackOverflow)
+{
+    // 1024 x PUSH1 00, then PUSH2 0804 JUMP to the JUMPDEST at 2052 overflows at the PUSH2
+    bytes code;
+    for (size_t i = 0; i < 1024; ++i)
+        code += fromHex("6000");
+    code += fromHex("610804565b00");
+    gas = 10000000;
+    BOOST_CHECK_EQUAL(status(code), EVMC_STACK_OVERFLOW);
+    auto analysed = AnalysedCodeCache::instance().get(sha3(code), code.size());
+    BOOST_REQUIRE(analysed);
+    BOOST_CHECK(Instruction(analysed->code[2048]) == Instruction::PUSH2JUMP);
+}
+
+BOOST_AUTO_TEST_CASE(fusedInstructionStackUnderflow)
+{
+    // on an empty stack the fused pair fails as the unfused one: out of gas at the PUSH, stack
+    // underflow at the second instruction. PUSH2 0004 JUMPI to a STOP and PUSH2 0000 MSTORE are
+    // not fused and cost the same
+    std::vector<std::pair<bytes, bytes>> pairs{
+        {fromHex("610004575b00"), fromHex("6100045700")},
+        {fromHex("60005200"), fromHex("6100005200")}};
+    for (auto const& pair : pairs)
+    {
+        gas = 2;
+        BOOST_CHECK_EQUAL(status(pair.first), EVMC_OUT_OF_GAS);
+        BOOST_CHECK_EQUAL(status(pair.second), EVMC_OUT_OF_GAS);
+        gas = 3;
+        BOOST_CHECK_EQUAL(status(pair.first), EVMC_STACK_UNDERFLOW);
+        BOOST_CHECK_EQUAL(status(pair.second), EVMC_STACK_UNDERFLOW);
+    }
+    auto analysed = AnalysedCodeCache::instance().get(sha3(pairs[0].first), pairs[0].first.size());
+    BOOST_REQUIRE(analysed);
+    BOOST_CHECK(Instruction(analysed->code[0]) == Instruction::PUSH2JUMPI);
+    analysed = AnalysedCodeCache::instance().get(sha3(pairs[1].first), pairs[1].first.size());
+    BOOST_REQUIRE(analysed);
+    BOOST_CHECK(Instruction(analysed->code[0]) == Instruction::PUSH1MSTORE);
+}
+
+BOOST_AUTO_TEST_CASE(constantPoolOverflow)
+{
+    // 0x10000 x PUSH6 <i + 1> POP fill the pool, the last PUSH6 is not pooled and returned
+    bytes code;
+    for (size_t i = 0; i < 0x10000; ++i)
+    {
+        code.push_back(0x65);
+        for (int shift = 40; shift >= 0; shift -= 8)
+            code.push_back(byte((i + 1) >> shift));
+        code.push_back(0x50);
+    }
+    code += fromHex("65123456789abc60005260206000f3");
+    gas = 10000000;
+    BOOST_CHECK_EQUAL(call(code), u256(0x123456789abc));
+
+    auto analysed = AnalysedCodeCache::instance().get(sha3(code), code.size());
+    BOOST_REQUIRE(analysed);
+    BOOST_CHECK_EQUAL(analysed->pool.size(), 0x10000u);
+    BOOST_CHECK(Instruction(analysed->code[0]) == Instruction::PUSHC);
+    BOOST_CHECK(Instruction(analysed->code[0x10000 * 8]) == Instruction::PUSH6);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace test
+}  // namespace dev
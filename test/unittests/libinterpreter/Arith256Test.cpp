@@ -0,0 +1,166 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @brief unit test for the native 256 bit arithmetic of the interpreter, checked bit by bit
+ * against boost::multiprecision
+ *
+ * @file Arith256Test.cpp
+ */
+
+#include <evmc/evmc.h>
+#include <libdevcrypto/Common.h>
+#include <libethcore/EVMSchedule.h>
+#include <libinterpreter/Arith256.h>
+#include <libinterpreter/interpreter.h>
+#include <test/tools/libutils/FakeEvmc.h>
+#include <test/tools/libutils/TestOutputHelper.h>
+#include <boost/test/unit_test.hpp>
+#include <random>
+
+using namespace dev;
+using namespace dev::eth;
+
+namespace dev
+{
+namespace test
+{
+struct Arith256Fixture : public TestOutputHelperFixture
+{
+    Arith256Fixture() : evmc(evmc_create_interpreter())
+    {
+        u256 const max = ~u256(0);
+        values = {0, 1, 2, 3, 0xff, u256(1) << 63, u256(1) << 64, (u256(1) << 64) - 1,
+            (u256(1) << 128) - 1, u256(1) << 128, u256(1) << 255, max, max - 1, max / 2};
+        std::mt19937_64 rng(20181226);
+        for (size_t i = 0; i < 64; ++i)
+        {
+            u256 v = 0;
+            // random width, so carries stop at every limb
+            size_t limbs = 1 + i % 4;
+            for (size_t j = 0; j < limbs; ++j)
+                v = (v << 64) | rng();
+            values.push_back(v);
+        }
+    }
+
+    /// run PUSH32 _c PUSH32 _b PUSH32 _a <_op>, @return the item left on the stack
+    u256 run(Instruction _op, u256 const& _a, u256 const& _b, u256 const& _c = 0)
+    {
+        bytes code;
+        for (auto const& v : {_c, _b, _a})
+        {
+            code.push_back(byte(Instruction::PUSH32));
+            code += toBigEndian(v);
+        }
+        // <op> PUSH1 00 MSTORE PUSH1 20 PUSH1 00 RETURN
+        code.push_back(byte(_op));
+        code += fromHex("60005260206000f3");
+        Address destination{KeyPair::create().address()};
+        evmc_result result = evmc.execute(
+            DefaultSchedule, code, bytes(), destination, destination, 0, 1000000, 0, false, false);
+        BOOST_CHECK_EQUAL(result.status_code, EVMC_SUCCESS);
+        BOOST_REQUIRE_EQUAL(result.output_size, 32u);
+        u256 ret = fromBigEndian<u256>(bytesConstRef(result.output_data, result.output_size));
+        if (result.release)
+            result.release(&result);
+        return ret;
+    }
+
+    FakeEvmc evmc;
+    std::vector<u256> values;
+};
+
+BOOST_FIXTURE_TEST_SUITE(Arith256Test, Arith256Fixture)
+
+#if EVM_NATIVE_ARITH
+
+BOOST_AUTO_TEST_CASE(loadStore)
+{
+    for (auto const& v : values)
+    {
+        u256 stored = 12345;
+        arith::store(stored, arith::load(v));
+        BOOST_CHECK_EQUAL(stored, v);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(matchesBoost)
+{
+    for (auto const& a : values)
+    {
+        for (auto const& b : values)
+        {
+            auto x = arith::load(a);
+            auto y = arith::load(b);
+            u256 r;
+            arith::store(r, arith::add(x, y));
+            BOOST_CHECK_EQUAL(r, u256(a + b));
+            arith::store(r, arith::sub(x, y));
+            BOOST_CHECK_EQUAL(r, u256(a - b));
+            arith::store(r, arith::mul(x, y));
+            BOOST_CHECK_EQUAL(r, u256(a * b));
+            BOOST_CHECK_EQUAL(arith::lessThan(x, y), a < b);
+            bool carry = false;
+            arith::add(x, y, carry);
+            BOOST_CHECK_EQUAL(carry, u512(a) + u512(b) > u512(~u256(0)));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(expMatchesBoost)
+{
+    std::vector<u256> exponents = {0, 1, 2, 3, 64, 255, 256, u256(1) << 64, ~u256(0)};
+    exponents.push_back(values.back());
+    for (auto const& base : values)
+    {
+        for (auto const& exponent : exponents)
+        {
+            u256 r;
+            arith::store(r, arith::exp(arith::load(base), arith::load(exponent)));
+            u256 expected =
+                u256(boost::multiprecision::powm(u512(base), u512(exponent), u512(1) << 256));
+            BOOST_CHECK_EQUAL(r, expected);
+        }
+    }
+}
+
+#endif
+
+BOOST_AUTO_TEST_CASE(opcodes)
+{
+    u256 const max = ~u256(0);
+    // the sum of the operands wraps around 2^256 before the modulo
+    BOOST_CHECK_EQUAL(run(Instruction::ADDMOD, max - 1, max - 1, max), max - 2);
+    BOOST_CHECK_EQUAL(run(Instruction::ADDMOD, max, max, 7), u256((u512(max) * 2) % 7));
+    BOOST_CHECK_EQUAL(run(Instruction::ADDMOD, 5, 6, 0), u256(0));
+    BOOST_CHECK_EQUAL(run(Instruction::ADD, max, 2), u256(1));
+    BOOST_CHECK_EQUAL(run(Instruction::SUB, 1, 2), max);
+    BOOST_CHECK_EQUAL(run(Instruction::MUL, max, max), u256(1));
+    BOOST_CHECK_EQUAL(run(Instruction::EXP, 3, 200), u256(boost::multiprecision::powm(
+                                                          u512(3), u512(200), u512(1) << 256)));
+    for (size_t i = 0; i + 2 < values.size(); i += 3)
+    {
+        auto const& a = values[i];
+        auto const& b = values[i + 1];
+        auto const& m = values[i + 2];
+        BOOST_CHECK_EQUAL(run(Instruction::ADDMOD, a, b, m), m ? u256((u512(a) + b) % m) : 0);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace test
+}  // namespace dev
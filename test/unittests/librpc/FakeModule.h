@@ -330,8 +330,32 @@ public:
     {
         return transactions;
     }
-    virtual bool drop(h256 const& _txHash) override { return true; }
-    virtual bool dropBlockTrans(dev::eth::Block const& block) override { return true; }
+    /// the callbacks of the imported transactions are called as by the pool
+    virtual bool drop(h256 const& _txHash) override
+    {
+        for (auto it = imported.begin(); it != imported.end(); ++it)
+        {
+            if (it->sha3() == _txHash)
+            {
+                it->tiggerRpcCallback(nullptr);
+                imported.erase(it);
+                break;
+            }
+        }
+        return true;
+    }
+    virtual bool dropBlockTrans(dev::eth::Block const& block) override
+    {
+        for (size_t i = 0; i < imported.size(); ++i)
+        {
+            imported[i].tiggerRpcCallback(std::make_shared<LocalisedTransactionReceipt>(
+                TransactionReceipt(), imported[i].sha3(), block.blockHeader().hash(),
+                block.blockHeader().number(), imported[i].from(), imported[i].to(), i, u256(0),
+                Address()));
+        }
+        imported.clear();
+        return true;
+    }
     bool handleBadBlock(Block const& block) override { return true; }
     virtual PROTOCOL_ID const& getProtocolId() const override { return protocolId; }
     virtual TxPoolStatus status() const override
@@ -348,6 +372,7 @@ public:
     virtual dev::eth::ImportResult import(
         dev::eth::Transaction& _tx, dev::eth::IfDropped _ik = dev::eth::IfDropped::Ignore) override
     {
+        imported.push_back(_tx);
         return ImportResult::Success;
     }
     virtual dev::eth::ImportResult import(
@@ -356,6 +381,8 @@ public:
         return ImportResult::Success;
     }
 
+    Transactions imported;
+
 private:
     Transactions transactions;
     Transaction transaction;
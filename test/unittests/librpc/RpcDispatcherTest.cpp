@@ -0,0 +1,183 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @file RpcDispatcherTest.cpp
+ */
+#include <librpc/RpcDispatcher.h>
+#include <test/tools/libutils/TestOutputHelper.h>
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <future>
+#include <thread>
+
+using namespace dev;
+using namespace dev::rpc;
+
+namespace dev
+{
+namespace test
+{
+/// answers {"id":<id>,"result":<method>}, "slow" sleeps and records its concurrency
+class FakeHandler : public jsonrpc::IClientConnectionHandler
+{
+public:
+    void HandleRequest(std::string const& _request, std::string& _response) override
+    {
+        Json::Value request;
+        Json::Reader().parse(_request, request);
+        if (request["method"].asString() == "slow")
+        {
+            size_t running = ++m_running;
+            size_t seen = m_maxRunning;
+            while (running > seen && !m_maxRunning.compare_exchange_weak(seen, running))
+            {
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            --m_running;
+        }
+        if (!request.isMember("id"))
+        {
+            return;
+        }
+        Json::Value response;
+        response["id"] = request["id"];
+        response["result"] = request["method"];
+        _response = Json::FastWriter().write(response);
+    }
+
+    std::atomic<size_t> m_running{0};
+    std::atomic<size_t> m_maxRunning{0};
+};
+
+struct RpcDispatcherFixture : public TestOutputHelperFixture
+{
+    std::string call(RpcDispatcher& _dispatcher, std::string const& _request)
+    {
+        auto promise = std::make_shared<std::promise<std::string>>();
+        _dispatcher.dispatch(
+            _request, [promise](std::string const& _response) { promise->set_value(_response); });
+        return promise->get_future().get();
+    }
+
+    FakeHandler handler;
+};
+
+BOOST_FIXTURE_TEST_SUITE(RpcDispatcherTest, RpcDispatcherFixture)
+
+BOOST_AUTO_TEST_CASE(singleAndBatch)
+{
+    RpcDispatcher dispatcher(4, 64);
+    dispatcher.setHandler(&handler);
+    BOOST_CHECK_EQUAL(call(dispatcher, "{\"jsonrpc\":\"2.0\",\"method\":\"a\",\"id\":1}"),
+        "{\"id\":1,\"result\":\"a\"}\n");
+
+    /// the responses keep the order of the calls, the notification has none
+    std::string batch =
+        "[{\"jsonrpc\":\"2.0\",\"method\":\"slow\",\"id\":1},"
+        "{\"jsonrpc\":\"2.0\",\"method\":\"b\"},"
+        "{\"jsonrpc\":\"2.0\",\"method\":\"c\",\"id\":3}]";
+    BOOST_CHECK_EQUAL(call(dispatcher, batch),
+        "[{\"id\":1,\"result\":\"slow\"},{\"id\":3,\"result\":\"c\"}]");
+    BOOST_CHECK_EQUAL(call(dispatcher, "[{\"jsonrpc\":\"2.0\",\"method\":\"b\"}]"), "");
+}
+
+BOOST_AUTO_TEST_CASE(methodLimit)
+{
+    RpcDispatcher dispatcher(8, 64);
+    dispatcher.setHandler(&handler);
+    dispatcher.setMethodLimit("slow", 2);
+    std::string batch = "[";
+    for (size_t i = 0; i < 8; ++i)
+    {
+        batch += (i ? "," : "") + std::string("{\"jsonrpc\":\"2.0\",\"method\":\"slow\",\"id\":") +
+                 std::to_string(i) + "}";
+    }
+    batch += "]";
+    Json::Value responses;
+    Json::Reader().parse(call(dispatcher, batch), responses);
+    BOOST_CHECK_EQUAL(responses.size(), 8u);
+    BOOST_CHECK(handler.m_maxRunning <= 2u);
+}
+
+BOOST_AUTO_TEST_CASE(busy)
+{
+    RpcDispatcher dispatcher(1, 1);
+    dispatcher.setHandler(&handler);
+    std::string batch =
+        "[{\"jsonrpc\":\"2.0\",\"method\":\"slow\",\"id\":1},"
+        "{\"jsonrpc\":\"2.0\",\"method\":\"a\",\"id\":2}]";
+    Json::Value responses;
+    Json::Reader().parse(call(dispatcher, batch), responses);
+    BOOST_REQUIRE_EQUAL(responses.size(), 2u);
+    BOOST_CHECK_EQUAL(responses[0u]["result"].asString(), "slow");
+    BOOST_CHECK_EQUAL(responses[1u]["id"].asInt(), 2);
+    BOOST_CHECK_EQUAL(responses[1u]["error"]["code"].asInt(), -32000);
+}
+
+BOOST_AUTO_TEST_CASE(rawMethod)
+{
+    RpcDispatcher dispatcher(2, 64);
+    dispatcher.setHandler(&handler);
+    dispatcher.setRawMethod("raw", [](Json::Value const& _params, JsonWriter& _writer) {
+        if (!_params.isArray() || _params.empty())
+        {
+            return false;
+        }
+        _writer.beginObject().key("hash").hex(h256(1));
+        _writer.key("value").quantity(u256(_params[0u].asUInt())).endObject();
+        return true;
+    });
+    BOOST_CHECK_EQUAL(
+        call(dispatcher, "{\"jsonrpc\":\"2.0\",\"method\":\"raw\",\"params\":[255],\"id\":\"x\"}"),
+        "{\"id\":\"x\",\"jsonrpc\":\"2.0\",\"result\":{\"hash\":\"0x" +
+            std::string(63, '0') + "1\",\"value\":\"0xff\"}}\n");
+    /// refused by the raw method, answered by the handler
+    BOOST_CHECK_EQUAL(call(dispatcher, "{\"jsonrpc\":\"2.0\",\"method\":\"raw\",\"id\":1}"),
+        "{\"id\":1,\"result\":\"raw\"}\n");
+}
+
+BOOST_AUTO_TEST_CASE(asyncMethod)
+{
+    RpcDispatcher dispatcher(1, 64);
+    dispatcher.setHandler(&handler);
+    /// the result comes from another thread once the single worker is free again
+    std::thread later;
+    dispatcher.setAsyncMethod("later", [&later](Json::Value const& _params,
+                                           RpcDispatcher::Done const& _done) {
+        if (!_params.isArray())
+        {
+            return false;
+        }
+        later = std::thread([_done]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            _done([](JsonWriter& _writer) { _writer.quantity(uint64_t(16)); });
+        });
+        return true;
+    });
+    BOOST_CHECK_EQUAL(call(dispatcher,
+                          "[{\"jsonrpc\":\"2.0\",\"method\":\"later\",\"params\":[],\"id\":1},"
+                          "{\"jsonrpc\":\"2.0\",\"method\":\"a\",\"id\":2}]"),
+        "[{\"id\":1,\"jsonrpc\":\"2.0\",\"result\":\"0x10\"},{\"id\":2,\"result\":\"a\"}]");
+    later.join();
+    /// refused by the async method, answered by the handler
+    BOOST_CHECK_EQUAL(call(dispatcher, "{\"jsonrpc\":\"2.0\",\"method\":\"later\",\"id\":3}"),
+        "{\"id\":3,\"result\":\"later\"}\n");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace test
+}  // namespace dev
@@ -613,6 +613,90 @@ BOOST_AUTO_TEST_CASE(testGetTransactionReceipt)
 
     BOOST_CHECK_THROW(rpc->getTransactionReceipt(invalidGroup, txHash), JsonRpcException);
 }
+
+BOOST_AUTO_TEST_CASE(testWriteJson)
+{
+    /// the streamed results are the text jsoncpp renders from the Json::Value results
+    std::string blockHash = "0x067150c07dab4facb7160e075548007e067150c07dab4facb7160e075548007e";
+    std::string txHash = "0x7536cf1286b5ce6c110cd4fea5c891467884240c9af366d678eb4191e1c31c6f";
+    Json::FastWriter fastWriter;
+    JsonWriter writer;
+    for (bool includeTransactions : {true, false})
+    {
+        Json::Value params(Json::arrayValue);
+        params.append(groupId);
+        params.append(blockHash);
+        params.append(includeTransactions);
+        writer.clear();
+        BOOST_CHECK(rpc->writeBlockByHash(params, writer));
+        BOOST_CHECK_EQUAL(writer.str() + "\n",
+            fastWriter.write(rpc->getBlockByHash(groupId, blockHash, includeTransactions)));
+
+        params[1] = "0x0";
+        writer.clear();
+        BOOST_CHECK(rpc->writeBlockByNumber(params, writer));
+        BOOST_CHECK_EQUAL(writer.str() + "\n",
+            fastWriter.write(rpc->getBlockByNumber(groupId, "0x0", includeTransactions)));
+    }
+
+    Json::Value params(Json::arrayValue);
+    params.append(groupId);
+    params.append(txHash);
+    writer.clear();
+    BOOST_CHECK(rpc->writeTransactionReceipt(params, writer));
+    BOOST_CHECK_EQUAL(
+        writer.str() + "\n", fastWriter.write(rpc->getTransactionReceipt(groupId, txHash)));
+
+    writer.clear();
+    BOOST_CHECK(rpc->writeTransactionByHash(params, writer));
+    BOOST_CHECK_EQUAL(
+        writer.str() + "\n", fastWriter.write(rpc->getTransactionByHash(groupId, txHash)));
+
+    Json::Value indexParams(Json::arrayValue);
+    indexParams.append(groupId);
+    indexParams.append("0x0");
+    indexParams.append("0x0");
+    writer.clear();
+    BOOST_CHECK(rpc->writeTransactionByBlockNumberAndIndex(indexParams, writer));
+    BOOST_CHECK_EQUAL(writer.str() + "\n",
+        fastWriter.write(rpc->getTransactionByBlockNumberAndIndex(groupId, "0x0", "0x0")));
+    indexParams[2] = "0x1";
+    BOOST_CHECK(!rpc->writeTransactionByBlockNumberAndIndex(indexParams, writer));
+
+    /// the errors are left to the Json::Value methods
+    params[0] = invalidGroup;
+    BOOST_CHECK(!rpc->writeTransactionReceipt(params, writer));
+    params[0] = "1";
+    BOOST_CHECK(!rpc->writeTransactionReceipt(params, writer));
+}
+
+BOOST_AUTO_TEST_CASE(testResponseCache)
+{
+    auto cache = std::make_shared<ResponseCache>(1024 * 1024);
+    rpc->setResponseCache(cache);
+    Json::Value params(Json::arrayValue);
+    params.append(groupId);
+    params.append("0x0");
+    params.append(true);
+    JsonWriter writer;
+    BOOST_CHECK(rpc->writeBlockByNumber(params, writer));
+    std::string result = writer.str();
+    writer.clear();
+    BOOST_CHECK(rpc->writeBlockByNumber(params, writer));
+    BOOST_CHECK_EQUAL(writer.str(), result);
+    BOOST_CHECK_EQUAL(cache->hits(), 1u);
+    BOOST_CHECK_EQUAL(cache->size(), result.size());
+
+    /// the unknown transactions are not cached, they may be committed later
+    params = Json::Value(Json::arrayValue);
+    params.append(groupId);
+    params.append("0x7536cf1286b5ce6c110cd4fea5c891467884240c9af366d678eb4191e1c31c60");
+    writer.clear();
+    BOOST_CHECK(rpc->writeTransactionReceipt(params, writer));
+    BOOST_CHECK_EQUAL(writer.str(), "null");
+    BOOST_CHECK_EQUAL(cache->size(), result.size());
+}
+
 BOOST_AUTO_TEST_CASE(testGetpendingTransactions)
 {
     Json::Value response = rpc->getPendingTransactions(groupId);
@@ -628,6 +712,43 @@ BOOST_AUTO_TEST_CASE(testGetpendingTransactions)
     BOOST_CHECK_THROW(rpc->getPendingTransactions(invalidGroup), JsonRpcException);
 }
 
+BOOST_AUTO_TEST_CASE(testGetPendingTransactionsPage)
+{
+    Json::Value options;
+    options["limit"] = 1;
+    Json::Value response = rpc->getPendingTransactionsPage(groupId, options);
+    BOOST_CHECK_EQUAL(response["transactions"].size(), 1u);
+    BOOST_CHECK_EQUAL(response["more"].asBool(), false);
+    std::string hash = response["transactions"][0]["hash"].asString();
+    BOOST_CHECK_EQUAL(response["cursor"].asString().substr(8), hash.substr(2));
+
+    /// nothing after the last transaction
+    options["cursor"] = response["cursor"];
+    response = rpc->getPendingTransactionsPage(groupId, options);
+    BOOST_CHECK_EQUAL(response["transactions"].size(), 0u);
+
+    /// filter by sender
+    options.removeMember("cursor");
+    options["from"] = "0x0000000000000000000000000000000000000001";
+    response = rpc->getPendingTransactionsPage(groupId, options);
+    BOOST_CHECK_EQUAL(response["transactions"].size(), 0u);
+
+    options["cursor"] = "invalid";
+    BOOST_CHECK_THROW(rpc->getPendingTransactionsPage(groupId, options), JsonRpcException);
+    BOOST_CHECK_THROW(
+        rpc->getPendingTransactionsPage(invalidGroup, Json::Value()), JsonRpcException);
+}
+
+BOOST_AUTO_TEST_CASE(testGetPendingTransactionsStats)
+{
+    Json::Value response = rpc->getPendingTransactionsStats(groupId);
+    BOOST_CHECK_EQUAL(response["count"].asString(), "0x1");
+    BOOST_CHECK_EQUAL(response["ages"].size(), 5u);
+    BOOST_CHECK(response["ages"][4]["maxAgeMs"].isNull());
+
+    BOOST_CHECK_THROW(rpc->getPendingTransactionsStats(invalidGroup), JsonRpcException);
+}
+
 BOOST_AUTO_TEST_CASE(testGetCode)
 {
     std::string address = "0xa94f5374fce5edbc8e2a8697c15331677e6ebf0b";
@@ -693,6 +814,68 @@ BOOST_AUTO_TEST_CASE(testSendRawTransaction)
     BOOST_CHECK(response == "0x7536cf1286b5ce6c110cd4fea5c891467884240c9af366d678eb4191e1c31c6f");
 
     BOOST_CHECK_THROW(rpc->sendRawTransaction(invalidGroup, rlpStr), JsonRpcException);
+
+    /// a batch answers every transaction, the undecodable ones are Malformed
+    Json::Value rlps(Json::arrayValue);
+    rlps.append(rlpStr);
+    rlps.append("0x00");
+    rlps.append(1);
+    Json::Value results = rpc->sendRawTransactions(groupId, rlps);
+    BOOST_REQUIRE(results.size() == 3);
+    BOOST_CHECK(results[0]["transactionHash"].asString() == response);
+    BOOST_CHECK(results[0]["status"].asString() == "0x0");
+    BOOST_CHECK(results[1]["transactionHash"].isNull());
+    BOOST_CHECK(results[1]["status"].asString() ==
+                toJS(unsigned(dev::eth::ImportResult::Malformed)));
+    BOOST_CHECK(results[2]["status"].asString() == results[1]["status"].asString());
+    BOOST_CHECK_THROW(rpc->sendRawTransactions(invalidGroup, rlps), JsonRpcException);
+}
+
+BOOST_AUTO_TEST_CASE(testSendRawTransactionsAsync)
+{
+    auto txPool = std::dynamic_pointer_cast<MockTxPool>(m_ledgerManager->txPool(groupId));
+    BOOST_REQUIRE(txPool);
+    Transaction tx = txPool->pendingList()[0];
+    Json::Value params(Json::arrayValue);
+    params.append(int(groupId));
+    params.append(Json::Value(Json::arrayValue));
+    params[1].append(toJS(tx.rlp()));
+    params[1].append("0x00");
+    params.append(true);
+    Json::Value response;
+    auto done = [&response](RpcDispatcher::ResultWriter const& _result) {
+        JsonWriter writer;
+        _result(writer);
+        Json::Reader().parse(writer.str(), response);
+    };
+
+    /// answered with the receipts once the block is committed
+    BOOST_CHECK(rpc->sendRawTransactionsAsync(params, done));
+    BOOST_CHECK(response.isNull());
+    auto block = m_ledgerManager->blockChain(groupId)->getBlockByNumber(0);
+    txPool->dropBlockTrans(*block);
+    BOOST_REQUIRE(response.size() == 2);
+    BOOST_CHECK(response[0]["transactionHash"].asString() == toJS(tx.sha3()));
+    BOOST_CHECK(response[0]["status"].asString() == "0x0");
+    BOOST_CHECK(response[0]["receipt"]["transactionHash"].asString() == toJS(tx.sha3()));
+    BOOST_CHECK(response[1]["status"].asString() ==
+                toJS(unsigned(dev::eth::ImportResult::Malformed)));
+    BOOST_CHECK(!response[1].isMember("receipt"));
+
+    /// answered without receipt when the pool drops the transaction
+    response = Json::Value();
+    BOOST_CHECK(rpc->sendRawTransactionsAsync(params, done));
+    BOOST_CHECK(response.isNull());
+    txPool->drop(tx.sha3());
+    BOOST_REQUIRE(response.size() == 2);
+    BOOST_CHECK(response[0]["status"].asString() == "0x0");
+    BOOST_CHECK(!response[0].isMember("receipt"));
+
+    /// without waitForReceipts the import results are answered at once
+    params.resize(2);
+    response = Json::Value();
+    BOOST_CHECK(rpc->sendRawTransactionsAsync(params, done));
+    BOOST_CHECK(response.size() == 2);
 }
 #endif
 BOOST_AUTO_TEST_SUITE_END()
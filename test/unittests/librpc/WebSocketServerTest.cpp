@@ -0,0 +1,184 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @file WebSocketServerTest.cpp
+ */
+#include <librpc/WebSocketServer.h>
+#include <test/tools/libutils/TestOutputHelper.h>
+#include <test/unittests/librpc/FakeModule.h>
+#include <boost/beast.hpp>
+#include <boost/beast/websocket.hpp>
+#include <boost/test/unit_test.hpp>
+#include <thread>
+
+using namespace dev;
+using namespace dev::rpc;
+namespace websocket = boost::beast::websocket;
+using tcp = boost::asio::ip::tcp;
+
+namespace dev
+{
+namespace test
+{
+/// answers {"id":<id>,"result":<method>}, "slow" takes 200ms
+class EchoHandler : public jsonrpc::IClientConnectionHandler
+{
+public:
+    void HandleRequest(std::string const& _request, std::string& _response) override
+    {
+        Json::Value request;
+        Json::Reader().parse(_request, request);
+        if (request["method"].asString() == "slow")
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        }
+        Json::Value response;
+        response["id"] = request["id"];
+        response["result"] = request["method"];
+        _response = Json::FastWriter().write(response);
+    }
+};
+
+struct WebSocketServerFixture : public TestOutputHelperFixture
+{
+    WebSocketServerFixture()
+      : ioService(std::make_shared<boost::asio::io_service>()),
+        work(*ioService),
+        server(std::make_shared<WebSocketServer>(
+            "127.0.0.1", 30320, ioService, std::make_shared<RpcDispatcher>(4, 64))),
+        client(clientService)
+    {
+        ioThread = std::thread([this]() { ioService->run(); });
+        server->SetHandler(&handler);
+        BOOST_REQUIRE(server->StartListening());
+
+        client.next_layer().connect(
+            tcp::endpoint(boost::asio::ip::address::from_string("127.0.0.1"), 30320));
+        websocket::permessage_deflate deflate;
+        deflate.client_enable = true;
+        client.set_option(deflate);
+        client.handshake("127.0.0.1", "/");
+        client.text(true);
+    }
+
+    ~WebSocketServerFixture()
+    {
+        boost::system::error_code ignored;
+        client.next_layer().close(ignored);
+        if (server)
+        {
+            server->StopListening();
+        }
+        ioService->stop();
+        ioThread.join();
+    }
+
+    void send(std::string const& _request) { client.write(boost::asio::buffer(_request)); }
+
+    Json::Value receive()
+    {
+        boost::beast::multi_buffer buffer;
+        client.read(buffer);
+        Json::Value value;
+        Json::Reader().parse(boost::beast::buffers_to_string(buffer.data()), value);
+        return value;
+    }
+
+    EchoHandler handler;
+    std::shared_ptr<boost::asio::io_service> ioService;
+    boost::asio::io_service::work work;
+    std::thread ioThread;
+    std::shared_ptr<WebSocketServer> server;
+    boost::asio::io_service clientService;
+    websocket::stream<tcp::socket> client;
+};
+
+BOOST_FIXTURE_TEST_SUITE(WebSocketServerTest, WebSocketServerFixture)
+
+BOOST_AUTO_TEST_CASE(pipelining)
+{
+    /// the fast request is answered while the slow one still runs
+    send("{\"jsonrpc\":\"2.0\",\"method\":\"slow\",\"id\":1}");
+    send("{\"jsonrpc\":\"2.0\",\"method\":\"fast\",\"id\":2}");
+    Json::Value first = receive();
+    BOOST_CHECK_EQUAL(first["id"].asInt(), 2);
+    BOOST_CHECK_EQUAL(first["result"].asString(), "fast");
+    Json::Value second = receive();
+    BOOST_CHECK_EQUAL(second["id"].asInt(), 1);
+    BOOST_CHECK_EQUAL(second["result"].asString(), "slow");
+}
+
+BOOST_AUTO_TEST_CASE(subscribe)
+{
+    send("{\"jsonrpc\":\"2.0\",\"method\":\"subscribe\",\"params\":[1,\"newBlocks\"],\"id\":1}");
+    std::string id = receive()["result"].asString();
+    BOOST_REQUIRE(!id.empty());
+
+    /// another group and another kind are not pushed
+    server->notify(2, "newBlocks", "{\"number\":\"0x2\"}");
+    server->notify(1, "newReceipts", "[]");
+    server->notify(1, "newBlocks", "{\"number\":\"0x1\"}");
+    Json::Value notification = receive();
+    BOOST_CHECK_EQUAL(notification["method"].asString(), "subscription");
+    BOOST_CHECK_EQUAL(notification["params"]["subscription"].asString(), id);
+    BOOST_CHECK_EQUAL(notification["params"]["result"]["number"].asString(), "0x1");
+
+    send("{\"jsonrpc\":\"2.0\",\"method\":\"subscribe\",\"params\":[1,\"logs\"],\"id\":2}");
+    BOOST_CHECK_EQUAL(receive()["error"]["code"].asInt(), -32602);
+    send("{\"jsonrpc\":\"2.0\",\"method\":\"unsubscribe\",\"params\":[\"" + id + "\"],\"id\":3}");
+    BOOST_CHECK(receive()["result"].asBool());
+    send("{\"jsonrpc\":\"2.0\",\"method\":\"unsubscribe\",\"params\":[\"" + id + "\"],\"id\":4}");
+    BOOST_CHECK(!receive()["result"].asBool());
+}
+
+BOOST_AUTO_TEST_CASE(committedBlocks)
+{
+    auto blockChain = std::make_shared<MockBlockChain>();
+    server->addGroup(1, blockChain);
+    send("{\"jsonrpc\":\"2.0\",\"method\":\"subscribe\",\"params\":[1,\"newBlocks\"],\"id\":1}");
+    std::string id = receive()["result"].asString();
+    BOOST_REQUIRE(!id.empty());
+
+    /// a commit observed at the number of a later one pushes both blocks
+    BlockHeader header = blockChain->blockHeader;
+    header.setNumber(1);
+    Block block = blockChain->block;
+    block.setBlockHeader(header);
+    blockChain->commitBlock(block, nullptr);
+    for (size_t i = 0; i < 2; ++i)
+    {
+        Json::Value notification = receive();
+        BOOST_CHECK_EQUAL(notification["method"].asString(), "subscription");
+        BOOST_CHECK_EQUAL(notification["params"]["subscription"].asString(), id);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(serverGone)
+{
+    /// the open connection is closed instead of calling into the destroyed server
+    server->StopListening();
+    server.reset();
+    send("{\"jsonrpc\":\"2.0\",\"method\":\"fast\",\"id\":1}");
+    boost::beast::multi_buffer buffer;
+    boost::system::error_code error;
+    client.read(buffer, error);
+    BOOST_CHECK(error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace test
+}  // namespace dev
@@ -19,6 +19,7 @@
 #include <leveldb/db.h>
 #include <libdevcore/BasicLevelDB.h>
 #include <libdevcore/LevelDB.h>
+#include <boost/filesystem.hpp>
 #include <boost/test/unit_test.hpp>
 
 using namespace dev;
@@ -260,6 +261,34 @@ BOOST_AUTO_TEST_CASE(exception)
     BOOST_CHECK_THROW(levelDB->select(h, num, table, key), boost::exception);
 }
 
+BOOST_AUTO_TEST_CASE(snapshot)
+{
+    boost::filesystem::path path = boost::filesystem::temp_directory_path() /
+                                   boost::filesystem::unique_path("test_LevelDBSnapshot_%%%%%%%%");
+    {
+        leveldb::Options options = dev::db::LevelDB::defaultDBOptions();
+        options.create_if_missing = true;
+        auto db = std::make_shared<dev::db::BasicLevelDB>(options, path.string());
+        BOOST_REQUIRE(db->OpenStatus().ok());
+        auto storage = std::make_shared<dev::storage::LevelDBStorage>();
+        storage->setDB(db);
+
+        auto tableData = std::make_shared<dev::storage::TableData>();
+        tableData->tableName = "t_test";
+        tableData->data.insert(std::make_pair(std::string("LiSi"), getEntries()));
+        storage->commit(h256(0x01), 1, {tableData}, h256(0x11231));
+        BOOST_CHECK_EQUAL(storage->select(h256(0x01), 1, "t_test", "LiSi")->size(), 1u);
+
+        /// a write that is not a committed block yet is not seen by the selects
+        db->Put(leveldb::WriteOptions(), leveldb::Slice("t_test_WangWu"),
+            leveldb::Slice("{\"values\":[{\"Name\":\"WangWu\"}]}"));
+        BOOST_CHECK_EQUAL(storage->select(h256(0x01), 1, "t_test", "WangWu")->size(), 0u);
+        storage->commit(h256(0x02), 2, {}, h256(0x11232));
+        BOOST_CHECK_EQUAL(storage->select(h256(0x02), 2, "t_test", "WangWu")->size(), 1u);
+    }
+    boost::filesystem::remove_all(path);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
 
 }  // namespace test_LevelDBStateStorage
@@ -117,6 +117,64 @@ BOOST_AUTO_TEST_CASE(open_Table)
     memoryDBFactory->commitDB(h256(0), 2);
 }
 
+BOOST_AUTO_TEST_CASE(rollbackInsert)
+{
+    memoryDBFactory->createTable("t_insert", "key", "value", true);
+    auto table = memoryDBFactory->openTable("t_insert");
+    auto entry = table->newEntry();
+    entry->setField("key", "id");
+    entry->setField("value", "1");
+    table->insert("id", entry);
+    auto savePoint = memoryDBFactory->savepoint();
+    entry = table->newEntry();
+    entry->setField("key", "id");
+    entry->setField("value", "2");
+    table->insert("id", entry);
+    entry = table->newEntry();
+    entry->setField("key", "id");
+    entry->setField("value", "3");
+    table->insert("id", entry);
+    BOOST_TEST(table->select("id", table->newCondition())->size() == 3u);
+
+    // each rollback removes the entry its insert added, not the one after it
+    auto entries = table->data()->at("id");
+    memoryDBFactory->rollback(savePoint + 1);
+    BOOST_TEST(entries->size() == 2u);
+    BOOST_TEST(entries->get(1)->getField("value") == "2");
+    memoryDBFactory->rollback(savePoint);
+    BOOST_TEST(entries->size() == 1u);
+    BOOST_TEST(entries->get(0)->getField("value") == "1");
+    memoryDBFactory->rollback(0);
+    BOOST_TEST(table->select("id", table->newCondition())->size() == 0u);
+}
+
+BOOST_AUTO_TEST_CASE(upsert)
+{
+    memoryDBFactory->createTable("t_upsert", "key", "value", true);
+    auto table = memoryDBFactory->openTable("t_upsert");
+    auto entry = table->newEntry();
+    entry->setField("key", "id");
+    entry->setField("value", "1");
+    BOOST_TEST(table->upsert("id", entry) == 1);
+    auto savePoint = memoryDBFactory->savepoint();
+
+    entry = table->newEntry();
+    entry->setField("key", "id");
+    entry->setField("value", "2");
+    BOOST_TEST(table->upsert("id", entry) == 1);
+    auto entries = table->select("id", table->newCondition());
+    BOOST_TEST(entries->size() == 1u);
+    BOOST_TEST(entries->get(0)->getField("value") == "2");
+
+    // rollback restores the updated fields, then removes the inserted entry
+    memoryDBFactory->rollback(savePoint);
+    entries = table->select("id", table->newCondition());
+    BOOST_TEST(entries->size() == 1u);
+    BOOST_TEST(entries->get(0)->getField("value") == "1");
+    memoryDBFactory->rollback(0);
+    BOOST_TEST(table->select("id", table->newCondition())->size() == 0u);
+}
+
 BOOST_AUTO_TEST_CASE(open_sysTables)
 {
     auto table = memoryDBFactory->openTable(SYS_CURRENT_STATE);
@@ -0,0 +1,139 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+#ifdef FISCO_ROCKSDB
+#include "libstorage/RocksDBStorage.h"
+#include <libstorage/Common.h>
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+using namespace dev;
+using namespace dev::storage;
+
+namespace test_RocksDBStorage
+{
+struct RocksDBFixture
+{
+    RocksDBFixture()
+      : path(boost::filesystem::temp_directory_path() /
+             boost::filesystem::unique_path("test_RocksDBStorage_%%%%%%%%"))
+    {
+        rocksDB = std::make_shared<RocksDBStorage>();
+        rocksDB->open(path.string(), RocksDBOptions());
+    }
+    ~RocksDBFixture()
+    {
+        rocksDB.reset();
+        boost::filesystem::remove_all(path);
+    }
+    TableData::Ptr getTableData(std::string const& _table, std::string const& _key)
+    {
+        Entries::Ptr entries = std::make_shared<Entries>();
+        Entry::Ptr entry = std::make_shared<Entry>();
+        entry->setField("Name", "LiSi");
+        entry->setField("id", "1");
+        entries->addEntry(entry);
+        TableData::Ptr tableData = std::make_shared<TableData>();
+        tableData->tableName = _table;
+        tableData->data.insert(std::make_pair(_key, entries));
+        return tableData;
+    }
+    /// raw value of _key in column family _columnFamily, read with a plain rocksdb handle
+    std::string rawGet(std::string const& _columnFamily, std::string const& _key)
+    {
+        rocksdb::DB* db = nullptr;
+        std::vector<std::string> names;
+        rocksdb::DB::ListColumnFamilies(rocksdb::DBOptions(), path.string(), &names);
+        std::vector<rocksdb::ColumnFamilyDescriptor> descriptors;
+        for (auto const& name : names)
+        {
+            descriptors.emplace_back(name, rocksdb::ColumnFamilyOptions());
+        }
+        std::vector<rocksdb::ColumnFamilyHandle*> handles;
+        BOOST_REQUIRE(rocksdb::DB::OpenForReadOnly(
+            rocksdb::DBOptions(), path.string(), descriptors, &handles, &db)
+                          .ok());
+        std::string value;
+        for (size_t i = 0; i < names.size(); ++i)
+        {
+            if (names[i] == _columnFamily)
+            {
+                db->Get(rocksdb::ReadOptions(), handles[i], _key, &value);
+            }
+            db->DestroyColumnFamilyHandle(handles[i]);
+        }
+        delete db;
+        return value;
+    }
+
+    boost::filesystem::path path;
+    RocksDBStorage::Ptr rocksDB;
+};
+
+BOOST_FIXTURE_TEST_SUITE(RocksDB, RocksDBFixture);
+
+BOOST_AUTO_TEST_CASE(onlyDirty)
+{
+    BOOST_CHECK_EQUAL(rocksDB->onlyDirty(), false);
+}
+
+BOOST_AUTO_TEST_CASE(empty_select)
+{
+    Entries::Ptr entries = rocksDB->select(h256(0x01), 1, "t_test", "id");
+    BOOST_CHECK_EQUAL(entries->size(), 0u);
+    entries = rocksDB->select(h256(0x01), 1, SYS_HASH_2_BLOCK, "id");
+    BOOST_CHECK_EQUAL(entries->size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(commit)
+{
+    std::vector<TableData::Ptr> datas{
+        getTableData("t_test", "LiSi"), getTableData(SYS_NUMBER_2_HASH, "LiSi")};
+    size_t c = rocksDB->commit(h256(0x01), 1, datas, h256(0x11231));
+    BOOST_CHECK_EQUAL(c, 2u);
+
+    Entries::Ptr entries = rocksDB->select(h256(0x01), 1, "t_test", "LiSi");
+    BOOST_REQUIRE_EQUAL(entries->size(), 1u);
+    BOOST_CHECK_EQUAL(entries->get(0)->getField("Name"), "LiSi");
+    BOOST_CHECK_EQUAL(entries->get(0)->getField("id"), "1");
+    entries = rocksDB->select(h256(0x01), 1, SYS_NUMBER_2_HASH, "LiSi");
+    BOOST_REQUIRE_EQUAL(entries->size(), 1u);
+    BOOST_CHECK_EQUAL(entries->get(0)->getField("Name"), "LiSi");
+    /// the same key of another table is not visible
+    entries = rocksDB->select(h256(0x01), 1, SYS_HASH_2_BLOCK, "LiSi");
+    BOOST_CHECK_EQUAL(entries->size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(columnFamilies)
+{
+    std::string contractTable = "_contract_data_" + std::string(40, 'a') + "_";
+    std::vector<TableData::Ptr> datas{
+        getTableData(contractTable, "key"), getTableData(SYS_TX_HASH_2_BLOCK, "key")};
+    rocksDB->commit(h256(0x01), 1, datas, h256(0x11231));
+    rocksDB.reset();
+
+    /// system tables own a column family keyed by the raw key
+    BOOST_CHECK(!rawGet(SYS_TX_HASH_2_BLOCK, "key").empty());
+    BOOST_CHECK(rawGet(rocksdb::kDefaultColumnFamilyName, SYS_TX_HASH_2_BLOCK + "_key").empty());
+    /// other tables share the default column family keyed by table_key
+    BOOST_CHECK(!rawGet(rocksdb::kDefaultColumnFamilyName, contractTable + "_key").empty());
+    BOOST_CHECK(rawGet(SYS_TX_HASH_2_BLOCK, contractTable + "_key").empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END();
+
+}  // namespace test_RocksDBStorage
+#endif
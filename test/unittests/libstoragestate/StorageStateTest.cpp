@@ -24,7 +24,9 @@
 #include "libstoragestate/StorageState.h"
 #include "../libstorage/MemoryStorage.h"
 #include "libdevcrypto/Hash.h"
+#include "libstorage/Common.h"
 #include "libstorage/MemoryTableFactory.h"
+#include "libstorage/StorageException.h"
 #include <boost/test/unit_test.hpp>
 
 using namespace dev;
@@ -36,12 +38,13 @@ struct StorageStateFixture
     StorageStateFixture() : m_state(dev::u256(0))
     {
         auto storage = std::make_shared<dev::storage::MemoryStorage>();
-        auto tableFactory = std::make_shared<dev::storage::MemoryTableFactory>();
+        tableFactory = std::make_shared<dev::storage::MemoryTableFactory>();
         tableFactory->setStateStorage(storage);
         m_state.setMemoryTableFactory(tableFactory);
     }
 
     dev::storagestate::StorageState m_state;
+    std::shared_ptr<dev::storage::MemoryTableFactory> tableFactory;
 };
 
 BOOST_FIXTURE_TEST_SUITE(StorageState, StorageStateFixture);
@@ -99,7 +102,68 @@ BOOST_AUTO_TEST_CASE(Storage)
     m_state.setStorage(addr1, u256(123), u256(456));
     value = m_state.storage(addr1, u256(123));
     BOOST_TEST(value == u256(456));
+    m_state.setStorage(addr1, u256(123), u256(789));
+    BOOST_TEST(m_state.storage(addr1, u256(123)) == u256(789));
     m_state.clearStorage(addr1);
+
+    // without state.fixedWidthSlots slots are keyed by the decimal string
+    auto table = tableFactory->openTable("_contract_data_" + addr1.hex() + "_");
+    auto entries = table->select("123", table->newCondition());
+    BOOST_TEST(entries->size() == 1u);
+    BOOST_TEST(entries->get(0)->getField(dev::storagestate::STORAGE_VALUE) == "789");
+}
+
+BOOST_AUTO_TEST_CASE(FixedWidthSlots)
+{
+    dev::storagestate::StorageLayout layout;
+    layout.fixedWidthSlots = true;
+    dev::storagestate::StorageState state(u256(0), layout);
+    state.setMemoryTableFactory(tableFactory);
+    Address addr1(0x100001);
+    state.addBalance(addr1, u256(10));
+    BOOST_TEST(state.storage(addr1, u256(123)) == u256());
+    state.setStorage(addr1, u256(123), u256(456));
+    state.setStorage(addr1, u256(123), u256(789));
+    BOOST_TEST(state.storage(addr1, u256(123)) == u256(789));
+
+    auto table = tableFactory->openTable("_contract_data_" + addr1.hex() + "_");
+    BOOST_TEST(table->select("123", table->newCondition())->size() == 0u);
+    auto entries = table->select(toHexPrefixed(toBigEndian(u256(123))), table->newCondition());
+    BOOST_TEST(entries->size() == 1u);
+    BOOST_TEST(entries->get(0)->getField(dev::storagestate::STORAGE_VALUE) ==
+               toHex(toBigEndian(u256(789))));
+
+    // the upsert of an existing slot is rolled back like an update
+    auto savepoint = state.savepoint();
+    state.setStorage(addr1, u256(123), u256(1));
+    state.rollback(savepoint);
+    BOOST_TEST(state.storage(addr1, u256(123)) == u256(789));
+}
+
+BOOST_AUTO_TEST_CASE(FixedWidthSlotsMigration)
+{
+    // slots written before state.fixedWidthSlots was enabled
+    Address addr1(0x100001);
+    m_state.addBalance(addr1, u256(10));
+    m_state.setStorage(addr1, u256(123), u256(456));
+
+    dev::storagestate::StorageLayout layout;
+    layout.fixedWidthSlots = true;
+    dev::storagestate::StorageState state(u256(0), layout);
+    state.setMemoryTableFactory(tableFactory);
+    BOOST_TEST(state.storage(addr1, u256(123)) == u256(456));
+
+    // the next write moves the slot to the hex key
+    state.setStorage(addr1, u256(123), u256(789));
+    BOOST_TEST(state.storage(addr1, u256(123)) == u256(789));
+    auto table = tableFactory->openTable("_contract_data_" + addr1.hex() + "_");
+    auto entries = table->select("123", table->newCondition());
+    BOOST_TEST(entries->size() == 1u);
+    BOOST_TEST(entries->get(0)->getStatus() == dev::storage::Entry::Status::DELETED);
+    entries = table->select(toHexPrefixed(toBigEndian(u256(123))), table->newCondition());
+    BOOST_TEST(entries->size() == 1u);
+    state.setStorage(addr1, u256(123), u256(1));
+    BOOST_TEST(state.storage(addr1, u256(123)) == u256(1));
 }
 
 BOOST_AUTO_TEST_CASE(Code)
@@ -125,6 +189,127 @@ BOOST_AUTO_TEST_CASE(Code)
     BOOST_TEST(hasCode == true);
 }
 
+BOOST_AUTO_TEST_CASE(AccountCode)
+{
+    // without state.codeTable the code stays in the code row of the account
+    Address addr1(0x100001);
+    std::string codeString("bbbbbbbbbbbbb");
+    bytes code(codeString.begin(), codeString.end());
+    m_state.createContract(addr1);
+    m_state.setCode(addr1, bytes(code));
+    auto table = tableFactory->openTable("_contract_data_" + addr1.hex() + "_");
+    auto entries = table->select(dev::storagestate::ACCOUNT_CODE, table->newCondition());
+    BOOST_TEST(entries->size() == 1u);
+    BOOST_TEST(fromHex(entries->get(0)->getField(dev::storagestate::STORAGE_VALUE)) == code);
+    auto codeTable = tableFactory->openTable(dev::storage::SYS_CODE, false);
+    BOOST_TEST(codeTable->select(sha3(code).hex(), codeTable->newCondition())->size() == 0u);
+
+    m_state.clear();
+    BOOST_TEST(m_state.code(addr1) == code);
+    m_state.kill(addr1);
+    BOOST_TEST(m_state.code(addr1) == NullBytes);
+}
+
+BOOST_AUTO_TEST_CASE(SharedCode)
+{
+    dev::storagestate::StorageLayout layout;
+    layout.codeTable = true;
+    dev::storagestate::StorageState state(u256(0), layout);
+    state.setMemoryTableFactory(tableFactory);
+    Address addr1(0x100001);
+    Address addr2(0x100002);
+    std::string codeString("bbbbbbbbbbbbb");
+    bytes code(codeString.begin(), codeString.end());
+    state.createContract(addr1);
+    state.createContract(addr2);
+    state.setCode(addr1, bytes(code));
+    state.setCode(addr2, bytes(code));
+
+    // accounts keep the hash only, the code is stored once in _sys_code_
+    auto codeTable = tableFactory->openTable(dev::storage::SYS_CODE, false);
+    auto entries = codeTable->select(sha3(code).hex(), codeTable->newCondition());
+    BOOST_TEST(entries->size() == 1u);
+    BOOST_TEST(fromHex(entries->get(0)->getField(dev::storagestate::STORAGE_VALUE)) == code);
+    auto table = tableFactory->openTable("_contract_data_" + addr1.hex() + "_");
+    BOOST_TEST(table->select(dev::storagestate::ACCOUNT_CODE, table->newCondition())->size() == 0u);
+
+    state.clear();
+    BOOST_TEST(state.code(addr1) == code);
+    BOOST_TEST(state.code(addr2) == code);
+    BOOST_TEST(state.codeHash(addr2) == sha3(code));
+}
+
+BOOST_AUTO_TEST_CASE(PackedAccount)
+{
+    dev::storagestate::AccountHeader header;
+    header.balance = u256(1) << 200;
+    header.nonce = u256(7);
+    header.codeHash = sha3(std::string("code"));
+    header.alive = false;
+    auto decoded = dev::storagestate::AccountHeader::decode(header.encode());
+    BOOST_TEST(decoded.balance == header.balance);
+    BOOST_TEST(decoded.nonce == header.nonce);
+    BOOST_TEST(decoded.codeHash == header.codeHash);
+    BOOST_TEST(decoded.alive == false);
+    BOOST_CHECK_THROW(
+        dev::storagestate::AccountHeader::decode("00"), dev::storage::StorageException);
+
+    dev::storagestate::StorageLayout layout;
+    layout.accountHeader = true;
+    dev::storagestate::StorageState state(u256(0), layout);
+    state.setMemoryTableFactory(tableFactory);
+    Address addr1(0x100001);
+    state.addBalance(addr1, u256(100));
+    state.incNonce(addr1);
+    state.clear();
+    BOOST_TEST(state.balance(addr1) == u256(100));
+    BOOST_TEST(state.getNonce(addr1) == u256(1));
+
+    // the account is one row
+    auto table = tableFactory->openTable("_contract_data_" + addr1.hex() + "_");
+    auto entries = table->select(dev::storagestate::ACCOUNT_HEADER, table->newCondition());
+    BOOST_TEST(entries->size() == 1u);
+    entries = table->select(dev::storagestate::ACCOUNT_BALANCE, table->newCondition());
+    BOOST_TEST(entries->size() == 0u);
+
+    // rollback drops the decoded headers
+    auto savepoint = state.savepoint();
+    state.addBalance(addr1, u256(10));
+    BOOST_TEST(state.balance(addr1) == u256(110));
+    state.rollback(savepoint);
+    BOOST_TEST(state.balance(addr1) == u256(100));
+
+    state.kill(addr1);
+    BOOST_TEST(state.balance(addr1) == u256(0));
+    BOOST_TEST(state.getNonce(addr1) == state.accountStartNonce());
+}
+
+BOOST_AUTO_TEST_CASE(AccountRows)
+{
+    // without state.accountHeader every field keeps its own row
+    Address addr1(0x100001);
+    m_state.addBalance(addr1, u256(100));
+    auto table = tableFactory->openTable("_contract_data_" + addr1.hex() + "_");
+    auto field = [&table](const char* _key) {
+        auto entries = table->select(_key, table->newCondition());
+        BOOST_REQUIRE(entries->size() == 1u);
+        return entries->get(0)->getField(dev::storagestate::STORAGE_VALUE);
+    };
+    BOOST_TEST(field(dev::storagestate::ACCOUNT_BALANCE) == "100");
+    BOOST_TEST(field(dev::storagestate::ACCOUNT_NONCE) == "0");
+    BOOST_TEST(field(dev::storagestate::ACCOUNT_CODE_HASH) == toHex(EmptySHA3));
+    BOOST_TEST(field(dev::storagestate::ACCOUNT_CODE) == "");
+    BOOST_TEST(field(dev::storagestate::ACCOUNT_ALIVE) == "true");
+    BOOST_TEST(
+        table->select(dev::storagestate::ACCOUNT_HEADER, table->newCondition())->size() == 0u);
+
+    m_state.incNonce(addr1);
+    m_state.kill(addr1);
+    BOOST_TEST(field(dev::storagestate::ACCOUNT_BALANCE) == "0");
+    BOOST_TEST(field(dev::storagestate::ACCOUNT_NONCE) == "0");
+    BOOST_TEST(field(dev::storagestate::ACCOUNT_ALIVE) == "false");
+}
+
 BOOST_AUTO_TEST_CASE(Nonce)
 {
     Address addr1(0x100001);
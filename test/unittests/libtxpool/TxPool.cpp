@@ -135,6 +135,132 @@ BOOST_AUTO_TEST_CASE(testImportAndSubmit)
     pool_test.m_txPool->setMaxBlockLimit(100);
     BOOST_CHECK(pool_test.m_txPool->maxBlockLimit() == 100);
 }
+BOOST_AUTO_TEST_CASE(testBatchImport)
+{
+    TxPoolFixture pool_test(5, 5);
+    Transactions transaction_vec =
+        pool_test.m_blockChain->getBlockByHash(pool_test.m_blockChain->numberHash(0))
+            ->transactions();
+    Transactions batch;
+    size_t i = 0;
+    for (auto tx : transaction_vec)
+    {
+        tx.setNonce(tx.nonce() + u256(i) + u256(1));
+        tx.setBlockLimit(pool_test.m_blockChain->number() + u256(1));
+        Signature sig = sign(pool_test.m_blockChain->m_sec, tx.sha3(WithoutSignature));
+        tx.updateSignature(SignatureStruct(sig));
+        batch.push_back(tx);
+        i++;
+    }
+    /// a transaction repeated in the batch
+    batch.push_back(batch[0]);
+    /// the pool is full after the fourth one
+    pool_test.m_txPool->setTxPoolLimit(4);
+    std::vector<ImportResult> results = pool_test.m_txPool->batchImport(batch);
+    BOOST_REQUIRE(results.size() == 6);
+    for (i = 0; i < 4; i++)
+        BOOST_CHECK(results[i] == ImportResult::Success);
+    BOOST_CHECK(results[4] == ImportResult::TransactionPoolIsFull);
+    BOOST_CHECK(results[5] == ImportResult::TransactionPoolIsFull);
+    BOOST_CHECK(pool_test.m_txPool->pendingSize() == 4);
+    /// the transactions share the import time of the batch and are sealed in its order
+    Transactions top_transactions = pool_test.m_txPool->topTransactions(4);
+    BOOST_REQUIRE(top_transactions.size() == 4);
+    for (i = 0; i < 4; i++)
+    {
+        BOOST_CHECK(top_transactions[i].sha3() == batch[i].sha3());
+        BOOST_CHECK(top_transactions[i].importTime() == top_transactions[0].importTime());
+    }
+
+    pool_test.m_txPool->setTxPoolLimit(10);
+    results = pool_test.m_txPool->batchImport(batch);
+    for (i = 0; i < 4; i++)
+        BOOST_CHECK(results[i] == ImportResult::AlreadyKnown);
+    BOOST_CHECK(results[4] == ImportResult::Success);
+    BOOST_CHECK(results[5] == ImportResult::AlreadyKnown);
+    BOOST_CHECK(pool_test.m_txPool->pendingSize() == 5);
+}
+BOOST_AUTO_TEST_CASE(testDropCallback)
+{
+    TxPoolFixture pool_test(5, 5);
+    Transaction tx = pool_test.m_blockChain->getBlockByHash(pool_test.m_blockChain->numberHash(0))
+                         ->transactions()[0];
+    tx.setNonce(tx.nonce() + u256(1));
+    tx.setBlockLimit(pool_test.m_blockChain->number() + u256(1));
+    Signature sig = sign(pool_test.m_blockChain->m_sec, tx.sha3(WithoutSignature));
+    tx.updateSignature(SignatureStruct(sig));
+    /// the caller waiting for the receipt is answered without one when the pool drops it
+    size_t called = 0;
+    LocalisedTransactionReceipt::Ptr receipt;
+    tx.setRpcCallback([&](LocalisedTransactionReceipt::Ptr _receipt) {
+        ++called;
+        receipt = _receipt;
+    });
+    BOOST_CHECK(pool_test.m_txPool->import(tx) == ImportResult::Success);
+    BOOST_CHECK(pool_test.m_txPool->drop(tx.sha3()));
+    BOOST_CHECK(called == 1);
+    BOOST_CHECK(!receipt);
+    BOOST_CHECK(pool_test.m_txPool->pendingSize() == 0);
+}
+BOOST_AUTO_TEST_CASE(testPendingPage)
+{
+    TxPoolFixture pool_test(5, 5);
+    Transactions transaction_vec =
+        pool_test.m_blockChain->getBlockByHash(pool_test.m_blockChain->numberHash(0))
+            ->transactions();
+    size_t i = 0;
+    for (auto tx : transaction_vec)
+    {
+        tx.setNonce(tx.nonce() + u256(i) + u256(1));
+        tx.setBlockLimit(pool_test.m_blockChain->number() + u256(1));
+        Signature sig = sign(pool_test.m_blockChain->m_sec, tx.sha3(WithoutSignature));
+        tx.updateSignature(SignatureStruct(sig));
+        bytes trans_bytes;
+        tx.encode(trans_bytes);
+        BOOST_CHECK(pool_test.m_txPool->import(ref(trans_bytes)) == ImportResult::Success);
+        i++;
+    }
+    Transactions pending_list = pool_test.m_txPool->pendingList();
+    BOOST_REQUIRE(pending_list.size() == 5);
+
+    /// pages of 2 cover the list in order
+    PendingCursor cursor;
+    Transactions page;
+    BOOST_CHECK(pool_test.m_txPool->pendingPage(cursor, 2, page) == true);
+    BOOST_CHECK(pool_test.m_txPool->pendingPage(cursor, 2, page) == true);
+    BOOST_CHECK(pool_test.m_txPool->pendingPage(cursor, 2, page) == false);
+    BOOST_REQUIRE(page.size() == 5);
+    for (i = 0; i < page.size(); i++)
+        BOOST_CHECK(page[i].sha3() == pending_list[i].sha3());
+
+    /// the page after a transaction that left the pool starts with the one imported after it,
+    /// even within the same millisecond
+    cursor = PendingCursor();
+    page.clear();
+    pool_test.m_txPool->pendingPage(cursor, 1, page);
+    pool_test.m_txPool->drop(page[0].sha3());
+    page.clear();
+    pool_test.m_txPool->pendingPage(cursor, 10, page);
+    BOOST_REQUIRE(page.size() == 4);
+    for (i = 0; i < page.size(); i++)
+        BOOST_CHECK(page[i].sha3() == pending_list[i + 1].sha3());
+
+    /// filter by sender
+    Address sender = toAddress(KeyPair(pool_test.m_blockChain->m_sec).pub());
+    cursor = PendingCursor();
+    page.clear();
+    pool_test.m_txPool->pendingPage(
+        cursor, 10, page, [](Transaction const& _tx) { return _tx.safeSender() == Address(1); });
+    BOOST_CHECK(page.size() == 0);
+
+    PendingStats stats = pool_test.m_txPool->pendingStats({60000});
+    BOOST_CHECK(stats.count == 4);
+    BOOST_REQUIRE(stats.ages.size() == 2);
+    BOOST_CHECK(stats.ages[0] == 4);
+    BOOST_CHECK(stats.ages[1] == 0);
+    BOOST_CHECK(stats.senders.size() == 1);
+    BOOST_CHECK(stats.senders[sender] == 4);
+}
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace test
 }  // namespace dev
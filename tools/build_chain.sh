@@ -500,6 +500,15 @@ generate_config_ini()
     channel_listen_port=$(( port_start + 1 + index * 3 ))
     ;jsonrpc listen port
     jsonrpc_listen_port=$(( port_start + 2 + index * 3 ))
+    ;jsonrpc over websocket with block and receipt subscriptions, 0 disables
+    websocket_listen_port=0
+    ;threads running the jsonrpc methods, and the calls queued before "Server busy"
+    jsonrpc_worker_threads=8
+    jsonrpc_max_pending=4096
+    ;max concurrent calls of a method, e.g. call=4,getBlockByNumber=4
+    jsonrpc_method_limits=
+    ;MB of cached block, transaction and receipt results of committed blocks, 0 disables
+    response_cache_mb=64
 [p2p]
     ;p2p listen ip
     listen_ip=0.0.0.0
@@ -520,6 +529,13 @@ generate_config_ini()
     group_data_path=data/
     ${group_conf_list}
 
+;vm configuration
+[evm]
+    ;interpreter or the path of an EVMC module, fallback to interpreter if loading fails
+    vm=interpreter
+    ;options passed to the EVMC module, eg. name1=value1,name2=value2
+    evmc_options=
+
 ;certificate configuration
 [secure]
     ;directory the certificates located in
@@ -570,15 +586,23 @@ generate_group_genesis()
     ${node_list}
 
 [storage]
-    ;storage db type, now support leveldb 
+    ;storage db type, now support leveldb and rocksdb (built with -DROCKSDB=on)
     type=${storage_type}
 [state]
     ;support mpt/storage
     type=${state_type}
+    ;storage state keeps contract code once per hash, can not be changed later
+    codeTable=false
+    ;storage state packs the fields of an account in one row, can not be changed later
+    accountHeader=false
+    ;storage state keys storage slots by fixed-width hex, can be enabled later but not disabled
+    fixedWidthSlots=false
 
 ;tx gas limit
 [tx]
     gasLimit=300000000
+    ;release precompiled tables/entries when each transaction ends, can not be changed later
+    releaseTemporaryPrecompiled=false
 EOF
 }
 
@@ -593,6 +617,24 @@ function generate_group_ini()
 ;txpool limit
 [txPool]
     limit=1000
+
+;local storage configuration
+[storage]
+    ;fsync the db on every block commit
+    syncWrite=false
+    ;block cache size in MB, leveldb groups of the same size share one cache
+    blockCacheMB=128
+    ;rocksdb flush/compaction threads
+    maxBackgroundJobs=4
+    ;leveldb write buffer in MB, open files, bloom filter bits per key and compression
+    writeBufferMB=4
+    maxOpenFiles=100
+    bloomBitsPerKey=10
+    compression=true
+    ;log db stats every statsInterval blocks, 0 disables
+    statsInterval=1000
+    ;decoded blocks kept in memory by the group for the block queries, in MB
+    decodedBlockCacheMB=32
 EOF
 }
 
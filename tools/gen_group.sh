@@ -47,16 +47,26 @@ maxTransNum=1000
 $nodeid_list
 
 [storage]
-;storage db type, now support leveldb 
+;storage db type, now support leveldb and rocksdb (built with -DROCKSDB=on)
 type=LevelDB
+;decoded blocks kept in memory by the group for the block queries, in MB
+decodedBlockCacheMB=32
 
 [state]
 ;state type, now support mpt/storage
 type=${state_type}
+;storage state keeps contract code once per hash, can not be changed later
+codeTable=false
+;storage state packs the fields of an account in one row, can not be changed later
+accountHeader=false
+;storage state keys storage slots by fixed-width hex, can be enabled later but not disabled
+fixedWidthSlots=false
 
 ;tx gas limit
 [tx]
     gasLimit=300000000
+    ;release precompiled tables/entries when each transaction ends, can not be changed later
+    releaseTemporaryPrecompiled=false
 EOF
 }
 
@@ -71,6 +81,22 @@ function generate_group_ini()
 ;txpool limit
 [txPool]
     limit=1000
+
+;local storage configuration
+[storage]
+    ;fsync the db on every block commit
+    syncWrite=false
+    ;block cache size in MB, leveldb groups of the same size share one cache
+    blockCacheMB=128
+    ;rocksdb flush/compaction threads
+    maxBackgroundJobs=4
+    ;leveldb write buffer in MB, open files, bloom filter bits per key and compression
+    writeBufferMB=4
+    maxOpenFiles=100
+    bloomBitsPerKey=10
+    compression=true
+    ;log db stats every statsInterval blocks, 0 disables
+    statsInterval=1000
 EOF
 }
 